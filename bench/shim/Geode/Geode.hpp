@@ -0,0 +1,43 @@
+#pragma once
+
+// Pulled in by defs/geode.hpp through util/misc.hpp. Only the names used by its using declarations are needed,
+// and the code being benchmarked never calls into any of them.
+// GJUserScore is the one game class the protocol headers touch, for the PlayerIconDataSimple conversion.
+
+#include <Geode/loader/Mod.hpp>
+#include <Geode/utils/cocos.hpp>
+
+#include <string_view>
+
+namespace geode {
+    template <typename T>
+    class Ref;
+
+    namespace cocos {
+        template <typename T>
+        class CCArrayExt;
+    }
+
+    namespace cast {
+        template <typename To, typename From>
+        To typeinfo_cast(From obj);
+    }
+
+    namespace prelude {
+        using namespace geode;
+    }
+
+    // worker threads name themselves, which only matters for a debugger attached to the game
+    namespace utils::thread {
+        inline void setName(std::string_view name) {}
+    }
+}
+
+class GJUserScore {
+public:
+    int m_playerCube;
+    int m_color1;
+    int m_color2;
+    int m_color3;
+    bool m_glowEnabled;
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+// Stand-in for geode::Result, covering only what src/data, src/crypto and UdpFrameBuffer use.
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace geode {
+    namespace impl {
+        template <typename T>
+        struct OkValue {
+            T value;
+        };
+
+        template <>
+        struct OkValue<void> {};
+
+        template <typename E>
+        struct ErrValue {
+            E error;
+        };
+    }
+
+    template <typename T>
+    impl::OkValue<std::decay_t<T>> Ok(T&& value) {
+        return { std::forward<T>(value) };
+    }
+
+    inline impl::OkValue<void> Ok() {
+        return {};
+    }
+
+    template <typename E>
+    impl::ErrValue<std::decay_t<E>> Err(E&& error) {
+        return { std::forward<E>(error) };
+    }
+
+    template <typename T = void, typename E = std::string>
+    class Result {
+        using Stored = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+    public:
+        template <typename U>
+        Result(impl::OkValue<U>&& ok) requires (!std::is_void_v<T>) : inner(std::in_place_index<0>, std::move(ok.value)) {}
+
+        Result(impl::OkValue<void>&&) requires std::is_void_v<T> : inner(std::in_place_index<0>) {}
+
+        template <typename U>
+        Result(impl::ErrValue<U>&& err) : inner(std::in_place_index<1>, std::move(err.error)) {}
+
+        bool isOk() const {
+            return inner.index() == 0;
+        }
+
+        bool isErr() const {
+            return inner.index() == 1;
+        }
+
+        explicit operator bool() const {
+            return this->isOk();
+        }
+
+        decltype(auto) unwrap() & {
+            this->check(true);
+            if constexpr (!std::is_void_v<T>) return (std::get<0>(inner));
+        }
+
+        decltype(auto) unwrap() const& {
+            this->check(true);
+            if constexpr (!std::is_void_v<T>) return (std::get<0>(inner));
+        }
+
+        decltype(auto) unwrap() && {
+            this->check(true);
+            if constexpr (!std::is_void_v<T>) return std::move(std::get<0>(inner));
+        }
+
+        E& unwrapErr() & {
+            this->check(false);
+            return std::get<1>(inner);
+        }
+
+        const E& unwrapErr() const& {
+            this->check(false);
+            return std::get<1>(inner);
+        }
+
+        E&& unwrapErr() && {
+            this->check(false);
+            return std::move(std::get<1>(inner));
+        }
+
+        template <typename U = T> requires (!std::is_void_v<U>)
+        U unwrapOr(std::type_identity_t<U> other) const& {
+            return this->isOk() ? std::get<0>(inner) : std::move(other);
+        }
+
+        template <typename U = T> requires (!std::is_void_v<U>)
+        U unwrapOrDefault() const& {
+            return this->isOk() ? std::get<0>(inner) : U{};
+        }
+
+        template <typename U = T> requires (!std::is_void_v<U>)
+        std::optional<U> ok() const& {
+            return this->isOk() ? std::optional<U>(std::get<0>(inner)) : std::nullopt;
+        }
+
+        std::optional<E> err() const& {
+            return this->isErr() ? std::optional<E>(std::get<1>(inner)) : std::nullopt;
+        }
+
+    private:
+        std::variant<Stored, E> inner;
+
+        void check(bool wantOk) const {
+            if (this->isOk() != wantOk) {
+                throw std::runtime_error(wantOk ? "called unwrap on an Err" : "called unwrapErr on an Ok");
+            }
+        }
+    };
+}
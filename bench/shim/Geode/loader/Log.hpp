@@ -0,0 +1,27 @@
+#pragma once
+
+// Stand-in for geode::log, prints to stderr. Debug messages are dropped, so they don't end up in the benchmark output.
+
+#include <fmt/format.h>
+#include <fmt/std.h> // paths can be formatted with Geode too
+#include <cstdio>
+
+namespace geode::log {
+    template <typename... Args>
+    void debug(fmt::format_string<Args...>, Args&&...) {}
+
+    template <typename... Args>
+    void info(fmt::format_string<Args...> format, Args&&... args) {
+        fmt::print(stderr, "[INFO] {}\n", fmt::format(format, std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    void warn(fmt::format_string<Args...> format, Args&&... args) {
+        fmt::print(stderr, "[WARN] {}\n", fmt::format(format, std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    void error(fmt::format_string<Args...> format, Args&&... args) {
+        fmt::print(stderr, "[ERROR] {}\n", fmt::format(format, std::forward<Args>(args)...));
+    }
+}
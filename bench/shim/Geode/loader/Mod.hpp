@@ -0,0 +1,9 @@
+#pragma once
+
+// Only the names are needed, for the using declarations in defs/minimal_geode.hpp.
+
+namespace geode {
+    class Mod;
+    class Patch;
+    class Loader;
+}
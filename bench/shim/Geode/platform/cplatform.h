@@ -0,0 +1,7 @@
+#pragma once
+
+// No GEODE_IS_* platform macros, defs/platform.hpp treats this as a generic unix host.
+
+#define GEODE_STR(...) #__VA_ARGS__
+#define GEODE_CONCAT2(x, y) x##y
+#define GEODE_CONCAT(x, y) GEODE_CONCAT2(x, y)
@@ -0,0 +1,3 @@
+#pragma once
+
+// Pulled in by defs/geode.hpp, nothing in the benchmarked code builds any UI.
@@ -0,0 +1,81 @@
+#pragma once
+
+// The few cocos2d value types that are part of the protocol, the CCPoint math the interpolator uses and the CCRect math of the collision grid.
+// Node types are only declared, nothing here touches them.
+
+#include <cmath>
+#include <cstdint>
+
+namespace cocos2d {
+    using GLubyte = uint8_t;
+
+    struct CCPoint {
+        float x = 0.f, y = 0.f;
+
+        CCPoint() = default;
+        CCPoint(float x, float y) : x(x), y(y) {}
+
+        bool operator==(const CCPoint&) const = default;
+
+        CCPoint operator+(const CCPoint& other) const { return {x + other.x, y + other.y}; }
+        CCPoint operator-(const CCPoint& other) const { return {x - other.x, y - other.y}; }
+        CCPoint operator*(float a) const { return {x * a, y * a}; }
+
+        float getLength() const { return std::sqrt(x * x + y * y); }
+        float getDistance(const CCPoint& other) const { return (*this - other).getLength(); }
+
+        CCPoint lerp(const CCPoint& other, float alpha) const { return *this * (1.f - alpha) + other * alpha; }
+    };
+
+    struct CCSize {
+        float width = 0.f, height = 0.f;
+
+        CCSize() = default;
+        CCSize(float width, float height) : width(width), height(height) {}
+
+        bool operator==(const CCSize&) const = default;
+    };
+
+    struct CCRect {
+        CCPoint origin;
+        CCSize size;
+
+        CCRect() = default;
+        CCRect(float x, float y, float width, float height) : origin(x, y), size(width, height) {}
+
+        float getMinX() const { return origin.x; }
+        float getMaxX() const { return origin.x + size.width; }
+        float getMinY() const { return origin.y; }
+        float getMaxY() const { return origin.y + size.height; }
+
+        bool intersectsRect(const CCRect& rect) const {
+            return !(getMaxX() < rect.getMinX() || rect.getMaxX() < getMinX() || getMaxY() < rect.getMinY() || rect.getMaxY() < getMinY());
+        }
+    };
+
+    struct ccColor3B {
+        GLubyte r, g, b;
+
+        bool operator==(const ccColor3B&) const = default;
+    };
+
+    struct ccColor4B {
+        GLubyte r, g, b, a;
+
+        bool operator==(const ccColor4B&) const = default;
+    };
+
+    inline ccColor3B ccc3(GLubyte r, GLubyte g, GLubyte b) {
+        return { r, g, b };
+    }
+
+    inline ccColor4B ccc4(GLubyte r, GLubyte g, GLubyte b, GLubyte a) {
+        return { r, g, b, a };
+    }
+
+    class CCObject;
+    class CCNode;
+    class CCSprite;
+    class CCLabelBMFont;
+    class CCRGBAProtocol;
+}
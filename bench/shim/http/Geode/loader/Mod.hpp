@@ -0,0 +1,18 @@
+#pragma once
+
+// Takes the place of shim/Geode/loader/Mod.hpp for the http code, which keeps its cache in the save directory.
+
+#include <filesystem>
+
+namespace geode {
+    class Patch;
+    class Loader;
+
+    class Mod {
+    public:
+        static Mod* get();
+
+        // a temporary directory, created by the first call
+        std::filesystem::path getSaveDir() const;
+    };
+}
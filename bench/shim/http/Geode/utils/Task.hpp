@@ -0,0 +1,100 @@
+#pragma once
+
+// Stand-in for geode::Task, with only what CurlManager and the tests use.
+// The body of runWithCallback runs right away on the calling thread, same as in Geode, and the result is stored
+// for the test to poll. Cancelling marks the task as cancelled immediately and any later result is ignored.
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <variant>
+
+namespace geode {
+    template <typename T, typename P = std::monostate>
+    class Task {
+    public:
+        class Cancel {};
+
+        class Result {
+        public:
+            Result(T&& value) : value(std::move(value)) {}
+            Result(Cancel) {}
+
+            std::optional<T> value;
+        };
+
+        static Task immediate(T value, std::string_view name = "") {
+            Task task;
+            task.state->finish(Result(std::move(value)));
+            return task;
+        }
+
+        template <typename F>
+        static Task runWithCallback(F&& body, std::string_view name = "") {
+            Task task;
+
+            auto finish = [state = task.state](Result result) {
+                state->finish(std::move(result));
+            };
+
+            auto progress = [](P) {};
+
+            auto hasBeenCancelled = [state = task.state] {
+                return state->status.load() == Status::Cancelled;
+            };
+
+            body(std::move(finish), std::move(progress), std::move(hasBeenCancelled));
+            return task;
+        }
+
+        bool isPending() const {
+            return state->status.load() == Status::Pending;
+        }
+
+        bool isFinished() const {
+            return state->status.load() == Status::Finished;
+        }
+
+        bool isCancelled() const {
+            return state->status.load() == Status::Cancelled;
+        }
+
+        T* getFinishedValue() {
+            std::lock_guard lock(state->mutex);
+            return state->value ? &*state->value : nullptr;
+        }
+
+        void cancel() {
+            auto expected = Status::Pending;
+            state->status.compare_exchange_strong(expected, Status::Cancelled);
+        }
+
+    private:
+        enum class Status {
+            Pending, Finished, Cancelled,
+        };
+
+        struct State {
+            std::atomic<Status> status = Status::Pending;
+            std::mutex mutex;
+            std::optional<T> value;
+
+            void finish(Result result) {
+                std::lock_guard lock(mutex);
+                if (status.load() != Status::Pending) return;
+
+                if (result.value) {
+                    value = std::move(result.value);
+                    status = Status::Finished;
+                } else {
+                    status = Status::Cancelled;
+                }
+            }
+        };
+
+        std::shared_ptr<State> state = std::make_shared<State>();
+    };
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+// Takes the place of the real settings, CurlManager only reads two launch arguments from them.
+
+#include <util/singleton.hpp>
+
+class GlobedSettings : public SingletonLeakBase<GlobedSettings> {
+    friend class SingletonLeakBase;
+    GlobedSettings() = default;
+
+public:
+    struct LaunchArgs {
+        bool verboseCurl = false;
+        bool noSslVerification = false;
+    };
+
+    const LaunchArgs& launchArgs() {
+        return args;
+    }
+
+private:
+    LaunchArgs args;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+// Stand-in for matjson. The tests never look at JSON, so a value only holds the raw text.
+
+#include <Geode/Result.hpp>
+
+#include <string>
+#include <string_view>
+
+namespace matjson {
+    constexpr int NO_INDENTATION = 0;
+
+    class Value {
+    public:
+        std::string raw;
+
+        std::string dump(int indentation = NO_INDENTATION) const {
+            return raw;
+        }
+
+        template <typename T>
+        geode::Result<T> as() const {
+            return geode::Err("matjson is not available in the standalone build");
+        }
+    };
+
+    inline geode::Result<Value, std::string> parse(std::string_view str) {
+        return geode::Ok(Value { std::string(str) });
+    }
+}
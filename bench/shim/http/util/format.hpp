@@ -0,0 +1,10 @@
+#pragma once
+
+// Takes the place of util/format.hpp, the rest of it needs the game.
+
+#include <string>
+#include <string_view>
+
+namespace util::format {
+    std::string urlEncode(std::string_view str);
+}
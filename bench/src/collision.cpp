@@ -0,0 +1,99 @@
+#include <game/player_collisions.hpp>
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using cocos2d::CCRect;
+
+// same amount of work as CollisionModule does in one frame
+constexpr static size_t SUBSTEPS = 4; // 240 physics steps per second at 60 fps
+constexpr static size_t LOCAL_PLAYERS = 2;
+
+// A collision room, every remote player has 2 icons
+struct Room {
+    std::vector<CCRect> rects;
+    std::vector<CCRect> localRects;
+
+    Room(size_t playerCount) {
+        std::mt19937 rng{42};
+
+        // players in a collision room tend to stay close together, so cram them into a few screens
+        std::uniform_real_distribution<float> xDist(0.f, 3000.f), yDist(0.f, 600.f);
+
+        rects.resize(playerCount * 2);
+        for (auto& rect : rects) {
+            rect = CCRect{xDist(rng), yDist(rng), 30.f, 30.f};
+        }
+
+        localRects.resize(LOCAL_PLAYERS);
+        for (auto& rect : localRects) {
+            rect = CCRect{xDist(rng), yDist(rng), 30.f, 30.f};
+        }
+    }
+
+    void advance(float dx) {
+        for (auto& rect : rects) rect.origin.x += dx;
+        for (auto& rect : localRects) rect.origin.x += dx;
+    }
+};
+
+// What CollisionModule does every frame: rebuild the grid, then check every physics step of every local player against it
+static void collisionModule(benchmark::State& state) {
+    Room room(state.range(0));
+    PlayerCollisions<uint32_t> collisions;
+    size_t hits = 0;
+
+    auto rectOf = [&](uint32_t idx) -> const CCRect& {
+        return room.rects[idx];
+    };
+
+    for (auto _ : state) {
+        collisions.clear();
+        for (uint32_t i = 0; i < room.rects.size(); i++) {
+            collisions.insert(i, room.rects[i]);
+        }
+
+        for (size_t step = 0; step < SUBSTEPS; step++) {
+            for (auto& local : room.localRects) {
+                auto localRect = [&]() -> const CCRect& {
+                    return local;
+                };
+
+                collisions.forEachCollision(local, rectOf, localRect, [&](uint32_t, const CCRect&) {
+                    hits++;
+                });
+            }
+        }
+
+        room.advance(5.f);
+    }
+
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations() * SUBSTEPS * LOCAL_PLAYERS);
+}
+
+// Every local player against every remote player, without the grid
+static void collisionBruteForce(benchmark::State& state) {
+    Room room(state.range(0));
+    size_t hits = 0;
+
+    for (auto _ : state) {
+        for (size_t step = 0; step < SUBSTEPS; step++) {
+            for (auto& local : room.localRects) {
+                for (auto& rect : room.rects) {
+                    if (local.intersectsRect(rect)) hits++;
+                }
+            }
+        }
+
+        room.advance(5.f);
+    }
+
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations() * SUBSTEPS * LOCAL_PLAYERS);
+}
+
+BENCHMARK(collisionModule)->Arg(50)->Arg(200)->Arg(1000);
+BENCHMARK(collisionBruteForce)->Arg(50)->Arg(200)->Arg(1000);
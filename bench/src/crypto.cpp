@@ -0,0 +1,84 @@
+#include <crypto/box.hpp>
+#include <crypto/secret_box.hpp>
+#include <crypto/chacha_secret_box.hpp>
+#include <util/crypto.hpp>
+
+#include <benchmark/benchmark.h>
+
+using util::data::bytevector;
+
+// two boxes that have exchanged keys, like the client and the server after the handshake
+struct BoxPair {
+    CryptoBox client, server;
+
+    BoxPair() {
+        client.setPeerKey(server.getPublicKey());
+        server.setPeerKey(client.getPublicKey());
+    }
+};
+
+static void cryptoBoxEncrypt(benchmark::State& state) {
+    BoxPair boxes;
+    auto plaintext = util::crypto::secureRandom(state.range(0));
+    bytevector out(plaintext.size() + CryptoBox::PREFIX_LEN);
+
+    for (auto _ : state) {
+        auto len = boxes.client.encryptInto(plaintext.data(), out.data(), plaintext.size()).unwrap();
+        benchmark::DoNotOptimize(len);
+    }
+
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+static void cryptoBoxDecrypt(benchmark::State& state) {
+    BoxPair boxes;
+    auto plaintext = util::crypto::secureRandom(state.range(0));
+    auto ciphertext = boxes.client.encrypt(plaintext);
+    bytevector out(plaintext.size());
+
+    for (auto _ : state) {
+        auto len = boxes.server.decryptInto(ciphertext.data(), out.data(), ciphertext.size()).unwrap();
+        benchmark::DoNotOptimize(len);
+    }
+
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+template <typename Box>
+static void secretBoxEncrypt(benchmark::State& state) {
+    Box box(util::crypto::secureRandom(Box::KEY_LEN));
+    auto plaintext = util::crypto::secureRandom(state.range(0));
+    bytevector out(plaintext.size() + Box::PREFIX_LEN);
+
+    for (auto _ : state) {
+        auto len = box.encryptInto(plaintext.data(), out.data(), plaintext.size()).unwrap();
+        benchmark::DoNotOptimize(len);
+    }
+
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+template <typename Box>
+static void secretBoxDecrypt(benchmark::State& state) {
+    Box box(util::crypto::secureRandom(Box::KEY_LEN));
+    auto plaintext = util::crypto::secureRandom(state.range(0));
+    auto ciphertext = box.encrypt(plaintext);
+    bytevector out(plaintext.size());
+
+    for (auto _ : state) {
+        auto len = box.decryptInto(ciphertext.data(), out.data(), ciphertext.size()).unwrap();
+        benchmark::DoNotOptimize(len);
+    }
+
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+// a small packet, a typical level data packet, and a big profile list
+#define CRYPTO_SIZES ->Arg(64)->Arg(1400)->Arg(65536)
+
+BENCHMARK(cryptoBoxEncrypt) CRYPTO_SIZES;
+BENCHMARK(cryptoBoxDecrypt) CRYPTO_SIZES;
+BENCHMARK(secretBoxEncrypt<SecretBox>) CRYPTO_SIZES;
+BENCHMARK(secretBoxDecrypt<SecretBox>) CRYPTO_SIZES;
+BENCHMARK(secretBoxEncrypt<ChaChaSecretBox>) CRYPTO_SIZES;
+BENCHMARK(secretBoxDecrypt<ChaChaSecretBox>) CRYPTO_SIZES;
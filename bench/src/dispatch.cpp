@@ -0,0 +1,42 @@
+#include <data/packets/all.hpp>
+
+#include <benchmark/benchmark.h>
+
+// Every server packet ID, in the order they would commonly show up, plus one that doesn't exist
+static const packetid_t PACKET_IDS[] = {
+    LevelDataPacket::PACKET_ID,
+    LevelPlayerMetadataPacket::PACKET_ID,
+    VoiceBroadcastPacket::PACKET_ID,
+    ChatMessageBroadcastPacket::PACKET_ID,
+    PlayerProfilesPacket::PACKET_ID,
+    LevelInnerPlayerCountPacket::PACKET_ID,
+    GlobalPlayerListPacket::PACKET_ID,
+    LevelListPacket::PACKET_ID,
+    LevelPlayerCountPacket::PACKET_ID,
+    RolesUpdatedPacket::PACKET_ID,
+    MotdResponsePacket::PACKET_ID,
+    65535,
+};
+
+static void dispatchSingle(benchmark::State& state) {
+    for (auto _ : state) {
+        auto packet = matchPacket(LevelDataPacket::PACKET_ID);
+        benchmark::DoNotOptimize(packet.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void dispatchMixed(benchmark::State& state) {
+    for (auto _ : state) {
+        for (auto id : PACKET_IDS) {
+            auto packet = matchPacket(id);
+            benchmark::DoNotOptimize(packet.get());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * std::size(PACKET_IDS));
+}
+
+BENCHMARK(dispatchSingle);
+BENCHMARK(dispatchMixed);
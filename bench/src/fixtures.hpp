@@ -0,0 +1,90 @@
+#pragma once
+
+#include <data/packets/all.hpp>
+
+#include <memory>
+
+// Packet contents that look like what a busy level produces, shared between the benchmarks.
+namespace bench {
+    inline PlayerData makePlayerData(int idx) {
+        float t = idx * 0.1f;
+
+        SpecificIconData icon {
+            .position = cocos2d::CCPoint{300.f + idx * 30.f, 105.f + t},
+            .rotation = t * 90.f,
+            .iconType = static_cast<PlayerIconType>(1 + idx % 9),
+            .isVisible = true,
+            .isLookingLeft = false,
+            .isUpsideDown = idx % 5 == 0,
+            .isDashing = false,
+            .isMini = idx % 3 == 0,
+            .isGrounded = idx % 2 == 0,
+            .isStationary = false,
+            .isFalling = idx % 2 == 1,
+            .didJustJump = false,
+            .isRotating = true,
+            .isSideways = false,
+            .spiderTeleportData = std::nullopt,
+        };
+
+        return PlayerData {
+            .timestamp = t,
+            .player1 = icon,
+            .player2 = icon,
+            .deathCounter = 0.f,
+            .currentPercentage = 0.42f,
+            .isDead = false,
+            .isPaused = false,
+            .isPracticing = false,
+            .isDualMode = idx % 4 == 0,
+            .isInEditor = false,
+            .isEditorBuilding = false,
+            .isLastDeathReal = false,
+        };
+    }
+
+    inline PlayerAccountData makeAccountData(int idx) {
+        return PlayerAccountData(100'000 + idx, 200'000 + idx, "BenchPlayer" + std::to_string(idx), PlayerIconData::DEFAULT_ICONS);
+    }
+
+    inline std::shared_ptr<PlayerDataPacket> makePlayerDataPacket() {
+        return std::make_shared<PlayerDataPacket>(makePlayerData(0), PlayerMetadata { .localBest = 42, .attempts = 100 }, std::vector<GlobedCounterChange>{});
+    }
+
+    inline std::shared_ptr<LevelDataPacket> makeLevelDataPacket(size_t players) {
+        auto packet = std::make_shared<LevelDataPacket>();
+        for (size_t i = 0; i < players; i++) {
+            packet->players.emplace_back(100'000 + i, makePlayerData(i));
+        }
+
+        return packet;
+    }
+
+    inline std::shared_ptr<PlayerProfilesPacket> makePlayerProfilesPacket(size_t players) {
+        auto packet = std::make_shared<PlayerProfilesPacket>();
+        for (size_t i = 0; i < players; i++) {
+            packet->players.push_back(makeAccountData(i));
+        }
+
+        return packet;
+    }
+
+    inline std::shared_ptr<ChatMessageBroadcastPacket> makeChatMessagePacket() {
+        auto packet = std::make_shared<ChatMessageBroadcastPacket>();
+        packet->sender = 100'000;
+        packet->message = "this is a fairly normal length chat message";
+        return packet;
+    }
+
+    // Encodes the packet the same way GameSocket does (minus encryption), header included
+    inline ByteBuffer encodeWithHeader(const Packet& packet) {
+        ByteBuffer buf;
+        buf.writeValue(PacketHeader {
+            .id = packet.getPacketId(),
+            .encrypted = false,
+        });
+
+        packet.encode(buf);
+        return buf;
+    }
+}
@@ -0,0 +1,67 @@
+#include <net/udp_frame_buffer.hpp>
+#include <data/bytebuffer.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+// same frame size as the server uses when splitting packets
+constexpr static size_t FRAME_SIZE = 1400;
+
+// Splits a packet of the given size into frames, as they would arrive from the server
+static std::vector<util::data::bytevector> makeFrames(uint32_t packetId, size_t size) {
+    size_t count = (size + FRAME_SIZE - 1) / FRAME_SIZE;
+
+    std::vector<util::data::bytevector> frames;
+    for (size_t i = 0; i < count; i++) {
+        ByteBuffer buf;
+        buf.writeU32(packetId);
+        buf.writeU8(i);
+        buf.writeU8(count);
+
+        size_t chunk = std::min(FRAME_SIZE, size - i * FRAME_SIZE);
+        for (size_t j = 0; j < chunk; j++) {
+            buf.writeU8(static_cast<uint8_t>(j));
+        }
+
+        frames.push_back(std::move(buf.data()));
+    }
+
+    return frames;
+}
+
+static void reassemble(benchmark::State& state, bool shuffled) {
+    size_t size = state.range(0);
+    auto frames = makeFrames(1, size);
+
+    if (shuffled) {
+        std::mt19937 rng{42};
+        std::shuffle(frames.begin(), frames.end(), rng);
+    }
+
+    UdpFrameBuffer frameBuffer;
+
+    for (auto _ : state) {
+        std::vector<uint8_t> out;
+
+        for (auto& frame : frames) {
+            ByteBuffer buf(frame);
+            out = frameBuffer.pushFrameFromBuffer(buf).unwrap();
+        }
+
+        if (out.size() != size) {
+            state.SkipWithError("reassembled packet has the wrong size");
+            break;
+        }
+
+        // completed packets are never removed from the buffer, so the same ID can't be reused without this
+        frameBuffer.clear();
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+BENCHMARK_CAPTURE(reassemble, ordered, false)->Arg(4096)->Arg(65536);
+BENCHMARK_CAPTURE(reassemble, shuffled, true)->Arg(4096)->Arg(65536);
@@ -0,0 +1,41 @@
+#include "interpolation.hpp"
+
+#include <cstdlib>
+
+#include <benchmark/benchmark.h>
+
+using namespace bench::interpolation;
+
+// Plays a trace back for 100 players. The time is the whole playback, the counters are what matters:
+// tick_us is the cost of one PlayerInterpolator::tick, rms_error and snaps are how far off the movement looks
+static void interpolate(benchmark::State& state, const Trace& trace, const Scenario& scenario) {
+    PlaybackResult result{};
+    for (auto _ : state) {
+        result = run(trace, scenario);
+    }
+
+    state.counters["tick_us"] = result.avgTickMicros;
+    state.counters["worst_tick_us"] = result.worstTickMicros;
+    state.counters["rms_error"] = result.rmsError;
+    state.counters["snaps"] = static_cast<double>(result.snaps);
+}
+
+// every trace with every scenario. set GLOBED_BENCH_CAPTURE to the path of a packet capture to also use recorded movement
+static bool registered = [] {
+    auto traces = syntheticTraces();
+
+    if (auto path = std::getenv("GLOBED_BENCH_CAPTURE")) {
+        if (auto recorded = recordedTrace(path)) {
+            traces.push_back(std::move(recorded.value()));
+        }
+    }
+
+    for (auto& trace : traces) {
+        for (auto& scenario : defaultScenarios()) {
+            benchmark::RegisterBenchmark(("interpolate/" + trace.name + "/" + scenario.name).c_str(), interpolate, trace, scenario)
+                ->Unit(benchmark::kMillisecond);
+        }
+    }
+
+    return true;
+}();
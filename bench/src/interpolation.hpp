@@ -0,0 +1,326 @@
+#pragma once
+
+#include <game/interpolator.hpp>
+#include <data/packets/server/game.hpp>
+#include <net/packet_capture.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+* Runs PlayerInterpolator on movement traces with a manual clock, and measures how well and how fast it
+* reconstructs the original movement under bad network conditions. Shared by the benchmark and the test.
+*
+* Every trace is played back with a fixed latency plus the jitter, loss and reordering of each scenario.
+* With a perfect network the interpolator shows the sender's position from exactly (latency + one tick) ago,
+* so the error is measured against that, and anything that deviates from it counts as visual error.
+*/
+namespace bench::interpolation {
+    using cocos2d::CCPoint;
+
+    // latency every packet gets on top of the jitter
+    constexpr float BASE_LATENCY = 0.05f;
+
+    // the client framerate the playback is simulated at
+    constexpr float FRAME_TIME = 1.f / 60.f;
+
+    // a frame moving this much further than the real movement did is considered a snap (one block)
+    constexpr float SNAP_DISTANCE = 30.f;
+
+    // how long each synthetic trace is, in seconds
+    constexpr float TRACE_LENGTH = 20.f;
+
+    struct Trace {
+        std::string name;
+        float tps;
+        std::vector<PlayerData> samples;            // what the sender sends, in order of sender time
+        std::function<CCPoint(float)> truth;        // the real position at the given sender time
+    };
+
+    struct Scenario {
+        std::string name;
+        float jitter;   // max extra delay of a packet, in seconds
+        float loss;     // chance of a packet getting dropped, 0 to 1
+        float reorder;  // chance of a packet getting delayed past the next one, 0 to 1
+        int repeats = 0; // times each packet arrives again before the next one, like when the receiver sends faster than the sender
+    };
+
+    struct PlaybackResult {
+        double avgTickMicros;
+        double worstTickMicros;
+        float rmsError;
+        size_t snaps;
+    };
+
+    inline PlayerData makeSample(float time, CCPoint pos) {
+        SpecificIconData icon {
+            .position = pos,
+            .rotation = 0.f,
+            .iconType = PlayerIconType::Cube,
+            .isVisible = true,
+            .isLookingLeft = false,
+            .isUpsideDown = false,
+            .isDashing = false,
+            .isMini = false,
+            .isGrounded = false,
+            .isStationary = false,
+            .isFalling = false,
+            .didJustJump = false,
+            .isRotating = false,
+            .isSideways = false,
+            .spiderTeleportData = std::nullopt,
+        };
+
+        return PlayerData {
+            .timestamp = time,
+            .player1 = icon,
+            .player2 = icon,
+            .deathCounter = 0.f,
+            .currentPercentage = 0.f,
+            .isDead = false,
+            .isPaused = false,
+            .isPracticing = false,
+            .isDualMode = false,
+            .isInEditor = false,
+            .isEditorBuilding = false,
+            .isLastDeathReal = false,
+        };
+    }
+
+    inline Trace makeTrace(std::string name, float tps, std::function<CCPoint(float)> truth) {
+        Trace trace {
+            .name = std::move(name),
+            .tps = tps,
+            .truth = std::move(truth),
+        };
+
+        size_t count = static_cast<size_t>(TRACE_LENGTH * tps);
+        trace.samples.reserve(count);
+
+        for (size_t i = 0; i < count; i++) {
+            float t = i / tps;
+            trace.samples.push_back(makeSample(t, trace.truth(t)));
+        }
+
+        return trace;
+    }
+
+    // Generated traces that cover the common kinds of movement
+    inline std::vector<Trace> syntheticTraces() {
+        std::vector<Trace> traces;
+
+        // normal speed cube, jumping every 0.6 seconds
+        traces.push_back(makeTrace("classic", 30.f, [](float t) {
+            float p = std::fmod(t, 0.6f) / 0.6f;
+            return CCPoint{311.f * t, 105.f + 360.f * p * (1.f - p)};
+        }));
+
+        // platformer, changing direction a lot
+        traces.push_back(makeTrace("platformer", 30.f, [](float t) {
+            return CCPoint{200.f * std::sin(t * 1.3f) + 80.f * std::sin(t * 3.1f), 105.f + 50.f * std::abs(std::sin(t * 2.f))};
+        }));
+
+        // fast wave, sharp corners are the worst case for interpolation
+        traces.push_back(makeTrace("wave", 30.f, [](float t) {
+            float p = std::fmod(t, 0.4f) / 0.4f;
+            return CCPoint{577.f * t, 105.f + 120.f * (p < 0.5f ? p : 1.f - p)};
+        }));
+
+        return traces;
+    }
+
+    // Level data from a packet capture (see PacketCapture), one trace for the player with the most samples
+    inline std::optional<Trace> recordedTrace(const std::filesystem::path& path) {
+        auto capture = PacketCapture::load(path);
+        if (!capture) {
+            std::fprintf(stderr, "failed to load the capture: %s\n", capture.unwrapErr().c_str());
+            return std::nullopt;
+        }
+
+        std::unordered_map<int, std::vector<PlayerData>> perPlayer;
+
+        for (auto& record : capture.unwrap().records) {
+            if (record.direction != PacketCapture::Direction::Incoming || !record.cleartext) continue;
+
+            ByteBuffer buf(std::move(record.payload));
+            auto header = buf.readValue<PacketHeader>();
+            if (!header || header.unwrap().id != LevelDataPacket::PACKET_ID) continue;
+
+            LevelDataPacket packet;
+            if (!packet.decode(buf)) continue;
+
+            for (auto& player : packet.players) {
+                perPlayer[player.accountId].push_back(player.data);
+            }
+        }
+
+        auto best = std::max_element(perPlayer.begin(), perPlayer.end(), [](const auto& a, const auto& b) {
+            return a.second.size() < b.second.size();
+        });
+
+        if (best == perPlayer.end() || best->second.size() < 10) return std::nullopt;
+
+        // the capture has them in arrival order, the trace needs them in sender order
+        auto samples = std::move(best->second);
+        std::stable_sort(samples.begin(), samples.end(), [](const auto& a, const auto& b) {
+            return a.timestamp < b.timestamp;
+        });
+
+        samples.erase(std::unique(samples.begin(), samples.end(), [](const auto& a, const auto& b) {
+            return a.timestamp == b.timestamp;
+        }), samples.end());
+
+        float start = samples.front().timestamp;
+        for (auto& sample : samples) {
+            sample.timestamp -= start;
+        }
+
+        float duration = samples.back().timestamp;
+        if (duration <= 0.f) return std::nullopt;
+
+        // the real movement between samples is unknown, so assume it's linear
+        auto shared = std::make_shared<std::vector<PlayerData>>(samples);
+
+        return Trace {
+            .name = "recorded_" + std::to_string(best->first),
+            .tps = (samples.size() - 1) / duration,
+            .samples = std::move(samples),
+            .truth = [shared](float t) {
+                auto& s = *shared;
+                auto it = std::lower_bound(s.begin(), s.end(), t, [](const auto& sample, float t) {
+                    return sample.timestamp < t;
+                });
+
+                if (it == s.begin()) return s.front().player1.position;
+                if (it == s.end()) return s.back().player1.position;
+
+                auto& prev = *(it - 1);
+                float ratio = (t - prev.timestamp) / (it->timestamp - prev.timestamp);
+                return prev.player1.position.lerp(it->player1.position, ratio);
+            },
+        };
+    }
+
+    inline std::vector<Scenario> defaultScenarios() {
+        return {
+            Scenario { "ideal", 0.f, 0.f, 0.f },
+            Scenario { "jitter_20ms", 0.02f, 0.f, 0.f },
+            Scenario { "jitter_60ms", 0.06f, 0.f, 0.f },
+            Scenario { "loss_5%", 0.f, 0.05f, 0.f },
+            Scenario { "loss_20%", 0.f, 0.2f, 0.f },
+            Scenario { "reorder_5%", 0.f, 0.f, 0.05f },
+            Scenario { "mixed", 0.03f, 0.05f, 0.02f },
+            Scenario { "repeated_3x", 0.f, 0.f, 0.f, 2 },
+        };
+    }
+
+    inline PlaybackResult run(const Trace& trace, const Scenario& scenario, size_t playerCount = 100) {
+        using Clock = std::chrono::steady_clock;
+
+        // fixed seed so runs are comparable
+        std::mt19937_64 rng{0x6c657270};
+        std::uniform_real_distribution<float> dist(0.f, 1.f);
+
+        float interval = 1.f / trace.tps;
+
+        // decide when each packet arrives, if at all
+        std::vector<std::pair<float, const PlayerData*>> arrivals;
+        arrivals.reserve(trace.samples.size());
+
+        for (auto& sample : trace.samples) {
+            if (dist(rng) < scenario.loss) continue;
+
+            float arrival = sample.timestamp + BASE_LATENCY + dist(rng) * scenario.jitter;
+            if (dist(rng) < scenario.reorder) {
+                arrival += interval * 1.5f;
+            }
+
+            arrivals.emplace_back(arrival, &sample);
+
+            for (int i = 1; i <= scenario.repeats; i++) {
+                arrivals.emplace_back(arrival + interval * i / (scenario.repeats + 1), &sample);
+            }
+        }
+
+        std::stable_sort(arrivals.begin(), arrivals.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+
+        auto clockPtr = std::make_unique<ManualClock>();
+        auto* clock = clockPtr.get();
+
+        PlayerInterpolator interpolator(InterpolatorSettings {
+            .realtime = false,
+            .isPlatformer = false,
+        }, std::move(clockPtr));
+
+        for (size_t i = 0; i < playerCount; i++) {
+            interpolator.addPlayer(static_cast<int>(i));
+        }
+
+        float endTime = trace.samples.empty() ? 0.f : trace.samples.back().timestamp + BASE_LATENCY + scenario.jitter + interval * 2.f;
+        size_t next = 0;
+
+        double totalTickMicros = 0.0, worstTickMicros = 0.0;
+        size_t ticks = 0, measured = 0, snaps = 0;
+        double squaredError = 0.0;
+
+        std::optional<CCPoint> lastShown;
+        CCPoint lastTruth;
+
+        while (clock->now() < endTime) {
+            clock->advance(FRAME_TIME);
+            float now = clock->now();
+
+            while (next < arrivals.size() && arrivals[next].first <= now) {
+                for (size_t i = 0; i < playerCount; i++) {
+                    interpolator.updatePlayer(static_cast<int>(i), *arrivals[next].second, now);
+                }
+
+                next++;
+            }
+
+            auto tickStart = Clock::now();
+            interpolator.tick(FRAME_TIME);
+            double tickMicros = std::chrono::duration<double, std::micro>(Clock::now() - tickStart).count();
+
+            totalTickMicros += tickMicros;
+            worstTickMicros = std::max(worstTickMicros, tickMicros);
+            ticks++;
+
+            // nothing is shown until there are two frames to interpolate between
+            float idealTime = now - BASE_LATENCY - interval;
+            if (idealTime < interval) continue;
+
+            auto shown = interpolator.getPlayerState(0).player1.position;
+            auto truth = trace.truth(idealTime);
+
+            squaredError += std::pow(shown.getDistance(truth), 2.0);
+            measured++;
+
+            if (lastShown && (shown - *lastShown).getDistance(truth - lastTruth) > SNAP_DISTANCE) {
+                snaps++;
+            }
+
+            lastShown = shown;
+            lastTruth = truth;
+        }
+
+        return PlaybackResult {
+            .avgTickMicros = ticks > 0 ? totalTickMicros / ticks : 0.0,
+            .worstTickMicros = worstTickMicros,
+            .rmsError = measured > 0 ? static_cast<float>(std::sqrt(squaredError / measured)) : 0.f,
+            .snaps = snaps,
+        };
+    }
+}
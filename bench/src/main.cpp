@@ -0,0 +1,17 @@
+#include <crypto/box.hpp>
+
+#include <benchmark/benchmark.h>
+
+int main(int argc, char** argv) {
+    CryptoBox::initLibrary();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include "fixtures.hpp"
+
+#include <benchmark/benchmark.h>
+
+// Encoding, into a fresh buffer every time like GameSocket does
+template <typename F>
+static void encodePacket(benchmark::State& state, F makePacket) {
+    auto packet = makePacket();
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        auto buf = bench::encodeWithHeader(*packet);
+        bytes += buf.size();
+        benchmark::DoNotOptimize(buf.data().data());
+    }
+
+    state.SetBytesProcessed(bytes);
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Decoding, header and matchPacket included, same path as GameSocket::decodePacket for a cleartext packet
+template <typename F>
+static void decodePacket(benchmark::State& state, F makePacket) {
+    auto encoded = bench::encodeWithHeader(*makePacket()).data();
+
+    for (auto _ : state) {
+        ByteBuffer buf(encoded);
+
+        auto header = buf.readValue<PacketHeader>().unwrap();
+        auto packet = matchPacket(header.id);
+
+        auto result = packet->decode(buf);
+        if (result.isErr()) {
+            state.SkipWithError(ByteBuffer::strerror(result.unwrapErr()));
+            break;
+        }
+
+        benchmark::DoNotOptimize(packet.get());
+    }
+
+    state.SetBytesProcessed(state.iterations() * encoded.size());
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_CAPTURE(encodePacket, PlayerDataPacket, bench::makePlayerDataPacket);
+BENCHMARK_CAPTURE(encodePacket, LevelDataPacket_10, [] { return bench::makeLevelDataPacket(10); });
+BENCHMARK_CAPTURE(encodePacket, LevelDataPacket_100, [] { return bench::makeLevelDataPacket(100); });
+BENCHMARK_CAPTURE(encodePacket, PlayerProfilesPacket_50, [] { return bench::makePlayerProfilesPacket(50); });
+BENCHMARK_CAPTURE(encodePacket, ChatMessageBroadcastPacket, bench::makeChatMessagePacket);
+
+// client packets like PlayerDataPacket can't be decoded, only the server ones are here
+BENCHMARK_CAPTURE(decodePacket, LevelDataPacket_10, [] { return bench::makeLevelDataPacket(10); });
+BENCHMARK_CAPTURE(decodePacket, LevelDataPacket_100, [] { return bench::makeLevelDataPacket(100); });
+BENCHMARK_CAPTURE(decodePacket, PlayerProfilesPacket_50, [] { return bench::makePlayerProfilesPacket(50); });
+BENCHMARK_CAPTURE(decodePacket, ChatMessageBroadcastPacket, bench::makeChatMessagePacket);
@@ -0,0 +1,51 @@
+// Out-of-line functions that the benchmarked code calls into, which in the mod live in files that need the game.
+
+#include <defs/assert.hpp>
+#include <defs/minimal_geode.hpp>
+#include <globed/profiler.hpp>
+#include <util/misc.hpp>
+#include <util/singleton.hpp>
+
+#include <cstdlib>
+
+[[noreturn]] void globed::_condFail(const std::source_location& loc, std::string_view message) {
+    throw std::runtime_error(_condFailSafe(loc, message));
+}
+
+std::string globed::_condFailSafe(const std::source_location& loc, std::string_view message) {
+    return std::string(message);
+}
+
+[[noreturn]] void globed::_condFailFatal(const std::source_location& loc, std::string_view message) {
+    log::error("Condition fatally failed: {}", message);
+    log::error("At {} ({}, line {})", loc.function_name(), loc.file_name(), loc.line());
+    std::abort();
+}
+
+[[noreturn]] void globed::destructedSingleton(std::string_view name) {
+    log::error("Singleton {} used after static destruction!", name);
+    std::abort();
+}
+
+bool util::misc::swapFlag(bool& target) {
+    bool state = target;
+    target = false;
+    return state;
+}
+
+// the profiler is never enabled here, so zones don't add anything to the measurements
+namespace globed::profiler {
+    std::atomic_bool _enabled = false;
+
+    uint64_t _now() {
+        return 0;
+    }
+
+    void _record(const char*, uint64_t, uint64_t) {}
+
+    void setEnabled(bool) {}
+
+    geode::Result<> exportChromeTrace(const std::filesystem::path&) {
+        return geode::Err("the profiler is not available in the standalone build");
+    }
+}
@@ -0,0 +1,37 @@
+// Out-of-line functions that CurlManager and HttpCache call into, which in the mod live in files that need the game.
+
+#include <Geode/loader/Mod.hpp>
+#include <util/format.hpp>
+#include <util/net.hpp>
+
+#include <curl/curl.h>
+
+#include <unistd.h>
+
+geode::Mod* geode::Mod::get() {
+    static Mod mod;
+    return &mod;
+}
+
+std::filesystem::path geode::Mod::getSaveDir() const {
+    // one per process, so tests running in parallel don't share an http cache
+    static auto dir = [] {
+        auto path = std::filesystem::temp_directory_path() / ("globed-bench-" + std::to_string(getpid()));
+        std::filesystem::create_directories(path);
+        return path;
+    }();
+
+    return dir;
+}
+
+std::string util::format::urlEncode(std::string_view str) {
+    auto encoded = curl_easy_escape(nullptr, str.data(), str.size());
+
+    std::string result(encoded);
+    curl_free(encoded);
+    return result;
+}
+
+std::string util::net::webUserAgent() {
+    return "globed-bench";
+}
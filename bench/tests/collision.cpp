@@ -0,0 +1,107 @@
+// Checks that the collision broadphase finds exactly the players that a brute force check finds,
+// over frames of randomly moving players of different sizes.
+
+#include <game/player_collisions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using cocos2d::CCRect;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+static std::vector<uint32_t> findCollisions(PlayerCollisions<uint32_t>& collisions, const std::vector<CCRect>& rects, const CCRect& local) {
+    std::vector<uint32_t> hits;
+
+    collisions.forEachCollision(local, [&](uint32_t idx) -> const CCRect& {
+        return rects[idx];
+    }, [&]() -> const CCRect& {
+        return local;
+    }, [&](uint32_t idx, const CCRect&) {
+        hits.push_back(idx);
+    });
+
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
+static void testMatchesBruteForce() {
+    std::mt19937 rng{1337};
+    std::uniform_real_distribution<float> xDist(-500.f, 2500.f), yDist(-100.f, 700.f), sizeDist(5.f, 200.f);
+
+    PlayerCollisions<uint32_t> collisions;
+    size_t totalHits = 0;
+
+    for (size_t frame = 0; frame < 200; frame++) {
+        std::vector<CCRect> rects(400);
+        for (auto& rect : rects) {
+            rect = CCRect{xDist(rng), yDist(rng), sizeDist(rng), sizeDist(rng)};
+        }
+
+        collisions.clear();
+        for (uint32_t i = 0; i < rects.size(); i++) {
+            collisions.insert(i, rects[i]);
+        }
+
+        CHECK(collisions.size() == rects.size());
+
+        for (size_t step = 0; step < 8; step++) {
+            CCRect local{xDist(rng), yDist(rng), sizeDist(rng), sizeDist(rng)};
+
+            std::vector<uint32_t> expected;
+            for (uint32_t i = 0; i < rects.size(); i++) {
+                if (local.intersectsRect(rects[i])) expected.push_back(i);
+            }
+
+            auto hits = findCollisions(collisions, rects, local);
+            CHECK(hits == expected);
+
+            totalHits += hits.size();
+        }
+    }
+
+    // make sure the test actually tests something
+    CHECK(totalHits > 100);
+}
+
+static void testInvalidRects() {
+    float nan = std::nanf("");
+
+    std::vector<CCRect> rects {
+        CCRect{0.f, 0.f, 30.f, 30.f},
+        CCRect{nan, 0.f, 30.f, 30.f},
+        CCRect{10.f, 10.f, INFINITY, 30.f},
+    };
+
+    PlayerCollisions<uint32_t> collisions;
+    for (uint32_t i = 0; i < rects.size(); i++) {
+        collisions.insert(i, rects[i]);
+    }
+
+    CHECK(collisions.size() == 1);
+    CHECK(findCollisions(collisions, rects, CCRect{15.f, 15.f, 30.f, 30.f}) == std::vector<uint32_t>{0});
+    CHECK(findCollisions(collisions, rects, CCRect{nan, nan, 30.f, 30.f}).empty());
+}
+
+int main() {
+    testMatchesBruteForce();
+    testInvalidRects();
+
+    if (failures > 0) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,324 @@
+// Runs CurlManager against a small HTTP server on a loopback port, and checks that concurrent requests
+// all complete with the right bodies, that a cancelled request is actually aborted without affecting the others,
+// and that the http cache reports when it falls back to a cached copy.
+
+#include <managers/curl.hpp>
+#include <managers/http_cache.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+// Answers every request on its own thread and closes the connection afterwards.
+//   /echo/<text>?delay=<ms>  responds with <text> after the delay
+//   /stream                  sends a small chunk every 10ms until the client goes away, or the server stops
+//   /cached/<text>           like /echo, but with an ETag and no max-age, or no response at all while `failing` is set
+class TestServer {
+public:
+    std::atomic<int> active = 0, maxActive = 0;
+    std::atomic<int> streamsStarted = 0, streamsAborted = 0;
+    std::atomic<bool> failing = false;
+
+    TestServer() {
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+
+        int one = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+
+        bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listenFd, 64);
+
+        socklen_t len = sizeof(addr);
+        getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+        port = ntohs(addr.sin_port);
+
+        acceptThread = std::thread([this] { this->acceptLoop(); });
+    }
+
+    ~TestServer() {
+        stopping = true;
+        shutdown(listenFd, SHUT_RDWR);
+        close(listenFd);
+        acceptThread.join();
+
+        for (auto& thread : connections) {
+            thread.join();
+        }
+    }
+
+    std::string url(std::string_view path) const {
+        return "http://127.0.0.1:" + std::to_string(port) + std::string(path);
+    }
+
+private:
+    int listenFd;
+    uint16_t port;
+    std::atomic<bool> stopping = false;
+    std::thread acceptThread;
+    std::vector<std::thread> connections; // only touched by the accept thread until it's joined
+
+    void acceptLoop() {
+        while (!stopping) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) break;
+
+            connections.emplace_back([this, fd] {
+                int now = ++active;
+                int seen = maxActive.load();
+                while (now > seen && !maxActive.compare_exchange_weak(seen, now)) {}
+
+                this->handle(fd);
+
+                active--;
+                close(fd);
+            });
+        }
+    }
+
+    void handle(int fd) {
+        // requests are tiny, so the whole head arrives in one go in practice
+        std::string request;
+        char buf[4096];
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            ssize_t n = recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0) return;
+            request.append(buf, n);
+        }
+
+        auto pathStart = request.find(' ') + 1;
+        auto path = request.substr(pathStart, request.find(' ', pathStart) - pathStart);
+
+        if (path.starts_with("/echo/")) {
+            auto query = path.find('?');
+            auto text = path.substr(6, query == std::string::npos ? std::string::npos : query - 6);
+
+            if (query != std::string::npos && path.compare(query, 7, "?delay=") == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(std::stoi(path.substr(query + 7))));
+            }
+
+            this->sendAll(fd, "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(text.size()) + "\r\nConnection: close\r\n\r\n" + text);
+        } else if (path.starts_with("/cached/")) {
+            if (failing) return;
+
+            auto text = path.substr(8);
+            this->sendAll(fd, "HTTP/1.1 200 OK\r\nETag: \"v1\"\r\nCache-Control: max-age=0\r\nContent-Length: " + std::to_string(text.size()) + "\r\nConnection: close\r\n\r\n" + text);
+        } else if (path == "/stream") {
+            streamsStarted++;
+
+            // promise far more than is ever sent, so the transfer can only end by being aborted
+            if (!this->sendAll(fd, "HTTP/1.1 200 OK\r\nContent-Length: 1000000000\r\nConnection: close\r\n\r\n")) return;
+
+            std::string chunk(1024, 'x');
+            while (!stopping) {
+                if (!this->sendAll(fd, chunk)) {
+                    streamsAborted++;
+                    return;
+                }
+
+                std::this_thread::sleep_for(10ms);
+            }
+        } else {
+            this->sendAll(fd, "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+        }
+    }
+
+    bool sendAll(int fd, std::string_view data) {
+        while (!data.empty()) {
+            ssize_t n = send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            data.remove_prefix(n);
+        }
+
+        return true;
+    }
+};
+
+template <typename F>
+static bool waitFor(F&& cond, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (!cond()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(5ms);
+    }
+
+    return true;
+}
+
+static void testConcurrent(TestServer& server) {
+    constexpr int COUNT = 12;
+    constexpr int DELAY_MS = 300;
+
+    auto started = std::chrono::steady_clock::now();
+
+    std::vector<CurlManager::Task> tasks;
+    for (int i = 0; i < COUNT; i++) {
+        tasks.push_back(CurlRequest().get(server.url(fmt::format("/echo/req{}?delay={}", i, DELAY_MS))).send());
+    }
+
+    bool done = waitFor([&] {
+        for (auto& task : tasks) {
+            if (task.isPending()) return false;
+        }
+
+        return true;
+    }, 10s);
+
+    CHECK(done);
+
+    auto took = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count();
+
+    for (int i = 0; i < COUNT; i++) {
+        auto* response = tasks[i].getFinishedValue();
+        CHECK(response != nullptr);
+        if (!response) continue;
+
+        CHECK(response->getCode() == 200);
+        CHECK(response->text().unwrapOr("") == fmt::format("req{}", i));
+    }
+
+    // one at a time would take COUNT * DELAY_MS
+    CHECK(server.maxActive > 1);
+    CHECK(took < COUNT * DELAY_MS / 2);
+
+    std::printf("concurrent: %d requests in %lldms, up to %d at once\n", COUNT, (long long) took, server.maxActive.load());
+}
+
+static void testCancel(TestServer& server) {
+    auto stream = CurlRequest().get(server.url("/stream")).send();
+    auto other = CurlRequest().get(server.url("/echo/still-here?delay=200")).send();
+
+    CHECK(waitFor([&] { return server.streamsStarted == 1; }, 5s));
+
+    auto cancelledAt = std::chrono::steady_clock::now();
+    stream.cancel();
+
+    // the worker must drop the connection, not just stop reporting progress
+    CHECK(waitFor([&] { return server.streamsAborted == 1; }, 3s));
+    auto took = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - cancelledAt).count();
+
+    CHECK(stream.isCancelled());
+
+    CHECK(waitFor([&] { return !other.isPending(); }, 5s));
+    auto* response = other.getFinishedValue();
+    CHECK(response && response->getCode() == 200 && response->text().unwrapOr("") == "still-here");
+
+    std::printf("cancel: connection closed %lldms after cancelling\n", (long long) took);
+}
+
+static void testCancelRightAway(TestServer& server) {
+    // the worker may or may not have started the transfer by the time it's cancelled, either way no connection may stay open
+    auto task = CurlRequest().get(server.url("/stream")).send();
+    task.cancel();
+
+    CHECK(task.isCancelled());
+
+    std::this_thread::sleep_for(300ms);
+    CHECK(waitFor([&] { return server.streamsStarted == server.streamsAborted; }, 3s));
+}
+
+static void testFallback(TestServer& server) {
+    auto request = [&] {
+        auto task = CurlRequest().get(server.url("/cached/fresh")).cache(CurlCachePolicy::Revalidate).send();
+        CHECK(waitFor([&] { return !task.isPending(); }, 5s));
+        return task;
+    };
+
+    auto first = request();
+    auto* response = first.getFinishedValue();
+    CHECK(response && response->ok() && !response->isFromCache() && !response->isFallback());
+
+    // the entry is stale right away, so this goes to the server, which doesn't answer
+    server.failing = true;
+
+    auto second = request();
+    response = second.getFinishedValue();
+    CHECK(response && response->isFromCache() && response->isFallback());
+    CHECK(response && response->text().unwrapOr("") == "fresh");
+    CHECK(response && !response->getError().empty());
+
+    server.failing = false;
+}
+
+static void testMemoryLimit() {
+    HttpCache cache(Mod::get()->getSaveDir() / "memory-limit");
+
+    auto entry = [](size_t size) {
+        return HttpCacheEntry {
+            .code = 200,
+            .storedAt = HttpCache::now(),
+            .maxAge = 60,
+            .body = std::vector<uint8_t>(size, 'x'),
+        };
+    };
+
+    constexpr size_t COUNT = 5;
+    constexpr size_t SIZE = HttpCache::MAX_MEMORY_SIZE / 3;
+
+    for (size_t i = 0; i < COUNT; i++) {
+        cache.put(std::to_string(i), entry(SIZE));
+    }
+
+    // only the last few fit in memory, the rest are still on disk
+    CHECK(cache.peek("0") == nullptr);
+    CHECK(cache.peek(std::to_string(COUNT - 1)) != nullptr);
+
+    auto reread = cache.get("0");
+    CHECK(reread && reread->body.size() == SIZE);
+
+    // reading it back made it the most recently used, so the next oldest one was dropped instead
+    CHECK(cache.peek("0") != nullptr);
+    CHECK(cache.peek(std::to_string(COUNT - 3)) == nullptr);
+}
+
+int main() {
+    {
+        TestServer server;
+
+        testConcurrent(server);
+        testCancel(server);
+        testCancelRightAway(server);
+        testFallback(server);
+
+        // the server only stops once every connection is closed
+        CHECK(waitFor([&] { return server.active == 0; }, 5s));
+    }
+
+    testMemoryLimit();
+
+    std::error_code ec;
+    std::filesystem::remove_all(Mod::get()->getSaveDir(), ec);
+
+    if (failures) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Plays synthetic movement back through PlayerInterpolator and checks that what it shows stays close to the real movement,
+// with a perfect network and with a bad one. The bounds are loose, they catch interpolation breaking, not small regressions,
+// use the benchmark to compare the numbers.
+
+#include "../src/interpolation.hpp"
+
+#include <cstdio>
+
+using namespace bench::interpolation;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+static void testTraces() {
+    for (auto& trace : syntheticTraces()) {
+        for (auto& scenario : defaultScenarios()) {
+            auto result = run(trace, scenario, 1);
+
+            std::printf("%s / %s: rms error %.2f, %zu snaps\n", trace.name.c_str(), scenario.name.c_str(), result.rmsError, result.snaps);
+
+            // a third of a block with a perfect network, two blocks with the worst one
+            // repeated frames carry nothing new, so they don't count as a bad network
+            if (scenario.jitter == 0.f && scenario.loss == 0.f && scenario.reorder == 0.f) {
+                CHECK(result.rmsError < 10.f);
+                CHECK(result.snaps == 0);
+            } else {
+                CHECK(result.rmsError < 60.f);
+            }
+        }
+    }
+}
+
+// when updates stop coming, the player keeps moving for at most one update interval and then stays in place
+static void testHoldsStillWithoutUpdates() {
+    auto clockPtr = std::make_unique<ManualClock>();
+    auto* clock = clockPtr.get();
+
+    constexpr float interval = 0.1f;
+
+    PlayerInterpolator interpolator(InterpolatorSettings {
+        .realtime = false,
+        .isPlatformer = false,
+    }, std::move(clockPtr));
+
+    interpolator.addPlayer(1);
+
+    // moving right at 100 units per second
+    for (int i = 0; i < 3; i++) {
+        interpolator.updatePlayer(1, makeSample(i * interval, CCPoint{i * 10.f, 0.f}), clock->now());
+
+        for (int j = 0; j < 6; j++) {
+            clock->advance(interval / 6.f);
+            interpolator.tick(interval / 6.f);
+        }
+    }
+
+    float lastX = 0.f;
+    for (int i = 0; i < 120; i++) {
+        clock->advance(FRAME_TIME);
+        interpolator.tick(FRAME_TIME);
+
+        float x = interpolator.getPlayerState(1).player1.position.x;
+        CHECK(x >= lastX - 0.01f);
+        lastX = x;
+    }
+
+    // newest frame is at 20, one interval past that is 30
+    CHECK(lastX >= 20.f - 0.01f);
+    CHECK(lastX <= 30.f + 0.01f);
+}
+
+int main() {
+    testTraces();
+    testHoldsStillWithoutUpdates();
+
+    if (failures) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,216 @@
+// Connects two ReliableChannel instances through a simulated link that drops and reorders datagrams,
+// and checks that every packet arrives exactly once, intact and in order within its channel.
+
+#include <net/reliable_channel.hpp>
+#include <data/bytebuffer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+using Datagram = ReliableChannel::Datagram;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+// One direction of the link. Datagrams are delivered in random order and some are dropped.
+struct Link {
+    std::mt19937 rng;
+    double lossRate;
+    std::vector<Datagram> queue;
+    size_t dropped = 0;
+
+    Link(uint32_t seed, double lossRate) : rng(seed), lossRate(lossRate) {}
+
+    void push(std::vector<Datagram> datagrams) {
+        for (auto& dg : datagrams) {
+            queue.push_back(std::move(dg));
+        }
+    }
+
+    std::vector<Datagram> take() {
+        std::vector<Datagram> out;
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+        for (auto& dg : queue) {
+            if (dist(rng) < lossRate) {
+                dropped++;
+            } else {
+                out.push_back(std::move(dg));
+            }
+        }
+
+        queue.clear();
+        std::shuffle(out.begin(), out.end(), rng);
+
+        return out;
+    }
+};
+
+struct Peer {
+    ReliableChannel channel;
+    std::array<std::vector<Datagram>, ReliableChannel::CHANNEL_COUNT> received;
+
+    // feeds datagrams from the link into the channel, returns the replies
+    std::vector<Datagram> receive(std::vector<Datagram> datagrams) {
+        std::vector<Datagram> replies;
+
+        for (auto& dg : datagrams) {
+            // the channel of a data frame, so completed packets can be sorted per channel
+            uint8_t chan = dg.size() > 2 ? dg[2] : 0;
+
+            ByteBuffer buf(std::move(dg));
+            auto marker = buf.readU8();
+            CHECK(marker.isOk() && marker.unwrap() == ReliableChannel::MARKER);
+
+            auto res = channel.receive(buf, replies);
+            CHECK(res.isOk());
+            if (!res) {
+                std::fprintf(stderr, "receive failed: %s\n", res.unwrapErr().c_str());
+                continue;
+            }
+
+            for (auto& packet : res.unwrap()) {
+                received[chan].push_back(std::move(packet));
+            }
+        }
+
+        return replies;
+    }
+};
+
+static Datagram makePacket(uint8_t channel, size_t index, size_t size) {
+    Datagram packet(size);
+    for (size_t i = 0; i < size; i++) {
+        packet[i] = static_cast<uint8_t>(channel * 31 + index * 7 + i);
+    }
+
+    return packet;
+}
+
+// Sends `count` packets on each of `channels` from a to b, and runs the link until everything is delivered
+static void runTransfer(const char* name, double lossRate, size_t mtu, size_t count, std::initializer_list<uint8_t> channels) {
+    Peer a, b;
+    Link toB(1234, lossRate), toA(4321, lossRate);
+
+    std::array<std::vector<Datagram>, ReliableChannel::CHANNEL_COUNT> expected;
+    std::mt19937 sizeRng(99);
+
+    for (size_t i = 0; i < count; i++) {
+        for (uint8_t chan : channels) {
+            // mostly small packets, with every fifth one split into several fragments
+            size_t size = i % 5 == 0 ? mtu * 4 + sizeRng() % mtu : 1 + sizeRng() % (mtu / 2);
+
+            auto packet = makePacket(chan, i, size);
+            auto res = a.channel.send(chan, packet.data(), packet.size(), mtu);
+            CHECK(res.isOk());
+            if (!res) return;
+
+            toB.push(std::move(res).unwrap());
+            expected[chan].push_back(std::move(packet));
+        }
+    }
+
+    auto done = [&] {
+        for (uint8_t chan : channels) {
+            if (b.received[chan].size() < expected[chan].size()) return false;
+        }
+
+        return a.channel.getStats().inFlight == 0;
+    };
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+
+    while (!done() && std::chrono::steady_clock::now() < deadline) {
+        toA.push(b.receive(toB.take()));
+        a.receive(toA.take());
+
+        auto resend = a.channel.poll();
+        CHECK(resend.isOk());
+        if (!resend) {
+            std::fprintf(stderr, "poll failed: %s\n", resend.unwrapErr().c_str());
+            break;
+        }
+
+        toB.push(std::move(resend).unwrap());
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    CHECK(done());
+
+    for (uint8_t chan : channels) {
+        CHECK(b.received[chan] == expected[chan]);
+    }
+
+    auto stats = a.channel.getStats();
+    if (lossRate > 0.0) {
+        CHECK(stats.framesResent > 0);
+    }
+
+    std::printf(
+        "%s: %zu packets, %llu frames sent, %llu resent, %zu + %zu datagrams dropped\n",
+        name, count * channels.size(), (unsigned long long) stats.framesSent, (unsigned long long) stats.framesResent, toB.dropped, toA.dropped
+    );
+}
+
+static void testHandshake() {
+    ReliableChannel client, server;
+    std::vector<Datagram> replies;
+
+    ByteBuffer hello(client.makeHello());
+    (void) hello.readU8();
+    CHECK(server.receive(hello, replies).isOk());
+    CHECK(replies.size() == 1);
+    CHECK(!client.isEstablished());
+
+    ByteBuffer helloAck(std::move(replies[0]));
+    (void) helloAck.readU8();
+    replies.clear();
+    CHECK(client.receive(helloAck, replies).isOk());
+    CHECK(client.isEstablished());
+}
+
+static void testMalformed() {
+    ReliableChannel chan;
+    std::vector<Datagram> replies;
+
+    // invalid frame type, invalid channel, fragment index past the count, truncated header
+    std::vector<Datagram> bad = {
+        {0x7f},
+        {0, 200, 0, 0, 0, 0, 0, 1},
+        {0, 1, 0, 0, 0, 0, 3, 2},
+        {0, 1, 0},
+    };
+
+    for (auto& dg : bad) {
+        ByteBuffer buf(std::move(dg));
+        CHECK(chan.receive(buf, replies).isErr());
+    }
+}
+
+int main() {
+    testHandshake();
+    testMalformed();
+
+    runTransfer("lossless", 0.0, 200, 50, {1, 2, 3});
+    runTransfer("20% loss", 0.2, 200, 50, {1, 2, 3});
+    runTransfer("35% loss", 0.35, 120, 20, {4, 5});
+
+    if (failures) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+
+    return 0;
+}
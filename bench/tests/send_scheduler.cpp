@@ -0,0 +1,223 @@
+// Queues packets in SendScheduler the way NetworkManager does and checks what comes out of it,
+// encoded the same way as when it's sent to the server.
+
+#include <net/send_scheduler.hpp>
+#include <data/packets/all.hpp>
+#include <util/memory.hpp>
+
+#include "../src/fixtures.hpp"
+
+#include <cstdio>
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+static GlobedCounterChange makeChange(uint16_t itemId, int value) {
+    GlobedCounterChange change;
+    change.itemId = itemId;
+    change.type = GlobedCounterChange::Type::Add;
+    change._val.intVal = value;
+    return change;
+}
+
+static std::shared_ptr<Packet> makePlayerData(std::optional<PlayerMetadata> meta, std::vector<GlobedCounterChange> changes) {
+    return PlayerDataPacket::create(bench::makePlayerData(0), meta, std::move(changes));
+}
+
+struct DecodedPlayerData {
+    std::optional<PlayerMetadata> meta;
+    std::vector<GlobedCounterChange> changes;
+};
+
+// PlayerDataPacket has no decoder in the mod, this reads back what `encode` wrote
+static DecodedPlayerData decodePlayerData(const Packet& packet) {
+    ByteBuffer buf;
+    packet.encode(buf);
+    buf.setPosition(0);
+
+    DecodedPlayerData out;
+
+    CHECK(buf.readValue<PlayerData>().isOk());
+
+    auto meta = buf.readValue<std::optional<PlayerMetadata>>();
+    CHECK(meta.isOk());
+    if (meta) out.meta = meta.unwrap();
+
+    auto count = buf.readU8();
+    CHECK(count.isOk());
+
+    for (size_t i = 0; i < count.unwrapOr(0); i++) {
+        auto change = buf.readValue<GlobedCounterChange>();
+        CHECK(change.isOk());
+        if (change) out.changes.push_back(change.unwrap());
+    }
+
+    return out;
+}
+
+static void testCoalesceKeepsOneShotData() {
+    SendScheduler queue;
+
+    CHECK(queue.push(makePlayerData(PlayerMetadata { .localBest = 42, .attempts = 7 }, {makeChange(1, 10), makeChange(2, 20)})) == nullptr);
+    CHECK(queue.push(makePlayerData(std::nullopt, {makeChange(3, 30)})) != nullptr);
+
+    CHECK(queue.size() == 1);
+
+    auto packet = queue.pop();
+    CHECK(packet && packet->getPacketId() == PlayerDataPacket::PACKET_ID);
+    if (!packet) return;
+
+    auto decoded = decodePlayerData(*packet);
+
+    // both sets of changes, in the order they happened
+    CHECK(decoded.changes.size() == 3);
+    for (size_t i = 0; i < decoded.changes.size(); i++) {
+        CHECK(decoded.changes[i].itemId == i + 1);
+        CHECK(decoded.changes[i]._val.intVal == static_cast<int>(i + 1) * 10);
+    }
+
+    CHECK(decoded.meta.has_value() && decoded.meta->localBest == 42 && decoded.meta->attempts == 7);
+
+    CHECK(queue.pop() == nullptr);
+}
+
+static void testCoalesceNewerMetaWins() {
+    SendScheduler queue;
+
+    queue.push(makePlayerData(PlayerMetadata { .localBest = 1, .attempts = 1 }, {}));
+    queue.push(makePlayerData(PlayerMetadata { .localBest = 2, .attempts = 2 }, {}));
+
+    auto packet = queue.pop();
+    CHECK(packet != nullptr);
+    if (!packet) return;
+
+    auto decoded = decodePlayerData(*packet);
+    CHECK(decoded.meta.has_value() && decoded.meta->localBest == 2);
+}
+
+static void testTooManyChangesAreNotMerged() {
+    SendScheduler queue;
+
+    std::vector<GlobedCounterChange> many(200, makeChange(1, 1));
+
+    CHECK(queue.push(makePlayerData(std::nullopt, many)) == nullptr);
+    CHECK(queue.push(makePlayerData(std::nullopt, many)) == nullptr);
+    CHECK(queue.size() == 2);
+
+    size_t total = 0;
+    while (auto packet = queue.pop()) {
+        total += decodePlayerData(*packet).changes.size();
+    }
+
+    CHECK(total == 400);
+}
+
+static std::vector<packetid_t> drain(SendScheduler& queue) {
+    std::vector<packetid_t> ids;
+    while (auto packet = queue.pop()) {
+        ids.push_back(packet->getPacketId());
+    }
+
+    return ids;
+}
+
+static void testPriority() {
+    SendScheduler queue;
+
+    queue.push(RequestPlayerCountPacket::create());
+    queue.push(UpdatePlayerStatusPacket::create());
+    queue.push(makePlayerData(std::nullopt, {}));
+
+    auto ids = drain(queue);
+    CHECK((ids == std::vector<packetid_t>{PlayerDataPacket::PACKET_ID, UpdatePlayerStatusPacket::PACKET_ID, RequestPlayerCountPacket::PACKET_ID}));
+}
+
+static void testJoinIsNotOvertaken() {
+    SendScheduler queue;
+
+    queue.push(RequestPlayerCountPacket::create());
+    queue.push(LevelJoinPacket::create(1234, false, std::nullopt));
+    queue.push(makePlayerData(std::nullopt, {}));
+    queue.push(LevelLeavePacket::create());
+    queue.push(makePlayerData(std::nullopt, {}));
+
+    // everything from before a join goes before it, player data after it goes after it
+    auto ids = drain(queue);
+    CHECK((ids == std::vector<packetid_t>{
+        RequestPlayerCountPacket::PACKET_ID,
+        LevelJoinPacket::PACKET_ID,
+        PlayerDataPacket::PACKET_ID,
+        LevelLeavePacket::PACKET_ID,
+        PlayerDataPacket::PACKET_ID,
+    }));
+}
+
+static void testNoCoalescingAcrossBarrier() {
+    SendScheduler queue;
+
+    queue.push(makePlayerData(std::nullopt, {makeChange(1, 10)}));
+    queue.push(LeaveRoomPacket::create());
+    CHECK(queue.push(makePlayerData(std::nullopt, {makeChange(2, 20)})) == nullptr);
+
+    auto first = queue.pop();
+    auto leave = queue.pop();
+    auto second = queue.pop();
+
+    CHECK(first && first->getPacketId() == PlayerDataPacket::PACKET_ID);
+    CHECK(leave && leave->getPacketId() == LeaveRoomPacket::PACKET_ID);
+    CHECK(second && second->getPacketId() == PlayerDataPacket::PACKET_ID);
+    if (!first || !second) return;
+
+    auto a = decodePlayerData(*first);
+    auto b = decodePlayerData(*second);
+    CHECK(a.changes.size() == 1 && a.changes[0].itemId == 1);
+    CHECK(b.changes.size() == 1 && b.changes[0].itemId == 2);
+}
+
+static void testMemoryAccounting() {
+    using util::memory::Tag;
+
+    size_t before = util::memory::usage(Tag::OutgoingPackets).current;
+
+    {
+        SendScheduler queue;
+
+        auto big = makePlayerData(std::nullopt, std::vector<GlobedCounterChange>(100, makeChange(1, 1)));
+        CHECK(big->getObjectSize() >= sizeof(PlayerDataPacket) + 100 * sizeof(GlobedCounterChange));
+
+        queue.push(std::move(big));
+        CHECK(util::memory::usage(Tag::OutgoingPackets).current >= before + 100 * sizeof(GlobedCounterChange));
+
+        // the merged packet grows, and the replaced one is gone
+        queue.push(makePlayerData(std::nullopt, {makeChange(2, 2)}));
+        queue.push(ChatMessagePacket::create(std::string(200, 'a')));
+
+        while (queue.pop()) {}
+    }
+
+    CHECK(util::memory::usage(Tag::OutgoingPackets).current == before);
+}
+
+int main() {
+    testCoalesceKeepsOneShotData();
+    testCoalesceNewerMetaWins();
+    testTooManyChangesAreNotMerged();
+    testPriority();
+    testJoinIsNotOvertaken();
+    testNoCoalescingAcrossBarrier();
+    testMemoryAccounting();
+
+    if (failures) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+
+    return 0;
+}
@@ -2,7 +2,24 @@
 
 #include "_internal.hpp"
 
+#include <cstdint>
+#include <vector>
+
 namespace globed::net {
+    // Traffic of a single packet type since the game was started. Rates are per second, over the last 1 or 10 seconds.
+    struct PacketStats {
+        uint16_t packetId;
+        std::string name;
+
+        uint64_t packetsIn, packetsOut;
+        uint64_t bytesIn, bytesOut;
+        uint64_t encrypted, cleartext;
+        uint64_t fragmented, whole;
+
+        float packetsIn1s, packetsOut1s, packetsIn10s, packetsOut10s;
+        float bytesIn1s, bytesOut1s, bytesIn10s, bytesOut10s;
+    };
+
     // Returns whether the player is currently connected to a server.
     Result<bool> isConnected();
 
@@ -18,6 +35,10 @@ namespace globed::net {
 
     // Returns whether a connection break happened and the client is currently trying to reconnect.
     Result<bool> isReconnecting();
+
+    // Returns traffic statistics for every packet type that has been sent or received, in no particular order.
+    // Available in all builds, even when not connected (the counters keep the totals from earlier connections).
+    Result<std::vector<PacketStats>> getPacketStats();
 } // namespace globed::net
 
 // Implementation
@@ -42,4 +63,8 @@ namespace globed::net {
     inline Result<bool> isReconnecting() {
         return _internal::request<bool>(_internal::Type::IsReconnecting);
     }
+
+    inline Result<std::vector<PacketStats>> getPacketStats() {
+        return _internal::request<std::vector<PacketStats>>(_internal::Type::PacketStats);
+    }
 } // namespace globed::net
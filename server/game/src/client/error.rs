@@ -6,7 +6,7 @@ use crate::{
 };
 use globed_shared::reqwest;
 
-use super::PacketTranslationError;
+use super::{PacketTranslationError, ReliableFrameError};
 
 pub enum PacketHandlingError {
     Other(String),                         // unknown generic error
@@ -38,6 +38,7 @@ pub enum PacketHandlingError {
     WebhookError(CentralBridgeError),
     Standalone,
     TranslationError(PacketTranslationError), // failed to translate packet
+    ReliableFrameError(ReliableFrameError),   // malformed reliable udp frame
 }
 
 pub type Result<T> = core::result::Result<T, PacketHandlingError>;
@@ -78,6 +79,12 @@ impl From<DecodeError> for PacketHandlingError {
     }
 }
 
+impl From<ReliableFrameError> for PacketHandlingError {
+    fn from(value: ReliableFrameError) -> Self {
+        Self::ReliableFrameError(value)
+    }
+}
+
 impl From<CentralBridgeError> for PacketHandlingError {
     fn from(value: CentralBridgeError) -> Self {
         Self::BridgeError(value)
@@ -120,6 +127,7 @@ impl Display for PacketHandlingError {
             Self::WebhookError(e) => write!(f, "webhook error: {e}"),
             Self::Standalone => write!(f, "attempted to perform an action that cannot be done on a standalone server"),
             Self::TranslationError(e) => write!(f, "packet translation error: {e}"),
+            Self::ReliableFrameError(e) => write!(f, "{e}"),
         }
     }
 }
@@ -1,5 +1,6 @@
 pub mod error;
 pub mod macros;
+pub mod reliable;
 pub mod socket;
 pub mod state;
 pub mod thread;
@@ -8,6 +9,7 @@ pub mod unauthorized;
 
 pub use error::{PacketHandlingError, Result};
 pub use macros::*;
+pub use reliable::{MARKER_RELIABLE, ReliableChannel, ReliableFrameError};
 pub use socket::ClientSocket;
 pub use state::{AtomicClientThreadState, ClientThreadState};
 pub use thread::{ClientThread, ServerThreadMessage};
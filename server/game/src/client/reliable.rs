@@ -0,0 +1,207 @@
+use std::{collections::BTreeMap, fmt::Display};
+
+/// Receiving end of the reliable UDP channel, see the "Reliable UDP" section in protocol.md.
+///
+/// The client sends the packets that would otherwise go over TCP as frames with a per-channel sequence number,
+/// we deliver them in order within each channel and acknowledge everything we have, so the client only resends what was lost.
+/// The server itself still sends everything over TCP, so there is nothing to retransmit on this side.
+///
+/// Only handles the protocol, sending the replies is up to `ClientSocket`.
+#[derive(Default)]
+pub struct ReliableChannel {
+    incoming: [InChannel; CHANNEL_COUNT],
+    established: bool,
+}
+
+pub const MARKER_RELIABLE: u8 = 0xa9;
+pub const CHANNEL_COUNT: usize = 10;
+
+// how far ahead of the next expected frame we buffer, anything further is dropped and will be resent by the client
+const WINDOW: u32 = 256;
+// same as the limit for tcp packets
+const MAX_PACKET_SIZE: usize = 65536;
+
+const FRAME_DATA: u8 = 0;
+const FRAME_ACK: u8 = 1;
+const FRAME_HELLO: u8 = 2;
+const FRAME_HELLO_ACK: u8 = 3;
+
+const DATA_HEADER_SIZE: usize = 9; // marker, type, channel, seq, fragment index, fragment count
+const ACK_SIZE: usize = 11; // marker, type, channel, next, mask
+
+#[derive(Debug)]
+pub enum ReliableFrameError {
+    TooShort,
+    InvalidFrameType(u8),
+    InvalidChannel(u8),
+    InvalidFragment { index: u8, count: u8 },
+    PacketTooLong(usize),
+}
+
+impl Display for ReliableFrameError {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        match self {
+            Self::TooShort => f.write_str("reliable frame is too short"),
+            Self::InvalidFrameType(t) => write!(f, "invalid reliable frame type: {t}"),
+            Self::InvalidChannel(c) => write!(f, "invalid reliable channel: {c}"),
+            Self::InvalidFragment { index, count } => write!(f, "invalid reliable fragment {index} out of {count}"),
+            Self::PacketTooLong(size) => write!(f, "reassembled reliable packet is too long - {size} bytes"),
+        }
+    }
+}
+
+struct InFrame {
+    index: u8,
+    count: u8,
+    data: Vec<u8>,
+}
+
+#[derive(Default)]
+struct InChannel {
+    next_expected: u32,
+    buffered: BTreeMap<u32, InFrame>,
+    assembling: Vec<u8>, // fragments of a packet received so far
+    next_fragment: u8,
+}
+
+impl ReliableChannel {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Whether the client asked to use reliable frames
+    pub fn is_established(&self) -> bool {
+        self.established
+    }
+
+    pub fn reset(&mut self) {
+        *self = Self::default();
+    }
+
+    /// Handles a datagram that starts with `MARKER_RELIABLE` (including the marker).
+    /// Datagrams that have to be sent back to the client are appended to `replies`,
+    /// returns the packets that were completed by this frame, in order.
+    pub fn receive(&mut self, data: &[u8], replies: &mut Vec<Vec<u8>>) -> Result<Vec<Vec<u8>>, ReliableFrameError> {
+        if data.len() < 2 {
+            return Err(ReliableFrameError::TooShort);
+        }
+
+        let mut completed = Vec::new();
+
+        match data[1] {
+            FRAME_DATA => self.handle_data(data, replies, &mut completed)?,
+            FRAME_HELLO => {
+                self.established = true;
+                replies.push(vec![MARKER_RELIABLE, FRAME_HELLO_ACK]);
+            }
+            // we never send data frames, so there is nothing to acknowledge
+            FRAME_ACK | FRAME_HELLO_ACK => {}
+            t => return Err(ReliableFrameError::InvalidFrameType(t)),
+        }
+
+        Ok(completed)
+    }
+
+    fn handle_data(&mut self, data: &[u8], replies: &mut Vec<Vec<u8>>, completed: &mut Vec<Vec<u8>>) -> Result<(), ReliableFrameError> {
+        if data.len() < DATA_HEADER_SIZE {
+            return Err(ReliableFrameError::TooShort);
+        }
+
+        let channel = data[2];
+        let seq = u32::from_le_bytes([data[3], data[4], data[5], data[6]]);
+        let index = data[7];
+        let count = data[8];
+
+        if channel as usize >= CHANNEL_COUNT {
+            return Err(ReliableFrameError::InvalidChannel(channel));
+        }
+
+        if index >= count {
+            return Err(ReliableFrameError::InvalidFragment { index, count });
+        }
+
+        let chan = &mut self.incoming[channel as usize];
+
+        // sequence numbers are 32-bit and start at 0 for every connection, so wrapping around is not a concern
+        if seq < chan.next_expected || chan.buffered.contains_key(&seq) {
+            // our ack was probably lost, send it again
+            replies.push(Self::make_ack(channel, chan));
+            return Ok(());
+        }
+
+        if seq - chan.next_expected >= WINDOW {
+            // way ahead of what we expect, the client will resend it later
+            return Ok(());
+        }
+
+        chan.buffered.insert(
+            seq,
+            InFrame {
+                index,
+                count,
+                data: data[DATA_HEADER_SIZE..].to_vec(),
+            },
+        );
+
+        let mut result = Ok(());
+
+        // deliver everything that is now in order
+        while let Some(frame) = chan.buffered.remove(&chan.next_expected) {
+            chan.next_expected += 1;
+
+            if frame.index != chan.next_fragment {
+                // the client is misbehaving, drop the partial packet rather than stalling the channel forever
+                chan.assembling.clear();
+                chan.next_fragment = 0;
+                result = Err(ReliableFrameError::InvalidFragment {
+                    index: frame.index,
+                    count: frame.count,
+                });
+                continue;
+            }
+
+            chan.assembling.extend_from_slice(&frame.data);
+
+            if chan.assembling.len() > MAX_PACKET_SIZE {
+                let size = chan.assembling.len();
+                chan.assembling = Vec::new();
+                chan.next_fragment = 0;
+                result = Err(ReliableFrameError::PacketTooLong(size));
+                continue;
+            }
+
+            if frame.index + 1 == frame.count {
+                completed.push(std::mem::take(&mut chan.assembling));
+                chan.next_fragment = 0;
+            } else {
+                chan.next_fragment += 1;
+            }
+        }
+
+        replies.push(Self::make_ack(channel, chan));
+
+        result
+    }
+
+    fn make_ack(channel: u8, chan: &InChannel) -> Vec<u8> {
+        // bit N means frame `next_expected + 1 + N` was received too
+        let mut mask = 0u32;
+        for seq in chan.buffered.keys() {
+            let offset = seq - chan.next_expected - 1;
+            if offset >= 32 {
+                break;
+            }
+
+            mask |= 1 << offset;
+        }
+
+        let mut ack = Vec::with_capacity(ACK_SIZE);
+        ack.push(MARKER_RELIABLE);
+        ack.push(FRAME_ACK);
+        ack.push(channel);
+        ack.extend_from_slice(&chan.next_expected.to_le_bytes());
+        ack.extend_from_slice(&mask.to_le_bytes());
+
+        ack
+    }
+}
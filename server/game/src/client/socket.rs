@@ -21,7 +21,7 @@ use globed_shared::{
 };
 
 use super::{
-    PartialTranslatableEncodable,
+    PartialTranslatableEncodable, ReliableChannel,
     error::{PacketHandlingError, Result},
     macros::*,
 };
@@ -32,6 +32,7 @@ pub struct ClientSocket {
 
     pub tcp_peer: SocketAddrV4,
     pub udp_peer: Option<SocketAddrV4>,
+    pub reliable: ReliableChannel,
     crypto_box: OnceLock<ChaChaBox>,
     game_server: &'static GameServer,
     protocol_version: u16,
@@ -54,6 +55,7 @@ impl ClientSocket {
             socket,
             tcp_peer,
             udp_peer: None,
+            reliable: ReliableChannel::new(),
             crypto_box: OnceLock::new(),
             game_server,
             protocol_version: 0,
@@ -126,6 +128,19 @@ impl ClientSocket {
         self.protocol_version = version;
     }
 
+    /// handle a reliable udp frame from the client and send back the acknowledgements.
+    /// returns the packets that were completed by this frame, in order.
+    pub async fn handle_reliable_frame(&mut self, frame: &[u8]) -> Result<Vec<Vec<u8>>> {
+        let mut replies = Vec::new();
+        let completed = self.reliable.receive(frame, &mut replies);
+
+        for reply in &replies {
+            self.send_buffer_udp(reply).await?;
+        }
+
+        Ok(completed?)
+    }
+
     pub fn decrypt<'a>(&self, message: &'a mut [u8]) -> Result<ByteReader<'a>> {
         if message.len() < PacketHeader::SIZE + NONCE_SIZE + MAC_SIZE {
             return Err(PacketHandlingError::MalformedCiphertext);
@@ -327,7 +327,8 @@ impl ClientThread {
                 | PacketHandlingError::SocketSendFailed(_)
                 | PacketHandlingError::InvalidStreamMarker
                 | PacketHandlingError::TooManyChunks(_)
-                | PacketHandlingError::TranslationError(_) => {
+                | PacketHandlingError::TranslationError(_)
+                | PacketHandlingError::ReliableFrameError(_) => {
                     warn!("[{} @ {}] {}", self.account_id.load(Ordering::Relaxed), self.get_tcp_peer(), error);
                 }
 
@@ -443,8 +444,8 @@ impl ClientThread {
     /// handle a message sent from the `GameServer`
     async fn handle_message(&self, message: ServerThreadMessage) -> Result<()> {
         match message {
-            ServerThreadMessage::Packet(mut packet) => self.handle_packet(&mut packet).await?,
-            ServerThreadMessage::SmallPacket((mut packet, len)) => self.handle_packet(&mut packet[..len]).await?,
+            ServerThreadMessage::Packet(mut packet) => self.handle_udp_message(&mut packet).await?,
+            ServerThreadMessage::SmallPacket((mut packet, len)) => self.handle_udp_message(&mut packet[..len]).await?,
             ServerThreadMessage::BroadcastText(text_packet) => self.send_packet_static(&text_packet).await?,
             ServerThreadMessage::BroadcastVoice(voice_packet) => self.send_packet_dynamic(&*voice_packet).await?,
             ServerThreadMessage::BroadcastNotice(packet) => {
@@ -492,6 +493,29 @@ impl ClientThread {
         Ok(())
     }
 
+    /// handle a udp datagram forwarded by the `GameServer`, either a single packet or a reliable frame
+    async fn handle_udp_message(&self, message: &mut [u8]) -> Result<()> {
+        if message.first() == Some(&MARKER_RELIABLE) {
+            return self.handle_reliable_frame(message).await;
+        }
+
+        self.handle_packet(message).await
+    }
+
+    /// handle a reliable udp frame, which may complete multiple packets if it filled a gap
+    async fn handle_reliable_frame(&self, message: &[u8]) -> Result<()> {
+        // safety: only we can receive data from our client.
+        let completed = unsafe { self.socket.get_mut() }.handle_reliable_frame(message).await?;
+
+        for mut packet in completed {
+            if let Err(e) = self.handle_packet(&mut packet).await {
+                self.print_error(&e);
+            }
+        }
+
+        Ok(())
+    }
+
     /// handle an incoming packet
     async fn handle_packet(&self, message: &mut [u8]) -> Result<()> {
         #[cfg(debug_assertions)]
@@ -546,6 +570,7 @@ impl ClientThread {
 
             /* game related */
             RequestPlayerProfilesPacket::PACKET_ID => self.handle_request_profiles(&mut data).await,
+            RequestPlayerProfilesBatchPacket::PACKET_ID => self.handle_request_profiles_batch(&mut data).await,
             LevelJoinPacket::PACKET_ID => self.handle_level_join(&mut data).await,
             LevelLeavePacket::PACKET_ID => self.handle_level_leave(&mut data).await,
             PlayerDataPacket::PACKET_ID => self.handle_player_data(&mut data).await,
@@ -232,6 +232,24 @@ impl ClientThread {
         self.send_packet_dynamic(&PlayerProfilesPacket { players }).await
     });
 
+    gs_handler!(self, handle_request_profiles_batch, RequestPlayerProfilesBatchPacket, packet, {
+        let _ = gs_needauth!(self);
+
+        let level_id = self.level_id.load(Ordering::Relaxed);
+        if level_id == 0 {
+            return Err(PacketHandlingError::UnexpectedPlayerData);
+        }
+
+        if packet.requested.is_empty() {
+            return Ok(());
+        }
+
+        let is_mod = self.can_moderate();
+        let players = self.game_server.get_player_account_data_many(&packet.requested, is_mod);
+
+        self.send_packet_dynamic(&PlayerProfilesPacket { players }).await
+    });
+
     /* Note: blocking logic for voice & chat packets is not in here but in the packet receiving function */
 
     gs_handler!(self, handle_voice, VoicePacket, packet, {
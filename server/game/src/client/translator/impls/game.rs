@@ -21,5 +21,6 @@ impl Translatable for LevelJoinPacket {
 impl Translatable for LevelLeavePacket {}
 impl Translatable for PlayerDataPacket {}
 impl Translatable for RequestPlayerProfilesPacket {}
+impl Translatable for RequestPlayerProfilesBatchPacket {}
 impl Translatable for VoicePacket {}
 impl Translatable for ChatMessagePacket {}
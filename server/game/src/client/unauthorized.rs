@@ -180,6 +180,8 @@ impl UnauthorizedThread {
 
                             socket.socket = stream;
                             socket.tcp_peer = tcp_peer;
+                            // the client starts over with a fresh reliable channel after reconnecting
+                            socket.reliable.reset();
 
                             if let Err(e) = self.send_login_success().await {
                                 thrd_warn!(self, "failed to send login success: {e}");
@@ -2,6 +2,9 @@
 pub const MAX_NOTICE_SIZE: usize = 280;
 /// maximum characters in a user message (156)
 pub const MAX_MESSAGE_SIZE: usize = 156;
+
+/// maximum amount of profiles that can be requested in a single `RequestPlayerProfilesBatchPacket` (64)
+pub const MAX_PROFILES_REQUESTED: usize = 64;
 /// amount of chars in a room id string (6)
 pub const ROOM_ID_LENGTH: usize = 6;
 
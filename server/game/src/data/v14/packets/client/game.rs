@@ -26,6 +26,12 @@ pub struct PlayerDataPacket {
     pub counter_changes: Vec1L<GlobedCounterChange>,
 }
 
+#[derive(Packet, Decodable)]
+#[packet(id = 12005)]
+pub struct RequestPlayerProfilesBatchPacket {
+    pub requested: FastVec<i32, MAX_PROFILES_REQUESTED>,
+}
+
 #[derive(Packet, Decodable)]
 #[packet(id = 12010, encrypted = true)]
 pub struct VoicePacket {
@@ -24,7 +24,7 @@ use tokio::{
 use crate::tokio::sync::oneshot; // no way
 
 use crate::{
-    client::{ClientThreadState, PacketHandlingError},
+    client::{ClientThreadState, MARKER_RELIABLE, PacketHandlingError},
     managers::Room,
     tokio::{
         self,
@@ -429,8 +429,11 @@ impl GameServer {
             SocketAddr::V6(_) => bail!("rejecting request from ipv6 host"),
         };
 
+        // reliable frames don't start with a packet header and always go to the thread
+        let is_reliable = buf[..len].first() == Some(&MARKER_RELIABLE);
+
         // if it's a ping packet, we can handle it here. otherwise we send it to the appropriate thread.
-        if !self.try_udp_handle(&buf[..len], peer).await? {
+        if is_reliable || !self.try_udp_handle(&buf[..len], peer).await? {
             let thread = { self.clients.lock().get(&peer).cloned() };
             if let Some(thread) = thread {
                 thread
@@ -635,6 +638,36 @@ impl GameServer {
             })
     }
 
+    /// like `get_player_account_data` but for multiple players at once, only locks and iterates the clients once.
+    pub fn get_player_account_data_many(&self, account_ids: &[i32], force_visibility: bool) -> Vec<PlayerAccountData> {
+        let mut vec = Vec::with_capacity(account_ids.len());
+
+        for thr in self.clients.lock().values() {
+            if !account_ids.contains(&thr.account_id.load(Ordering::Relaxed)) {
+                continue;
+            }
+
+            let settings = thr.privacy_settings.lock();
+            if settings.get_hide_in_game() && !force_visibility {
+                continue;
+            }
+
+            let mut data = thr.account_data.lock().clone();
+
+            if settings.get_hide_roles() && !force_visibility {
+                data.special_user_data.roles = None;
+            }
+
+            vec.push(data);
+
+            if vec.len() == account_ids.len() {
+                break;
+            }
+        }
+
+        vec
+    }
+
     #[inline]
     pub fn get_player_preview_data(&self, account_id: i32) -> Option<PlayerPreviewAccountData> {
         self.clients
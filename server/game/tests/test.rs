@@ -1,7 +1,11 @@
 // this doc is mostly for flamegraphs
 #![allow(clippy::wildcard_imports, clippy::cast_possible_truncation)]
 use esp::{ByteBuffer, ByteReader};
-use globed_game_server::{data::*, managers::LevelManager};
+use globed_game_server::{
+    client::reliable::{MARKER_RELIABLE, ReliableChannel},
+    data::*,
+    managers::LevelManager,
+};
 use std::hint::black_box;
 
 const ITERS: usize = 500_000;
@@ -128,3 +132,74 @@ fn test_player_manager() {
         }
     }
 }
+
+fn reliable_data_frame(channel: u8, seq: u32, index: u8, count: u8, data: &[u8]) -> Vec<u8> {
+    let mut frame = vec![MARKER_RELIABLE, 0, channel];
+    frame.extend_from_slice(&seq.to_le_bytes());
+    frame.push(index);
+    frame.push(count);
+    frame.extend_from_slice(data);
+    frame
+}
+
+#[test]
+fn test_reliable_channel() {
+    let mut channel = ReliableChannel::new();
+    let mut replies = Vec::new();
+
+    // hello is answered with a hello ack
+    assert!(channel.receive(&[MARKER_RELIABLE, 2], &mut replies).unwrap().is_empty());
+    assert_eq!(replies.pop().unwrap(), vec![MARKER_RELIABLE, 3]);
+    assert!(channel.is_established());
+
+    // a packet split into 3 fragments, arriving as 2, 0, 1
+    assert!(
+        channel
+            .receive(&reliable_data_frame(1, 2, 2, 3, b"ghi"), &mut replies)
+            .unwrap()
+            .is_empty()
+    );
+    assert!(
+        channel
+            .receive(&reliable_data_frame(1, 0, 0, 3, b"abc"), &mut replies)
+            .unwrap()
+            .is_empty()
+    );
+    let completed = channel.receive(&reliable_data_frame(1, 1, 1, 3, b"def"), &mut replies).unwrap();
+    assert_eq!(completed, vec![b"abcdefghi".to_vec()]);
+
+    // the first ack selectively acknowledges frame 2, the last one everything before 3
+    assert_eq!(&replies[0][3..], [0, 0, 0, 0, 0b10, 0, 0, 0]);
+    assert_eq!(&replies[2][3..], [3, 0, 0, 0, 0, 0, 0, 0]);
+    replies.clear();
+
+    // a duplicate is acknowledged again but not delivered twice
+    assert!(
+        channel
+            .receive(&reliable_data_frame(1, 1, 1, 3, b"def"), &mut replies)
+            .unwrap()
+            .is_empty()
+    );
+    assert_eq!(replies.len(), 1);
+
+    // channels are independent, a gap in one does not hold back another
+    assert!(
+        channel
+            .receive(&reliable_data_frame(2, 1, 0, 1, b"second"), &mut replies)
+            .unwrap()
+            .is_empty()
+    );
+    assert_eq!(
+        channel.receive(&reliable_data_frame(3, 0, 0, 1, b"other"), &mut replies).unwrap(),
+        vec![b"other".to_vec()]
+    );
+
+    // filling the gap delivers both packets in order
+    let completed = channel.receive(&reliable_data_frame(2, 0, 0, 1, b"first"), &mut replies).unwrap();
+    assert_eq!(completed, vec![b"first".to_vec(), b"second".to_vec()]);
+
+    // malformed frames are rejected
+    assert!(channel.receive(&reliable_data_frame(10, 0, 0, 1, b""), &mut replies).is_err());
+    assert!(channel.receive(&reliable_data_frame(1, 3, 1, 1, b""), &mut replies).is_err());
+    assert!(channel.receive(&[MARKER_RELIABLE, 0, 1], &mut replies).is_err());
+}
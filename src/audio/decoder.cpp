@@ -3,6 +3,7 @@
 #ifdef GLOBED_VOICE_SUPPORT
 
 #include <opus.h>
+#include <globed/profiler.hpp>
 
 using namespace util::data;
 
@@ -58,6 +59,8 @@ AudioDecoder& AudioDecoder::operator=(AudioDecoder&& other) noexcept {
 }
 
 Result<DecodedOpusData> AudioDecoder::decode(const byte* data, size_t length) {
+    GLOBED_PROFILE_ZONE("AudioDecoder::decode");
+
     DecodedOpusData out;
 
     out.length = frameSize * channels;
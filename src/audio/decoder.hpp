@@ -48,11 +48,7 @@ public:
     // sets the amount of channels that will be used and recreates the decoder
     Result<> setChannels(int channels);
 
-private:
-    // EXPERIMENTAL ZONE
-    // See the note in `encoder.hpp`
-
-    // reset the internal decoder state
+    // reset the internal decoder state, should be done after a discontinuity in the decoded stream
     Result<> resetState();
 
 protected:
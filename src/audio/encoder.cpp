@@ -3,6 +3,7 @@
 #ifdef GLOBED_VOICE_SUPPORT
 
 #include <opus.h>
+#include <globed/profiler.hpp>
 
 using namespace util::data;
 
@@ -85,6 +86,8 @@ AudioEncoder& AudioEncoder::operator=(AudioEncoder&& other) noexcept {
 }
 
 Result<EncodedOpusData> AudioEncoder::encode(const float* data) {
+    GLOBED_PROFILE_ZONE("AudioEncoder::encode");
+
     EncodedOpusData out;
     size_t bytes = sizeof(float) * frameSize / 4; // the /4 is arbitrary, could experiment with it
     out.ptr = new byte[bytes];
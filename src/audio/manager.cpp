@@ -12,6 +12,7 @@
 #include <fmod_errors.h>
 #include <Geode/utils/permission.hpp>
 
+#include <globed/profiler.hpp>
 #include <globed/tracing.hpp>
 #include <managers/error_queues.hpp>
 #include <managers/settings.hpp>
@@ -531,6 +532,9 @@ Result<> GlobedAudioManager::audioThreadWork() {
         return Ok();
     }
 
+    // the sleep at the end is intentionally left out of the zone
+    std::optional<globed::profiler::ScopedZone> zone(std::in_place, "GlobedAudioManager::audioThreadWork");
+
     FMOD_ERR_CHECK_SAFE(
         recordSound->lock(0, recordChunkSize, (void**)&pcmData, nullptr, &pcmLen, nullptr),
         "Sound::lock"
@@ -577,6 +581,7 @@ Result<> GlobedAudioManager::audioThreadWork() {
         }
     }
 
+    zone.reset();
     std::this_thread::sleep_for(std::chrono::milliseconds(2));
     // std::this_thread::yield();
 
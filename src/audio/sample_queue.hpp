@@ -5,6 +5,8 @@
 
 #include "decoder.hpp"
 
+#include <util/memory.hpp>
+
 class AudioSampleQueue {
 public:
     AudioSampleQueue() {};
@@ -24,7 +26,7 @@ public:
     float* data();
 
 private:
-    std::vector<float> buf;
+    util::memory::TrackedVector<float, util::memory::Tag::AudioQueues> buf;
 };
 
 #endif // GLOBED_VOICE_SUPPORT
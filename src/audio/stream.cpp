@@ -3,13 +3,14 @@
 #ifdef GLOBED_VOICE_SUPPORT
 
 #include "manager.hpp"
+#include <globed/profiler.hpp>
 #include <util/misc.hpp>
 
 using namespace asp::time;
 
 AudioStream::AudioStream(AudioDecoder&& decoder)
     : decoder(std::move(decoder)),
-      estimator(std::move(VolumeEstimator(VOICE_TARGET_SAMPLERATE))),
+      estimator(VOICE_TARGET_SAMPLERATE),
       lastPlaybackTime(SystemTime::now()) {
     FMOD_CREATESOUNDEXINFO exinfo = {};
 
@@ -21,6 +22,8 @@ AudioStream::AudioStream(AudioDecoder&& decoder)
     exinfo.length = sizeof(float) * exinfo.numchannels * exinfo.defaultfrequency * (VOICE_CHUNK_RECORD_TIME * 1);
 
     exinfo.pcmreadcallback = [](FMOD_SOUND* sound_, void* data, unsigned int len) -> FMOD_RESULT {
+        GLOBED_PROFILE_ZONE("AudioStream::pcmreadcallback");
+
         FMOD::Sound* sound = reinterpret_cast<FMOD::Sound*>(sound_);
         AudioStream* stream = nullptr;
         sound->getUserData((void**)&stream);
@@ -34,7 +37,6 @@ AudioStream::AudioStream(AudioDecoder&& decoder)
 
         size_t neededSamples = len / sizeof(float);
         size_t copied = stream->queue.lock()->copyTo(reinterpret_cast<float*>(data), neededSamples);
-        stream->estimator.lock()->feedData(reinterpret_cast<const float*>(data), copied);
 
         if (copied != neededSamples) {
             stream->starving = true;
@@ -47,6 +49,9 @@ AudioStream::AudioStream(AudioDecoder&& decoder)
             stream->lastPlaybackTime = SystemTime::now();
         }
 
+        // feed everything that is about to be played, including silence, so the loudness decays naturally
+        stream->estimator.feedData(reinterpret_cast<const float*>(data), neededSamples);
+
         return FMOD_OK;
     };
 
@@ -78,12 +83,13 @@ AudioStream::AudioStream(AudioStream&& other) noexcept {
     sound = other.sound;
     channel = other.channel;
     lastPlaybackTime = other.lastPlaybackTime;
+    suspended = other.suspended;
     other.sound = nullptr;
     other.channel = nullptr;
 
     *queue.lock() = std::move(*other.queue.lock());
     decoder = std::move(other.decoder);
-    *estimator.lock() = std::move(*other.estimator.lock());
+    estimator = std::move(other.estimator);
 }
 
 AudioStream& AudioStream::operator=(AudioStream&& other) noexcept {
@@ -98,13 +104,14 @@ AudioStream& AudioStream::operator=(AudioStream&& other) noexcept {
 
         this->sound = other.sound;
         this->channel = other.channel;
+        this->suspended = other.suspended;
 
         other.sound = nullptr;
         other.channel = nullptr;
 
         *queue.lock() = std::move(*other.queue.lock());
         decoder = std::move(other.decoder);
-        *estimator.lock() = std::move(*other.estimator.lock());
+        estimator = std::move(other.estimator);
     }
 
     return *this;
@@ -119,6 +126,8 @@ void AudioStream::start() {
 }
 
 Result<> AudioStream::writeData(const EncodedAudioFrame& frame) {
+    if (suspended) return Ok();
+
     const auto& frames = frame.getFrames();
     for (const auto& opusFrame : frames) {
         auto decodedFrame_ = decoder.decode(opusFrame);
@@ -137,23 +146,46 @@ void AudioStream::writeData(const float* pcm, size_t samples) {
 }
 
 void AudioStream::setVolume(float volume) {
-    if (channel) {
+    if (channel && !suspended) {
         channel->setVolume(volume);
     }
 
     this->volume = volume;
 }
 
-float AudioStream::getVolume() {
-    return volume;
+void AudioStream::suspend() {
+    if (suspended) return;
+
+    suspended = true;
+
+    // let whatever is left in the queue play out silently, cutting it off would cause a pop
+    if (channel) {
+        channel->setVolume(0.f);
+    }
 }
 
-void AudioStream::updateEstimator(float dt) {
-    estimator.lock()->update(dt);
+void AudioStream::resume() {
+    if (!suspended) return;
+
+    suspended = false;
+
+    queue.lock()->clear();
+    (void) decoder.resetState();
+
+    // ramps back up from silence
+    this->setVolume(this->volume);
+}
+
+bool AudioStream::isSuspended() {
+    return suspended;
+}
+
+float AudioStream::getVolume() {
+    return volume;
 }
 
 float AudioStream::getLoudness() {
-    return estimator.lock()->getVolume() * this->volume;
+    return estimator.getVolume() * this->volume;
 }
 
 asp::time::SystemTime AudioStream::getLastPlaybackTime() {
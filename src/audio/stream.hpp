@@ -35,9 +35,14 @@ public:
     // set the volume of the stream (0.0f - 1.0f, beyond 1.0f amplifies)
     void setVolume(float volume);
 
+    // mute the stream and stop decoding incoming frames. the channel volume is ramped by FMOD, so this does not click
+    void suspend();
+    // resume a suspended stream, dropping any stale queued audio and resetting the decoder
+    void resume();
+    bool isSuspended();
+
     float getVolume();
 
-    void updateEstimator(float dt);
     // get how loud the sound is being played
     float getLoudness();
 
@@ -50,8 +55,9 @@ private:
     FMOD::Channel* channel = nullptr;
     asp::Mutex<AudioSampleQueue> queue;
     AudioDecoder decoder;
-    asp::Mutex<VolumeEstimator> estimator;
+    VolumeEstimator estimator;
     float volume = 0.f;
+    bool suspended = false;
     asp::time::SystemTime lastPlaybackTime;
 };
 
@@ -77,18 +77,30 @@ void VoicePlaybackManager::setVolumeAll(float volume) {
     }
 }
 
-void VoicePlaybackManager::updateEstimator(int playerId, float dt) {
+void VoicePlaybackManager::suspendStream(int playerId) {
     if (streams.contains(playerId)) {
-        streams.at(playerId)->updateEstimator(dt);
+        streams.at(playerId)->suspend();
     }
 }
 
-void VoicePlaybackManager::updateAllEstimators(float dt) {
-    for (const auto& [_, stream] : streams) {
-        stream->updateEstimator(dt);
+void VoicePlaybackManager::resumeStream(int playerId) {
+    if (streams.contains(playerId)) {
+        streams.at(playerId)->resume();
+    }
+}
+
+void VoicePlaybackManager::resumeAll() {
+    for (const auto& [playerId, stream] : streams) {
+        stream->resume();
     }
 }
 
+bool VoicePlaybackManager::isSuspended(int playerId) {
+    if (!streams.contains(playerId)) return false;
+
+    return streams.at(playerId)->isSuspended();
+}
+
 float VoicePlaybackManager::getLoudness(int playerId) {
     if (!streams.contains(playerId)) return 0.f;
 
@@ -122,8 +134,12 @@ float VoicePlaybackManager::getVolume(int playerId) {
 }
 void VoicePlaybackManager::muteEveryone() {}
 void VoicePlaybackManager::setVolumeAll(float volume) {}
-void VoicePlaybackManager::updateEstimator(int playerId, float dt) {}
-void VoicePlaybackManager::updateAllEstimators(float dt) {}
+void VoicePlaybackManager::suspendStream(int playerId) {}
+void VoicePlaybackManager::resumeStream(int playerId) {}
+void VoicePlaybackManager::resumeAll() {}
+bool VoicePlaybackManager::isSuspended(int playerId) {
+    return false;
+}
 float VoicePlaybackManager::getLoudness(int playerId) {
     return 0.f;
 }
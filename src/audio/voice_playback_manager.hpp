@@ -28,8 +28,11 @@ public:
     void muteEveryone();
     void setVolumeAll(float volume);
 
-    void updateEstimator(int playerId, float dt);
-    void updateAllEstimators(float dt);
+    // suspended streams are muted and do not decode any incoming frames
+    void suspendStream(int playerId);
+    void resumeStream(int playerId);
+    void resumeAll();
+    bool isSuspended(int playerId);
 
     float getLoudness(int playerId);
     asp::time::SystemTime getLastPlaybackTime(int playerId);
@@ -1,55 +1,110 @@
 #include "volume_estimator.hpp"
 
-#include "manager.hpp"
 #include <util/misc.hpp>
 
 #ifdef GLOBED_VOICE_SUPPORT
 
 VolumeEstimator::VolumeEstimator(size_t sampleRate) {
-    this->sampleRate = sampleRate;
+    this->bucketSize = std::max<size_t>(1, static_cast<size_t>(static_cast<float>(sampleRate) * WINDOW_SIZE) / BUCKET_COUNT);
 }
 
-VolumeEstimator::VolumeEstimator() {
-    this->sampleRate = 0;
-}
+VolumeEstimator::VolumeEstimator() : VolumeEstimator(0) {}
 
-void VolumeEstimator::feedData(const float* pcm, size_t samples) {
-    sampleQueue.writeData(pcm, samples);
+VolumeEstimator::VolumeEstimator(const VolumeEstimator& other) {
+    this->copyFrom(other);
+}
 
-    if (sampleQueue.size() > static_cast<float>(sampleRate) * BUFFER_SIZE) {
-        sampleQueue.clear();
+VolumeEstimator& VolumeEstimator::operator=(const VolumeEstimator& other) {
+    if (this != &other) {
+        this->copyFrom(other);
     }
+
+    return *this;
 }
 
-void VolumeEstimator::update(float dt) {
-    if (std::isnan(dt)) {
-        dt = 0.f;
+VolumeEstimator::VolumeEstimator(VolumeEstimator&& other) {
+    this->copyFrom(other);
+}
+
+VolumeEstimator& VolumeEstimator::operator=(VolumeEstimator&& other) {
+    if (this != &other) {
+        this->copyFrom(other);
     }
 
-    dt = std::clamp(dt, 0.0f, 0.25f);
+    return *this;
+}
+
+void VolumeEstimator::copyFrom(const VolumeEstimator& other) {
+    bucketSize = other.bucketSize;
+    bucketSquares = other.bucketSquares;
+    bucketAbs = other.bucketAbs;
+    bucketPeaks = other.bucketPeaks;
+    bucketIdx = other.bucketIdx;
+    curSquares = other.curSquares;
+    curAbs = other.curAbs;
+    curPeak = other.curPeak;
+    curSamples = other.curSamples;
+    volume.store(other.volume.load(std::memory_order::relaxed), std::memory_order::relaxed);
+    rms.store(other.rms.load(std::memory_order::relaxed), std::memory_order::relaxed);
+    peak.store(other.peak.load(std::memory_order::relaxed), std::memory_order::relaxed);
+}
 
-    const size_t needed = static_cast<size_t>(static_cast<float>(sampleRate) * BUFFER_SIZE * dt);
+void VolumeEstimator::feedData(const float* pcm, size_t samples) {
+    while (samples > 0) {
+        size_t count = std::min(samples, bucketSize - curSamples);
 
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wvla-cxx-extension"
-    float buf[needed];
-#pragma clang diagnostic pop
+        auto stats = util::misc::calculatePcmStats(pcm, count);
+        curSquares += stats.sumSquares;
+        curAbs += stats.sumAbs;
+        curPeak = std::max(curPeak, stats.peak);
+        curSamples += count;
 
-    size_t copied = sampleQueue.copyTo(buf, needed);
+        pcm += count;
+        samples -= count;
 
-    if (copied < needed) {
-        // fill the rest with void
-        for (size_t i = copied; i < needed; i++) {
-            buf[i] = 0.f;
+        if (curSamples == bucketSize) {
+            this->commitBucket();
         }
     }
+}
+
+void VolumeEstimator::commitBucket() {
+    bucketSquares[bucketIdx] = curSquares;
+    bucketAbs[bucketIdx] = curAbs;
+    bucketPeaks[bucketIdx] = curPeak;
+    bucketIdx = (bucketIdx + 1) % BUCKET_COUNT;
+
+    curSquares = 0.f;
+    curAbs = 0.f;
+    curPeak = 0.f;
+    curSamples = 0;
+
+    // recalculating the whole window avoids accumulating float errors and is cheap enough
+    float squares = 0.f;
+    float absSum = 0.f;
+    float windowPeak = 0.f;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        squares += bucketSquares[i];
+        absSum += bucketAbs[i];
+        windowPeak = std::max(windowPeak, bucketPeaks[i]);
+    }
+
+    float windowSamples = static_cast<float>(bucketSize * BUCKET_COUNT);
+    volume.store(absSum / windowSamples, std::memory_order::relaxed);
+    rms.store(std::sqrt(squares / windowSamples), std::memory_order::relaxed);
+    peak.store(windowPeak, std::memory_order::relaxed);
+}
 
-    volume = util::misc::calculatePcmVolume(buf, needed);
+float VolumeEstimator::getVolume() const {
+    return volume.load(std::memory_order::relaxed);
 }
 
-float VolumeEstimator::getVolume() {
-    return volume;
+float VolumeEstimator::getRms() const {
+    return rms.load(std::memory_order::relaxed);
 }
 
+float VolumeEstimator::getPeak() const {
+    return peak.load(std::memory_order::relaxed);
+}
 
-#endif // GLOBED_VOICE_SUPPORT
\ No newline at end of file
+#endif // GLOBED_VOICE_SUPPORT
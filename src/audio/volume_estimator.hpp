@@ -3,32 +3,59 @@
 
 #ifdef GLOBED_VOICE_SUPPORT
 
-#include "sample_queue.hpp"
-#include <util/collections.hpp>
-
+#include <array>
+#include <atomic>
+
+/*
+* VolumeEstimator keeps a sliding-window volume, RMS and peak of the samples that were played.
+* `feedData` must only be called from a single thread (the FMOD callback),
+* while the getters are lock-free and can be called from anywhere.
+*/
 class GLOBED_DLL VolumeEstimator {
 public:
     VolumeEstimator(size_t sampleRate);
     VolumeEstimator();
 
-    VolumeEstimator(const VolumeEstimator&) = default;
-    VolumeEstimator& operator=(const VolumeEstimator&) = default;
+    VolumeEstimator(const VolumeEstimator&);
+    VolumeEstimator& operator=(const VolumeEstimator&);
 
-    VolumeEstimator(VolumeEstimator&&) = default;
-    VolumeEstimator& operator=(VolumeEstimator&&) = default;
+    VolumeEstimator(VolumeEstimator&&);
+    VolumeEstimator& operator=(VolumeEstimator&&);
 
     void feedData(const float* pcm, size_t samples);
 
-    void update(float dt);
-
-    float getVolume();
+    // mean absolute value of the samples played in the last `WINDOW_SIZE` seconds.
+    // this is the same scale as `util::misc::calculatePcmVolume`, which the loudness meters and speaker ranking are tuned for
+    float getVolume() const;
+    // RMS of the samples played in the last `WINDOW_SIZE` seconds
+    float getRms() const;
+    // absolute peak of the samples played in the last `WINDOW_SIZE` seconds
+    float getPeak() const;
 
 private:
-    static constexpr float BUFFER_SIZE = 1.0f;
+    static constexpr float WINDOW_SIZE = 0.1f;
+    static constexpr size_t BUCKET_COUNT = 8;
+
+    size_t bucketSize;
+
+    // sum of squares, sum of absolute values and peak of every complete bucket in the window
+    std::array<float, BUCKET_COUNT> bucketSquares{};
+    std::array<float, BUCKET_COUNT> bucketAbs{};
+    std::array<float, BUCKET_COUNT> bucketPeaks{};
+    size_t bucketIdx = 0;
+
+    // the bucket that is currently being filled
+    float curSquares = 0.f;
+    float curAbs = 0.f;
+    float curPeak = 0.f;
+    size_t curSamples = 0;
+
+    std::atomic<float> volume = 0.f;
+    std::atomic<float> rms = 0.f;
+    std::atomic<float> peak = 0.f;
 
-    float volume;
-    size_t sampleRate;
-    AudioSampleQueue sampleQueue;
+    void commitBucket();
+    void copyFrom(const VolumeEstimator& other);
 };
 
-#endif // GLOBED_VOICE_SUPPORT
\ No newline at end of file
+#endif // GLOBED_VOICE_SUPPORT
@@ -6,8 +6,7 @@
 #include <util/crypto.hpp>
 #include <defs/assert.hpp>
 #include <defs/minimal_geode.hpp>
-
-#include <util/debug.hpp>
+#include <globed/profiler.hpp>
 
 using namespace util::data;
 
@@ -41,8 +40,7 @@ void CryptoBox::initLibrary() {
 
     // if there is a logic error in the crypto code, this lambda will be called
     sodium_set_misuse_handler([] {
-        log::error("sodium_misuse called. we are officially screwed.");
-        util::debug::suicide();
+        GLOBED_HARD_ASSERT(false, "sodium_misuse called. we are officially screwed.");
     });
 }
 
@@ -90,6 +88,8 @@ void CryptoBox::setPeerKey(const byte* key) {
 }
 
 Result<size_t> CryptoBox::encryptInto(const byte* src, byte* dest, size_t size) {
+    GLOBED_PROFILE_ZONE("CryptoBox::encrypt");
+
     byte nonce[NONCE_LEN];
     util::crypto::secureRandom(nonce, NONCE_LEN);
 
@@ -103,6 +103,8 @@ Result<size_t> CryptoBox::encryptInto(const byte* src, byte* dest, size_t size)
 }
 
 Result<size_t> CryptoBox::decryptInto(const util::data::byte* src, util::data::byte* dest, size_t size) {
+    GLOBED_PROFILE_ZONE("CryptoBox::decrypt");
+
     CRYPTO_REQUIRE_SAFE(size >= PREFIX_LEN, "message is too short")
 
     const byte* nonce = src;
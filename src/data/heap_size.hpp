@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <type_traits>
+#include <asp/misc/traits.hpp>
+#include <boost/describe.hpp>
+#include <boost/mp11.hpp>
+
+#include <util/misc.hpp>
+
+/*
+* Approximate heap memory owned by a value, for memory accounting of packets and such.
+*
+* Strings, vectors, optionals, maps and described structs are handled here.
+* Any other type is assumed to own no heap memory, unless `customHeapSize` is specialized for it.
+*/
+
+// Heap memory owned by a type that isn't described. Can be specialized for any type that owns memory.
+template <typename T>
+size_t customHeapSize(const T&) {
+    return 0;
+}
+
+template <typename T>
+size_t heapSize(const T& value) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        return 0;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        // short strings are stored inline
+        static const size_t inlineCapacity = std::string{}.capacity();
+        return value.capacity() > inlineCapacity ? value.capacity() + 1 : 0;
+    } else if constexpr (asp::is_std_vector<T>::value) {
+        size_t total = value.capacity() * sizeof(typename T::value_type);
+
+        if constexpr (!std::is_trivially_copyable_v<typename T::value_type>) {
+            for (const auto& elem : value) {
+                total += heapSize(elem);
+            }
+        }
+
+        return total;
+    } else if constexpr (asp::is_std_optional<T>::value) {
+        return value ? heapSize(*value) : 0;
+    } else if constexpr (util::misc::is_map<T>::value) {
+        // every entry is its own tree node, with 3 pointers and the color
+        size_t total = value.size() * (sizeof(typename T::value_type) + 4 * sizeof(void*));
+
+        for (const auto& [key, val] : value) {
+            total += heapSize(key) + heapSize(val);
+        }
+
+        return total;
+    } else if constexpr (boost::describe::has_describe_members<T>::value) {
+        size_t total = 0;
+
+        boost::mp11::mp_for_each<boost::describe::describe_members<T, boost::describe::mod_public>>([&](auto descriptor) {
+            total += heapSize(value.*descriptor.pointer);
+        });
+
+        return total;
+    } else {
+        return customHeapSize<T>(value);
+    }
+}
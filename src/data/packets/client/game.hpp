@@ -63,6 +63,25 @@ inline void ByteBuffer::customEncode<PlayerDataPacket>(const PlayerDataPacket& p
     }
 }
 
+template <>
+inline size_t customHeapSize<PlayerDataPacket>(const PlayerDataPacket& packet) {
+    return heapSize(packet.meta) + heapSize(packet.counterChanges);
+}
+
+// 12005 - RequestPlayerProfilesBatchPacket
+class RequestPlayerProfilesBatchPacket : public Packet {
+    GLOBED_PACKET(12005, RequestPlayerProfilesBatchPacket, false, false)
+
+    // must match the limit on the server
+    static constexpr size_t MAX_REQUESTED = 64;
+
+    RequestPlayerProfilesBatchPacket() {}
+    RequestPlayerProfilesBatchPacket(std::vector<int>&& requested) : requested(std::move(requested)) {}
+
+    std::vector<int> requested;
+};
+GLOBED_SERIALIZABLE_STRUCT(RequestPlayerProfilesBatchPacket, (requested));
+
 #ifdef GLOBED_VOICE_SUPPORT
 
 #include <audio/frame.hpp>
@@ -27,6 +27,10 @@ public:
         return "RawPacket";
     }
 
+    size_t getObjectSize() const override {
+        return sizeof(*this) + buffer.data().capacity();
+    }
+
     void encode(ByteBuffer& buf) const override {
         buf.writeValue<ByteBuffer>(buffer);
     }
@@ -3,6 +3,7 @@
 #include <defs/minimal_geode.hpp>
 #include <defs/assert.hpp>
 #include <data/bytebuffer.hpp>
+#include <data/heap_size.hpp>
 
 using packetid_t = uint16_t;
 
@@ -16,6 +17,7 @@ using packetid_t = uint16_t;
     bool getUseTcp() const override { return this->SHOULD_USE_TCP; } \
     bool getEncrypted() const override { return this->ENCRYPTED; } \
     const char* getPacketName() const override { return this->PACKET_NAME; } \
+    size_t getObjectSize() const override { return sizeof(*this) + heapSize(*this); } \
     void encode(ByteBuffer& buf) const override { \
         using InstTy = typename std::remove_reference_t<decltype(*this)>; \
         using NonCvTy = typename std::remove_cv_t<InstTy>; \
@@ -42,6 +44,8 @@ public:
     virtual bool getUseTcp() const = 0;
     virtual bool getEncrypted() const = 0;
     virtual const char* getPacketName() const = 0;
+    // Approximate memory used by the packet, the object itself and the heap memory owned by its fields
+    virtual size_t getObjectSize() const = 0;
 
     template <typename T>
     requires std::is_base_of_v<Packet, T>
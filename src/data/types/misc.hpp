@@ -99,6 +99,11 @@ public:
     cocos2d::ccColor3B getAnyColor() const;
 
     void animateLabel(cocos2d::CCLabelBMFont* label) const;
+    // for sprites that hold a label as children with cascading color, e.g. BatchedNameLabel
+    void animateLabel(cocos2d::CCSprite* sprite) const;
+
+private:
+    void animateNode(cocos2d::CCNode* node, cocos2d::CCRGBAProtocol* rgba) const;
 };
 
 GLOBED_SERIALIZABLE_STRUCT(RichColor, (
@@ -0,0 +1,76 @@
+#include "misc.hpp"
+
+#include <util/format.hpp>
+
+// The parts of the misc types that need the game (cocos nodes and formatting utils).
+// Kept out of misc.cpp so that src/data can be built on its own, see bench/.
+
+using namespace geode::prelude;
+
+Result<RichColor> RichColor::parse(std::string_view k) {
+    if (k.find('>') == std::string::npos) {
+        auto col = util::format::parseColor(k);
+        if (!col) return Err(std::move(col.unwrapErr()));
+
+        return Ok(RichColor(col.unwrap()));
+    }
+
+    if (k.starts_with('#')) {
+        k = k.substr(1, k.size() - 1);
+    }
+
+    auto pieces = util::format::split(k, ">");
+    std::vector<cocos2d::ccColor3B> colors;
+
+    for (auto piece : pieces) {
+        auto col = util::format::parseColor(util::format::trim(piece));
+        if (!col) {
+            return Err(std::move(col.unwrapErr()));
+        }
+
+        colors.emplace_back(col.unwrap());
+    }
+
+    return Ok(RichColor(colors));
+}
+
+void RichColor::animateLabel(cocos2d::CCLabelBMFont* label) const {
+    this->animateNode(label, label);
+}
+
+void RichColor::animateLabel(cocos2d::CCSprite* sprite) const {
+    this->animateNode(sprite, sprite);
+}
+
+void RichColor::animateNode(cocos2d::CCNode* node, cocos2d::CCRGBAProtocol* rgba) const {
+    constexpr int tag = 34925671;
+
+    if (!node) return;
+
+    node->stopActionByTag(tag);
+
+    if (!this->isMultiple()) {
+        rgba->setColor(this->getColor());
+        return;
+    }
+
+    const auto& colors = this->getColors();
+    if (colors.empty()) {
+        return;
+    }
+
+    // set the last color
+    rgba->setColor(colors.at(colors.size() - 1));
+
+    // create an action to tint between the rest of the colors
+    CCArray* actions = CCArray::create();
+
+    for (const auto& color : colors) {
+        actions->addObject(CCTintTo::create(0.8f, color.r, color.g, color.b));
+    }
+
+    CCRepeat* action = CCRepeat::create(CCSequence::create(actions), 99999999);
+    action->setTag(tag);
+
+    node->runAction(action);
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 #include "util.hpp"
 
+#include <version>
+
 #if defined(__cpp_lib_source_location) && __cpp_lib_source_location >= 201907L
 # include <source_location>
 #endif
@@ -1,14 +1,17 @@
 #include "interpolator.hpp"
 
-#include "lerp_logger.hpp"
-#include <hooks/gjbasegamelayer.hpp>
+#include <globed/profiler.hpp>
 #include <util/math.hpp>
-#include <util/debug.hpp>
-#include <util/format.hpp>
+#include <util/misc.hpp>
+
+#ifdef GLOBED_DEBUG_INTERPOLATION
+# include "lerp_logger.hpp"
+#endif
 
 using namespace geode::prelude;
 
-PlayerInterpolator::PlayerInterpolator(const InterpolatorSettings& settings) : settings(settings) {}
+PlayerInterpolator::PlayerInterpolator(const InterpolatorSettings& settings, std::unique_ptr<InterpolatorClock> clock)
+    : settings(settings), clock(std::move(clock)) {}
 
 void PlayerInterpolator::addPlayer(int playerId) {
     players.emplace(playerId, PlayerState {});
@@ -28,6 +31,18 @@ bool PlayerInterpolator::hasPlayer(int playerId) {
 void PlayerInterpolator::updatePlayer(int playerId, const PlayerData& data, float updateCounter) {
     auto& player = players.at(playerId);
     player.updateCounter = updateCounter;
+
+    // the server sends level data at our own rate, so if the player sends less often than us, the same frame arrives several times.
+    // starting over from it would freeze the player until their next frame
+    if (player.totalFrames > 0 && data.timestamp == player.newerFrame.timestamp) {
+        return;
+    }
+
+    if (player.totalFrames > 0 && data.timestamp > player.newerFrame.timestamp) {
+        float delta = data.timestamp - player.newerFrame.timestamp;
+        player.expectedDelta = player.expectedDelta == 0.f ? delta : std::lerp(player.expectedDelta, delta, DELTA_SMOOTHING);
+    }
+
     player.pendingRealFrame = true;
     player.totalFrames++;
 
@@ -44,7 +59,9 @@ void PlayerInterpolator::updatePlayer(int playerId, const PlayerData& data, floa
     player.frameFlags.pendingP1Jump = data.player1.didJustJump;
     player.frameFlags.pendingP2Jump = data.player1.didJustJump;
 
+#ifdef GLOBED_DEBUG_INTERPOLATION
     LerpLogger::get().logRealFrame(playerId, this->getLocalTs(), data.timestamp, data.player1);
+#endif
 
     if (settings.realtime) {
         player.interpolatedState = data;
@@ -98,21 +115,33 @@ static inline void lerpPlayer(
 void PlayerInterpolator::tick(float dt) {
     if (settings.realtime) return;
 
+    GLOBED_PROFILE_ZONE("PlayerInterpolator::tick");
+
+#ifdef GLOBED_DEBUG_INTERPOLATION
     auto localTs = this->getLocalTs();
+#endif
 
     for (auto& [playerId, player] : players) {
         if (player.totalFrames < 2) continue;
 
         float frameDelta = player.newerFrame.timestamp - player.olderFrame.timestamp;
         if (frameDelta == 0.f) {
+#ifdef GLOBED_DEBUG_INTERPOLATION
             LerpLogger::get().logLerpSkip(playerId, localTs, player.timeCounter, player.interpolatedState.player1);
+#endif
             continue;
         }
 
-        float lerpRatio = (player.timeCounter - player.olderFrame.timestamp) / frameDelta;
+        // if the next update is late, keep moving past the newest frame for at most one update interval, then hold still.
+        // that covers a single lost or delayed update, without flinging the player off when they stop coming altogether
+        float maxAhead = std::min(player.expectedDelta, frameDelta);
+        float lerpTime = std::min(player.timeCounter, player.newerFrame.timestamp + maxAhead);
+        float lerpRatio = (lerpTime - player.olderFrame.timestamp) / frameDelta;
         lerpPlayer(player.olderFrame.visual, player.newerFrame.visual, player.interpolatedState, lerpRatio);
 
+#ifdef GLOBED_DEBUG_INTERPOLATION
         LerpLogger::get().logLerpOperation(playerId, localTs, player.timeCounter, player.interpolatedState.player1);
+#endif
 
         player.timeCounter += dt;
     }
@@ -143,7 +172,7 @@ bool PlayerInterpolator::isPlayerStale(int playerId, float lastServerPacket) {
 }
 
 float PlayerInterpolator::getLocalTs() {
-    return GlobedGJBGL::get()->m_fields->timeCounter;
+    return clock->now();
 }
 
 PlayerInterpolator::LerpFrame::LerpFrame() {
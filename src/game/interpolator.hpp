@@ -6,14 +6,41 @@
 struct InterpolatorSettings {
     bool realtime;      // no interpolation at all
     bool isPlatformer;  // platformer duh
-    float expectedDelta;
+};
+
+// Where the interpolator gets the local time from, in seconds. Only used for logging and staleness, never for the lerp itself.
+class GLOBED_DLL InterpolatorClock {
+public:
+    virtual ~InterpolatorClock() = default;
+    virtual float now() = 0;
+};
+
+// The time counter of the current game layer, the default
+class GLOBED_DLL GameLayerClock : public InterpolatorClock {
+public:
+    float now() override;
+};
+
+// Time that only moves when told to, for running the interpolator outside of a level
+class GLOBED_DLL ManualClock : public InterpolatorClock {
+public:
+    float now() override {
+        return time;
+    }
+
+    void advance(float dt) {
+        time += dt;
+    }
+
+private:
+    float time = 0.f;
 };
 
 class GLOBED_DLL PlayerInterpolator {
 public:
     struct PlayerState;
 
-    PlayerInterpolator(const InterpolatorSettings& settings);
+    PlayerInterpolator(const InterpolatorSettings& settings, std::unique_ptr<InterpolatorClock> clock = std::make_unique<GameLayerClock>());
 
     PlayerInterpolator(PlayerInterpolator&) = delete;
     PlayerInterpolator& operator=(PlayerInterpolator&) = delete;
@@ -42,8 +69,11 @@ public:
 private:
     std::unordered_map<int, PlayerState> players;
     InterpolatorSettings settings;
+    std::unique_ptr<InterpolatorClock> clock;
 
     constexpr static bool EXTRAPOLATION = false;
+    // weight of a new sample in `PlayerState::expectedDelta`
+    constexpr static float DELTA_SMOOTHING = 0.2f;
 
 public:
 
@@ -60,6 +90,9 @@ public:
         float timeCounter = 0.0f;
         float deathCounter = 0.0f;
         size_t totalFrames = 0;
+        // smoothed time between the player's frames, every player sends at their own rate (see `SendRateController`).
+        // limits how far the player is moved past their newest frame
+        float expectedDelta = 0.0f;
 
         LerpFrame olderFrame, newerFrame;
         VisualPlayerState interpolatedState;
@@ -1,6 +1,19 @@
 #include "lerp_logger.hpp"
 
 #include <defs/assert.hpp>
+#include <util/memory.hpp>
+
+// push_back that counts any growth of the vector towards the lerp logger's memory usage.
+// the vectors are never shrunk or freed, `reset` only clears them
+template <typename T>
+static void pushTracked(std::vector<T>& vec, T&& value) {
+    size_t before = vec.capacity();
+    vec.push_back(std::move(value));
+
+    if (vec.capacity() != before) {
+        util::memory::add(util::memory::Tag::LerpLogger, (vec.capacity() - before) * sizeof(T));
+    }
+}
 
 void LerpLogger::reset(uint32_t id) {
 #ifdef GLOBED_DEBUG_INTERPOLATION
@@ -15,14 +28,14 @@ void LerpLogger::reset(uint32_t id) {
 void LerpLogger::logRealFrame(uint32_t id, float localts, float timeCounter, const SpecificIconData& data) {
 #ifdef GLOBED_DEBUG_INTERPOLATION
     auto& player = this->ensureExists(id);
-    player.realFrames.push_back(this->makeLogData(data, localts, timeCounter));
+    pushTracked(player.realFrames, this->makeLogData(data, localts, timeCounter));
 #endif
 }
 
 void LerpLogger::logExtrapolatedRealFrame(uint32_t id, float localts, float realTime, float timeCounter, const SpecificIconData& realData, const SpecificIconData& extrapolatedData) {
 #ifdef GLOBED_DEBUG_INTERPOLATION
     auto& player = this->ensureExists(id);
-    player.realExtrapolatedFrames.push_back(std::make_pair(
+    pushTracked(player.realExtrapolatedFrames, std::make_pair(
         this->makeLogData(realData, localts, realTime),
         this->makeLogData(extrapolatedData, localts, timeCounter)
     ));
@@ -32,14 +45,14 @@ void LerpLogger::logExtrapolatedRealFrame(uint32_t id, float localts, float real
 void LerpLogger::logLerpOperation(uint32_t id, float localts, float timeCounter, const SpecificIconData& data) {
 #ifdef GLOBED_DEBUG_INTERPOLATION
     auto& player = this->ensureExists(id);
-    player.lerpedFrames.push_back(this->makeLogData(data, localts, timeCounter));
+    pushTracked(player.lerpedFrames, this->makeLogData(data, localts, timeCounter));
 #endif
 }
 
 void LerpLogger::logLerpSkip(uint32_t id, float localts, float timeCounter, const SpecificIconData& data) {
 #ifdef GLOBED_DEBUG_INTERPOLATION
     auto& player = this->ensureExists(id);
-    player.lerpSkippedFrames.push_back(this->makeLogData(data, localts, timeCounter));
+    pushTracked(player.lerpSkippedFrames, this->makeLogData(data, localts, timeCounter));
 #endif
 }
 
@@ -4,3 +4,4 @@
 #include "deathlink.hpp"
 #include "collision.hpp"
 #include "two_player_mode.hpp"
+#include "synthetic_crowd.hpp"
@@ -36,72 +36,66 @@ static bool shouldCorrectCollision(const CCRect& p1, const CCRect& p2, CCPoint&
 void CollisionModule::checkCollisions(PlayerObject* player, float dt, bool p2) {
     bool isSecond = player == gameLayer->m_player2;
 
-    for (const auto& [_, rp] : gameLayer->m_fields->players) {
-        auto* p1 = rp->player1->getPlayerObject();
-        auto* p2 = rp->player2->getPlayerObject();
+    // reset the sticky state of everyone we collided with on the last check
+    auto& stickyPlayers = isSecond ? stickyP2 : stickyP1;
+    for (auto* vp : stickyPlayers) {
+        isSecond ? vp->setP2StickyState(false) : vp->setP1StickyState(false);
+    }
+    stickyPlayers.clear();
 
-        auto& p1Rect = p1->getObjectRect();
-        auto& p2Rect = p2->getObjectRect();
+    CCRect queryRect = player->getObjectRect();
 
-        auto& playerRect = player->getObjectRect();
+    auto rectOf = [](ComplexVisualPlayer* vp) -> const CCRect& {
+        return vp->getPlayerObject()->getObjectRect();
+    };
 
-        CCRect p1CollRect = p1Rect;
-        CCRect p2CollRect = p2Rect;
+    auto localRect = [&]() -> const CCRect& {
+        return player->getObjectRect();
+    };
 
-        constexpr float padding = 2.f;
+    collisions.forEachCollision(queryRect, rectOf, localRect, [&](ComplexVisualPlayer* vp, const CCRect& remoteRect) {
+        auto* remoteObject = vp->getPlayerObject();
+        auto& playerRect = player->getObjectRect();
 
-        // p1CollRect.origin += CCPoint{padding, padding};
-        // p1CollRect.size -= CCSize{padding * 2, padding * 2};
+        CCRect collRect = remoteRect;
 
-        // p2CollRect.origin += CCPoint{padding, padding};
-        // p2CollRect.size -= CCSize{padding * 2, padding * 2};
+        auto prev = player->getPosition();
+        player->collidedWithObject(dt, remoteObject, collRect, false);
+        auto displacement = player->getPosition() - prev;
 
-        bool intersectsP1 = playerRect.intersectsRect(p1CollRect);
-        bool intersectsP2 = playerRect.intersectsRect(p2CollRect);
+        bool shouldRevert = shouldCorrectCollision(playerRect, remoteRect, displacement);
 
-        if (isSecond) {
-            rp->player1->setP2StickyState(false);
-            rp->player2->setP2StickyState(false);
-        } else {
-            rp->player1->setP1StickyState(false);
-            rp->player2->setP1StickyState(false);
+        if (shouldRevert) {
+            player->setPosition(player->getPosition() + displacement);
         }
 
-        if (intersectsP1) {
-            auto prev = player->getPosition();
-            player->collidedWithObject(dt, p1, p1CollRect, false);
-            auto displacement = player->getPosition() - prev;
-
-            // log::debug("p1 intersect, displacement: {}", displacement);
-
-            bool shouldRevert = shouldCorrectCollision(playerRect, p1Rect, displacement);
-
-            if (shouldRevert) {
-                player->setPosition(player->getPosition() + displacement);
-            }
-
-            if (std::abs(displacement.y) > 0.001f) {
-                isSecond ? rp->player1->setP2StickyState(true) : rp->player1->setP1StickyState(true);
-            }
+        if (std::abs(displacement.y) > 0.001f) {
+            isSecond ? vp->setP2StickyState(true) : vp->setP1StickyState(true);
+            stickyPlayers.push_back(vp);
         }
+    });
+}
 
-        if (intersectsP2) {
-            auto prev = player->getPosition();
-            player->collidedWithObject(dt, p2, p2CollRect, false);
-            auto displacement = player->getPosition() - prev;
+void CollisionModule::onPlayerLeave(RemotePlayer* player) {
+    std::erase_if(stickyP1, [&](auto* vp) { return vp->getRemotePlayer() == player; });
+    std::erase_if(stickyP2, [&](auto* vp) { return vp->getRemotePlayer() == player; });
 
-            // log::debug("p2 intersect, displacement: {}", displacement);
+    // the player is still in the player list at this point, and is destroyed before the next frame
+    this->rebuildGrid(player);
+}
 
-            bool shouldRevert = shouldCorrectCollision(playerRect, p2Rect, displacement);
+void CollisionModule::selUpdate(float dt) {
+    this->rebuildGrid();
+}
 
-            if (shouldRevert) {
-                player->setPosition(player->getPosition() + displacement);
-            }
+void CollisionModule::rebuildGrid(RemotePlayer* except) {
+    collisions.clear();
 
-            if (std::abs(displacement.y) > 0.001f) {
-                isSecond ? rp->player2->setP2StickyState(true) : rp->player2->setP1StickyState(true);
-            }
-        }
+    for (const auto& [_, rp] : gameLayer->m_fields->players) {
+        if (rp == except) continue;
+
+        collisions.insert(rp->player1, rp->player1->getPlayerObject()->getObjectRect());
+        collisions.insert(rp->player2, rp->player2->getPlayerObject()->getObjectRect());
     }
 }
 
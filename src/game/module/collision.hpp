@@ -2,6 +2,9 @@
 
 #include "base.hpp"
 #include <defs/platform.hpp>
+#include <game/player_collisions.hpp>
+
+class ComplexVisualPlayer;
 
 class GLOBED_DLL CollisionModule : public BaseGameplayModule {
 public:
@@ -11,9 +14,19 @@ public:
     void loadLevelSettingsPost() override;
     void checkCollisions(PlayerObject* player, float dt, bool p2) override;
 
+    void onPlayerLeave(RemotePlayer* player) override;
+    void selUpdate(float dt) override;
+
     bool shouldSaveProgress() override;
 
 private:
     bool lastPlat = false;
     int lastLength = 0;
+
+    // rebuilt every frame after players are interpolated, remote players don't move between physics steps
+    PlayerCollisions<ComplexVisualPlayer*> collisions;
+    // players whose sticky state was set, so that only those have to be reset on the next check
+    std::vector<ComplexVisualPlayer*> stickyP1, stickyP2;
+
+    void rebuildGrid(RemotePlayer* except = nullptr);
 };
\ No newline at end of file
@@ -0,0 +1,337 @@
+#include "synthetic_crowd.hpp"
+
+#include <data/packets/server/game.hpp>
+#include <globed/tracing.hpp>
+#include <hooks/gjbasegamelayer.hpp>
+#include <net/manager.hpp>
+
+#ifdef GLOBED_VOICE_SUPPORT
+# include <audio/manager.hpp>
+#endif
+
+using namespace geode::prelude;
+using namespace asp::time;
+
+// fake account IDs start here, far away from real ones
+constexpr static int FIRST_ACCOUNT_ID = 1'500'000'000;
+
+// how far the generated players are spread out from the spawn point
+constexpr static float SPREAD = 150.f;
+
+// how fast the players move in the Line pattern, roughly normal speed
+constexpr static float LINE_SPEED = 311.f;
+constexpr static float LINE_LENGTH = 3000.f;
+
+static std::optional<std::string> crowdArg(std::string_view name) {
+    return Loader::get()->getLaunchArgument(fmt::format("globed-crowd-{}", name));
+}
+
+template <typename T>
+static void parseCrowdArg(std::string_view name, T& out) {
+    auto arg = crowdArg(name);
+    if (!arg) return;
+
+    auto res = geode::utils::numFromString<T>(*arg);
+    if (!res) {
+        log::warn("Invalid value for globed-crowd-{}: {}", name, *arg);
+        return;
+    }
+
+    out = res.unwrap();
+}
+
+SyntheticCrowdModule::Config SyntheticCrowdModule::Config::fromLaunchArgs() {
+    Config config;
+
+    parseCrowdArg("players", config.players);
+    parseCrowdArg("churn", config.churn);
+    parseCrowdArg("jitter", config.jitter);
+    parseCrowdArg("loss", config.loss);
+    parseCrowdArg("speakers", config.speakers);
+    parseCrowdArg("tps", config.tps);
+
+    if (auto movement = crowdArg("movement")) {
+        if (*movement == "static") config.movement = Movement::Static;
+        else if (*movement == "circle") config.movement = Movement::Circle;
+        else if (*movement == "line") config.movement = Movement::Line;
+        else if (*movement == "wander") config.movement = Movement::Wander;
+        else log::warn("Invalid value for globed-crowd-movement: {}", *movement);
+    }
+
+    if (auto variety = crowdArg("icons")) {
+        config.iconVariety = *variety != "default";
+    }
+
+    config.tps = std::clamp(config.tps, 1, 240);
+    config.loss = std::clamp(config.loss, 0.f, 1.f);
+    config.speakers = std::min(config.speakers, config.players);
+
+    return config;
+}
+
+SyntheticCrowdModule::SyntheticCrowdModule(GlobedGJBGL* gameLayer)
+    : BaseGameplayModule(gameLayer), config(Config::fromLaunchArgs()), nextAccountId(FIRST_ACCOUNT_ID) {}
+
+SyntheticCrowdModule::~SyntheticCrowdModule() {
+    thread.stopAndWait();
+}
+
+void SyntheticCrowdModule::setupPacketListeners() {
+    origin = gameLayer->m_player1->getPosition();
+
+    log::info(
+        "Starting a synthetic crowd: {} players, {} speaking, {} tps, churn {}/s, jitter {}s, loss {}",
+        config.players, config.speakers, config.tps, config.churn, config.jitter, config.loss
+    );
+
+    thread.setStartFunction([] { geode::utils::thread::setName("Synthetic Crowd Thread"); });
+    thread.setLoopFunction(&SyntheticCrowdModule::threadFunc);
+    thread.start(this);
+}
+
+void SyntheticCrowdModule::onQuit() {
+    TRACE("[SyntheticCrowd] waiting for thread to stop");
+    thread.stopAndWait();
+}
+
+void SyntheticCrowdModule::threadFunc(decltype(thread)::StopToken&) {
+    auto& nm = NetworkManager::get();
+
+    std::vector<PlayerAccountData> joined;
+
+    // first iteration, everyone joins at once like when joining a populated level
+    if (players.empty()) {
+        startedAt = Instant::now();
+        lastTick = startedAt;
+
+        for (size_t i = 0; i < config.players; i++) {
+            players.push_back(this->makePlayer());
+            joined.push_back(this->makeAccountData(players.back()));
+        }
+
+        for (size_t i = 0; i < config.speakers; i++) {
+            players[i].speaking = true;
+        }
+    }
+
+    float dt = lastTick.elapsed().seconds<float>();
+    float time = startedAt.elapsed().seconds<float>();
+    lastTick = Instant::now();
+
+    this->churnPlayers(dt, joined);
+
+    if (!joined.empty()) {
+        auto packet = std::make_shared<PlayerProfilesPacket>();
+        packet->players = std::move(joined);
+        nm.injectPacket(std::move(packet));
+    }
+
+    // the positions keep advancing even when the packet is lost, just like they would on a real client
+    auto packet = std::make_shared<LevelDataPacket>();
+    packet->players.reserve(players.size());
+
+    for (auto& player : players) {
+        packet->players.emplace_back(player.accountId, this->makePlayerData(player, time, dt));
+    }
+
+    if (!this->chance(config.loss)) {
+        nm.injectPacket(std::move(packet));
+    }
+
+    this->sendVoice(dt);
+
+    float interval = 1.f / config.tps;
+    if (config.jitter > 0.f) {
+        interval = std::max(0.f, interval + this->random(-config.jitter, config.jitter));
+    }
+
+    std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(interval * 1'000'000.f)));
+}
+
+SyntheticCrowdModule::FakePlayer SyntheticCrowdModule::makePlayer() {
+    PlayerIconType iconType = PlayerIconType::Cube;
+    if (config.iconVariety) {
+        iconType = static_cast<PlayerIconType>(std::uniform_int_distribution<int>(1, 9)(rng));
+    }
+
+    return FakePlayer {
+        .accountId = nextAccountId++,
+        .phase = this->random(0.f, 2.f * M_PI),
+        .position = origin + CCPoint{this->random(-SPREAD, SPREAD), this->random(-SPREAD, SPREAD)},
+        .velocity = CCPoint{this->random(-100.f, 100.f), this->random(-100.f, 100.f)},
+        .iconType = iconType,
+        .speaking = false,
+    };
+}
+
+PlayerAccountData SyntheticCrowdModule::makeAccountData(const FakePlayer& player) {
+    PlayerIconData icons = PlayerIconData::DEFAULT_ICONS;
+
+    if (config.iconVariety) {
+        auto pick = [this](int max) {
+            return static_cast<int16_t>(std::uniform_int_distribution<int>(1, max)(rng));
+        };
+
+        auto color = [this] {
+            return static_cast<uint8_t>(std::uniform_int_distribution<int>(0, 106)(rng));
+        };
+
+        icons = PlayerIconData(
+            pick(485), pick(169), pick(118), pick(149), pick(96), pick(68), pick(69), pick(43), pick(8),
+            static_cast<uint8_t>(pick(20)), color(), color(), this->chance(0.5f) ? color() : NO_GLOW, static_cast<uint8_t>(pick(7)), static_cast<uint8_t>(pick(6))
+        );
+    }
+
+    return PlayerAccountData(player.accountId, player.accountId, fmt::format("Crowd{}", player.accountId - FIRST_ACCOUNT_ID), icons);
+}
+
+PlayerData SyntheticCrowdModule::makePlayerData(FakePlayer& player, float time, float dt) {
+    CCPoint pos;
+    float rotation = 0.f;
+
+    switch (config.movement) {
+        case Movement::Static: {
+            pos = player.position;
+        } break;
+
+        case Movement::Circle: {
+            float radius = SPREAD * (0.4f + 0.6f * std::fmod(player.phase, 1.f));
+            float angle = time * 1.5f + player.phase;
+            pos = origin + CCPoint{std::cos(angle) * radius, std::sin(angle) * radius};
+            rotation = -angle * 180.f / M_PI;
+        } break;
+
+        case Movement::Line: {
+            float x = std::fmod(time * LINE_SPEED + player.phase * 100.f, LINE_LENGTH);
+            pos = origin + CCPoint{x, std::sin(time * 3.f + player.phase) * 60.f};
+            rotation = std::fmod(time * 360.f, 360.f);
+        } break;
+
+        case Movement::Wander: {
+            player.velocity += CCPoint{this->random(-400.f, 400.f), this->random(-400.f, 400.f)} * dt;
+            player.velocity.x = std::clamp(player.velocity.x, -300.f, 300.f);
+            player.velocity.y = std::clamp(player.velocity.y, -300.f, 300.f);
+            player.position += player.velocity * dt;
+
+            // keep them near the spawn
+            if (std::abs(player.position.x - origin.x) > SPREAD * 3.f) player.velocity.x *= -1.f;
+            if (std::abs(player.position.y - origin.y) > SPREAD * 3.f) player.velocity.y *= -1.f;
+
+            pos = player.position;
+        } break;
+    }
+
+    SpecificIconData icon {
+        .position = pos,
+        .rotation = rotation,
+        .iconType = player.iconType,
+        .isVisible = true,
+        .isLookingLeft = false,
+        .isUpsideDown = false,
+        .isDashing = false,
+        .isMini = false,
+        .isGrounded = config.movement == Movement::Static,
+        .isStationary = config.movement == Movement::Static,
+        .isFalling = false,
+        .didJustJump = false,
+        .isRotating = config.movement != Movement::Static,
+        .isSideways = false,
+        .spiderTeleportData = std::nullopt,
+    };
+
+    return PlayerData {
+        .timestamp = time,
+        .player1 = icon,
+        .player2 = icon,
+        .deathCounter = 0.f,
+        .currentPercentage = 0.f,
+        .isDead = false,
+        .isPaused = false,
+        .isPracticing = false,
+        .isDualMode = false,
+        .isInEditor = false,
+        .isEditorBuilding = false,
+        .isLastDeathReal = false,
+    };
+}
+
+void SyntheticCrowdModule::churnPlayers(float dt, std::vector<PlayerAccountData>& joined) {
+    if (config.churn <= 0.f || players.empty()) return;
+
+    // a player leaves by simply not being in the next level data packet, and is replaced by a new one with a new account ID
+    if (!this->chance(config.churn * dt)) return;
+
+    size_t idx = std::uniform_int_distribution<size_t>(0, players.size() - 1)(rng);
+    bool speaking = players[idx].speaking;
+
+    players[idx] = this->makePlayer();
+    players[idx].speaking = speaking;
+    joined.push_back(this->makeAccountData(players[idx]));
+}
+
+void SyntheticCrowdModule::sendVoice(float dt) {
+#ifdef GLOBED_VOICE_SUPPORT
+    if (config.speakers == 0) return;
+
+    // a real client sends a frame once it has recorded enough opus frames for it
+    constexpr float FRAME_INTERVAL = EncodedAudioFrame::LIMIT_REGULAR * VOICE_CHUNK_RECORD_TIME;
+
+    if (voiceTemplate.empty()) {
+        // a quiet tone, encoded once and copied for every frame
+        AudioEncoder encoder(VOICE_TARGET_SAMPLERATE, VOICE_TARGET_FRAMESIZE);
+        std::vector<float> pcm(VOICE_TARGET_FRAMESIZE);
+
+        for (size_t frame = 0; frame < EncodedAudioFrame::LIMIT_REGULAR; frame++) {
+            for (size_t i = 0; i < pcm.size(); i++) {
+                float t = static_cast<float>(frame * pcm.size() + i) / VOICE_TARGET_SAMPLERATE;
+                pcm[i] = std::sin(t * 220.f * 2.f * M_PI) * 0.1f;
+            }
+
+            auto res = encoder.encode(pcm.data());
+            if (!res) {
+                log::warn("Synthetic crowd failed to encode voice, disabling it: {}", res.unwrapErr());
+                config.speakers = 0;
+                return;
+            }
+
+            auto opus = res.unwrap();
+            voiceTemplate.emplace_back(opus.ptr, opus.ptr + opus.length);
+            AudioEncoder::freeData(opus);
+        }
+    }
+
+    auto& nm = NetworkManager::get();
+
+    for (auto& player : players) {
+        if (!player.speaking) continue;
+
+        player.sinceVoice += dt;
+        if (player.sinceVoice < FRAME_INTERVAL) continue;
+        player.sinceVoice -= FRAME_INTERVAL;
+
+        auto packet = std::make_shared<VoiceBroadcastPacket>();
+        packet->sender = player.accountId;
+
+        for (auto& data : voiceTemplate) {
+            EncodedOpusData opus;
+            opus.length = data.size();
+            opus.ptr = new util::data::byte[data.size()];
+            std::copy(data.begin(), data.end(), opus.ptr);
+
+            (void) packet->frame.pushOpusFrame(opus);
+        }
+
+        nm.injectPacket(std::move(packet));
+    }
+#endif // GLOBED_VOICE_SUPPORT
+}
+
+float SyntheticCrowdModule::random(float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(rng);
+}
+
+bool SyntheticCrowdModule::chance(float ratio) {
+    if (ratio <= 0.f) return false;
+
+    return std::uniform_real_distribution<float>(0.f, 1.f)(rng) < ratio;
+}
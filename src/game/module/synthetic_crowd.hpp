@@ -0,0 +1,80 @@
+#pragma once
+
+#include "base.hpp"
+#include <defs/platform.hpp>
+#include <data/types/gd.hpp>
+
+#include <asp/thread/Thread.hpp>
+#include <asp/time/Instant.hpp>
+
+#include <random>
+
+// Simulates a level full of players for load testing, without needing them to actually exist.
+// Level data, profiles and voice are generated on a separate thread and injected as if they came from the server,
+// so everything from the packet listeners onwards runs exactly like it would with real players.
+// Enabled with the --globed-synthetic-crowd launch argument (see docs/launch-args.md for the options).
+class GLOBED_DLL SyntheticCrowdModule : public BaseGameplayModule {
+public:
+    enum class Movement {
+        Static,     // standing still at a random spot around the spawn point
+        Circle,     // circling around the spawn point
+        Line,       // moving right like in a classic level, wrapping around
+        Wander,     // random walk
+    };
+
+    struct Config {
+        size_t players = 50;
+        Movement movement = Movement::Circle;
+        bool iconVariety = true;
+        float churn = 0.f;  // players leaving (and being replaced by new ones) per second
+        float jitter = 0.f; // max random deviation of the send interval, in seconds
+        float loss = 0.f;   // chance of a level data packet getting dropped, 0 to 1
+        size_t speakers = 0; // how many of the players are sending voice
+        int tps = 30;
+
+        static Config fromLaunchArgs();
+    };
+
+    SyntheticCrowdModule(GlobedGJBGL* gameLayer);
+    ~SyntheticCrowdModule() override;
+
+    void setupPacketListeners() override;
+    void onQuit() override;
+
+private:
+    struct FakePlayer {
+        int accountId;
+        float phase;
+        cocos2d::CCPoint position;
+        cocos2d::CCPoint velocity;
+        PlayerIconType iconType;
+        bool speaking;
+        float sinceVoice = 0.f;
+    };
+
+    Config config;
+    cocos2d::CCPoint origin;
+
+    // everything below is only touched by the generator thread once it's started
+    asp::Thread<SyntheticCrowdModule*> thread;
+    std::mt19937_64 rng{0x676c6f626564}; // fixed seed so runs are comparable
+    std::vector<FakePlayer> players;
+    int nextAccountId;
+    asp::time::Instant startedAt = asp::time::Instant::now();
+    asp::time::Instant lastTick = asp::time::Instant::now();
+
+#ifdef GLOBED_VOICE_SUPPORT
+    std::vector<util::data::bytevector> voiceTemplate;
+#endif
+
+    void threadFunc(decltype(thread)::StopToken&);
+
+    FakePlayer makePlayer();
+    PlayerAccountData makeAccountData(const FakePlayer& player);
+    PlayerData makePlayerData(FakePlayer& player, float time, float dt);
+    void churnPlayers(float dt, std::vector<PlayerAccountData>& joined);
+    void sendVoice(float dt);
+
+    float random(float min, float max);
+    bool chance(float ratio);
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "spatial_grid.hpp"
+
+// Broadphase of CollisionModule. Remote players are put into a grid once per frame,
+// and every physics step of a local player only looks at the ones in the cells around it.
+// Doesn't touch any game objects itself, so that it can be benchmarked outside of the game (see bench/src/collision.cpp).
+template <typename T>
+class PlayerCollisions {
+public:
+    // Removes every player, call once per frame before inserting them again
+    void clear() {
+        grid.clear();
+    }
+
+    void insert(const T& player, const cocos2d::CCRect& rect) {
+        grid.insert(player, rect);
+    }
+
+    // Calls `fn(player, rect)` for every remote player that the local player is touching.
+    // `rectOf(player)` and `localRect()` return the current hitboxes, a collision that was already handled may have moved the local player.
+    template <typename RectOf, typename LocalRect, typename F>
+    void forEachCollision(const cocos2d::CCRect& queryRect, RectOf&& rectOf, LocalRect&& localRect, F&& fn) {
+        grid.query(queryRect, [&](const T& player, const cocos2d::CCRect&) {
+            const cocos2d::CCRect& rect = rectOf(player);
+
+            if (localRect().intersectsRect(rect)) {
+                fn(player, rect);
+            }
+        });
+    }
+
+    size_t size() const {
+        return grid.size();
+    }
+
+private:
+    SpatialGrid<T> grid;
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <defs/geode.hpp>
+
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+// Uniform grid used as a broadphase for player collisions, meant to be cleared and refilled every frame.
+// Queries return every item that shares at least one cell with the query rect, the caller still has to do the actual intersection test.
+template <typename T>
+class SpatialGrid {
+public:
+    // roughly 3 blocks, a player (even a big one) rarely spans more than 4 cells
+    static constexpr float DEFAULT_CELL_SIZE = 90.f;
+
+    SpatialGrid(float cellSize = DEFAULT_CELL_SIZE) : cellSize(cellSize) {}
+
+    void clear() {
+        items.clear();
+
+        // players spread out over a level leave a lot of empty cells behind, don't let those pile up forever
+        if (cells.size() > MAX_RETAINED_CELLS) {
+            cells.clear();
+            return;
+        }
+
+        // otherwise keep the vectors around so they don't have to be reallocated every frame
+        for (auto& [_, cell] : cells) {
+            cell.clear();
+        }
+    }
+
+    void insert(const T& value, const cocos2d::CCRect& rect) {
+        if (!isValidRect(rect)) return;
+
+        uint32_t idx = items.size();
+        items.push_back(Item {
+            .value = value,
+            .rect = rect,
+        });
+
+        this->forEachCell(rect, [&](uint64_t key) {
+            cells[key].push_back(idx);
+        });
+    }
+
+    // Calls `fn(value, rect)` exactly once for every item that may intersect `rect`.
+    template <typename F>
+    void query(const cocos2d::CCRect& rect, F&& fn) {
+        if (!isValidRect(rect) || items.empty()) return;
+
+        // stamps are used instead of a set to skip items that span multiple cells
+        currentStamp++;
+
+        this->forEachCell(rect, [&](uint64_t key) {
+            auto it = cells.find(key);
+            if (it == cells.end()) return;
+
+            for (uint32_t idx : it->second) {
+                auto& item = items[idx];
+                if (item.stamp == currentStamp) continue;
+
+                item.stamp = currentStamp;
+                fn(item.value, item.rect);
+            }
+        });
+    }
+
+    size_t size() const {
+        return items.size();
+    }
+
+    bool empty() const {
+        return items.empty();
+    }
+
+private:
+    static constexpr size_t MAX_RETAINED_CELLS = 4096;
+    // anything bigger than this is not a player, walking all of its cells would be a waste of time
+    static constexpr int MAX_CELL_SPAN = 16;
+
+    struct Item {
+        T value;
+        cocos2d::CCRect rect;
+        uint32_t stamp = 0;
+    };
+
+    float cellSize;
+    uint32_t currentStamp = 0;
+    std::vector<Item> items;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+
+    static bool isValidRect(const cocos2d::CCRect& rect) {
+        return std::isfinite(rect.origin.x) && std::isfinite(rect.origin.y)
+            && std::isfinite(rect.size.width) && std::isfinite(rect.size.height);
+    }
+
+    static uint64_t cellKey(int32_t x, int32_t y) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+
+    int32_t cellCoord(float pos) const {
+        return static_cast<int32_t>(std::floor(pos / cellSize));
+    }
+
+    template <typename F>
+    void forEachCell(const cocos2d::CCRect& rect, F&& fn) const {
+        int32_t minX = this->cellCoord(rect.getMinX());
+        int32_t minY = this->cellCoord(rect.getMinY());
+        int32_t maxX = std::min(this->cellCoord(rect.getMaxX()), minX + MAX_CELL_SPAN);
+        int32_t maxY = std::min(this->cellCoord(rect.getMaxY()), minY + MAX_CELL_SPAN);
+
+        for (int32_t x = minX; x <= maxX; x++) {
+            for (int32_t y = minY; y <= maxY; y++) {
+                fn(cellKey(x, y));
+            }
+        }
+    }
+};
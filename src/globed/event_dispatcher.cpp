@@ -6,6 +6,7 @@
 #include <managers/game_server.hpp>
 #include <managers/settings.hpp>
 #include <net/manager.hpp>
+#include <net/packet_stats.hpp>
 #include <ui/game/player/complex_visual_player.hpp>
 #include <ui/game/player/remote_player.hpp>
 
@@ -251,6 +252,35 @@ $on_mod(Loaded) {
         return Ok(NetworkManager::get().reconnecting());
     });
 
+    listen<Type::PacketStats, std::vector<globed::net::PacketStats>>([] {
+        std::vector<globed::net::PacketStats> out;
+
+        for (auto& snap : PacketStats::get().snapshot()) {
+            out.push_back(globed::net::PacketStats {
+                .packetId = snap.id,
+                .name = snap.name ? snap.name : "",
+                .packetsIn = snap.packetsIn,
+                .packetsOut = snap.packetsOut,
+                .bytesIn = snap.bytesIn,
+                .bytesOut = snap.bytesOut,
+                .encrypted = snap.encrypted,
+                .cleartext = snap.cleartext,
+                .fragmented = snap.fragmented,
+                .whole = snap.whole,
+                .packetsIn1s = snap.packetsIn1s,
+                .packetsOut1s = snap.packetsOut1s,
+                .packetsIn10s = snap.packetsIn10s,
+                .packetsOut10s = snap.packetsOut10s,
+                .bytesIn1s = snap.bytesIn1s,
+                .bytesOut1s = snap.bytesOut1s,
+                .bytesIn10s = snap.bytesIn10s,
+                .bytesOut10s = snap.bytesOut10s,
+            });
+        }
+
+        return Ok(std::move(out));
+    });
+
     // Admin
 
     listen<Type::IsMod, bool>([] {
@@ -0,0 +1,99 @@
+#include "profiler.hpp"
+
+#include <defs/geode.hpp>
+
+#include <util/per_thread_ring.hpp>
+
+#include <chrono>
+#include <fstream>
+
+using namespace geode::prelude;
+
+namespace globed::profiler {
+    std::atomic_bool _enabled = false;
+
+    namespace {
+        struct Event {
+            const char* name;
+            uint64_t start;
+            uint64_t end;
+        };
+
+        // 16384 events, roughly 400 KB per thread, is a few seconds of the busiest threads
+        constexpr size_t BUFFER_CAPACITY = 1 << 14;
+
+        const auto epoch = std::chrono::steady_clock::now();
+
+        util::collections::PerThreadRing<Event, BUFFER_CAPACITY> events;
+
+        std::string escapeJson(std::string_view str) {
+            std::string out;
+            out.reserve(str.size());
+
+            for (char c : str) {
+                if (c == '"' || c == '\\') {
+                    out.push_back('\\');
+                    out.push_back(c);
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    out += fmt::format("\\u{:04x}", c);
+                } else {
+                    out.push_back(c);
+                }
+            }
+
+            return out;
+        }
+    }
+
+    uint64_t _now() {
+        // + 1 so that 0 can be used for "not recording"
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count() + 1;
+    }
+
+    void _record(const char* name, uint64_t start, uint64_t end) {
+        events.push(Event { name, start, end });
+    }
+
+    void setEnabled(bool state) {
+        _enabled.store(state, std::memory_order::relaxed);
+    }
+
+    Result<> exportChromeTrace(const std::filesystem::path& path) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            return Err(fmt::format("failed to open {}", path));
+        }
+
+        file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        bool first = true;
+
+        auto separator = [&] {
+            if (!first) file << ",\n";
+            first = false;
+        };
+
+        for (auto& thread : events.snapshot()) {
+            separator();
+            file << fmt::format(
+                R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})",
+                thread.threadId, escapeJson(thread.threadName)
+            );
+
+            for (auto& event : thread.entries) {
+                separator();
+                file << fmt::format(
+                    R"({{"name":"{}","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                    escapeJson(event.name), thread.threadId, event.start / 1000.0, (event.end - event.start) / 1000.0
+                );
+            }
+        }
+
+        file << "\n]}\n";
+
+        if (!file) {
+            return Err(fmt::format("failed to write to {}", path));
+        }
+
+        return Ok();
+    }
+}
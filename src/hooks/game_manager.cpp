@@ -131,6 +131,14 @@ CCTexture2D* HookedGameManager::getCachedIcon(int iconId, int iconType) {
     return nullptr;
 }
 
+void HookedGameManager::evictIcon(int iconId, int iconType) {
+    // the texture is still referenced by the cache at this point, so it stays alive until the game is done with it.
+    // the game keeps a load count per icon, the frames are only removed if nothing else has the icon loaded
+    GameManager::unloadIcon(iconId, iconType, -1);
+
+    fields()->iconCache[iconType].erase(iconId);
+}
+
 bool HookedGameManager::getAssetsPreloaded() {
     return fields()->assetsPreloaded;
 }
@@ -55,6 +55,10 @@ struct GLOBED_DLL HookedGameManager : geode::Modify<HookedGameManager, GameManag
 
     cocos2d::CCTexture2D* getCachedIcon(int iconId, int iconType);
 
+    // Unloads an icon through the original `unloadIcon` and forgets the cached texture,
+    // so that the next `loadIcon` loads it again instead of returning a texture without sprite frames
+    void evictIcon(int iconId, int iconType);
+
     void setLastSceneEnum(int n = -1);
 
     Fields* fields();
@@ -7,17 +7,20 @@
 #include <audio/all.hpp>
 #include <managers/block_list.hpp>
 #include <managers/error_queues.hpp>
+#include <managers/frame_scheduler.hpp>
 #include <managers/friend_list.hpp>
 #include <managers/profile_cache.hpp>
 #include <managers/game_server.hpp>
 #include <managers/settings.hpp>
 #include <managers/popup.hpp>
 #include <managers/room.hpp>
+#include <net/packet_stats.hpp>
 #include <data/packets/client/game.hpp>
 #include <data/packets/client/general.hpp>
 #include <data/packets/server/game.hpp>
 #include <game/module/all.hpp>
 #include <game/camera_state.hpp>
+#include <globed/profiler.hpp>
 #include <hooks/game_manager.hpp>
 #include <hooks/triggers/gjeffectmanager.hpp>
 #include <ui/menu/settings/settings_layer.hpp>
@@ -37,6 +40,14 @@ using namespace asp::time;
 // how many units before the voice disappears
 constexpr float PROXIMITY_VOICE_LIMIT = 1200.f;
 
+// how long to wait for a reply to the first batched profile request before assuming the server doesn't support it
+constexpr float PROFILE_BATCH_TIMEOUT = 5.f;
+
+// how long since the last voice frame until a player is no longer considered speaking
+constexpr float VOICE_STREAM_IDLE_TIME = 0.5f;
+// score bonus for streams that are already being decoded, prevents them from flapping
+constexpr float VOICE_STREAM_HYSTERESIS = 0.15f;
+
 constexpr float VOICE_OVERLAY_PAD_X = 5.f;
 constexpr float VOICE_OVERLAY_PAD_Y = 20.f;
 
@@ -83,6 +94,11 @@ GlobedGJBGL* GlobedGJBGL::get() {
     return static_cast<GlobedGJBGL*>(globed::cachedSingleton<GameManager>()->m_gameLayer);
 }
 
+// defined here rather than next to the interpolator, so that the interpolator itself does not depend on the game layer
+float GameLayerClock::now() {
+    return GlobedGJBGL::get()->m_fields->timeCounter;
+}
+
 /* Setup */
 
 // Runs before PlayLayer::init
@@ -158,6 +174,11 @@ void GlobedGJBGL::setupPreInit(GJGameLevel* level, bool editor) {
             this->addModule<DeathlinkModule>();
         }
 
+        // fake players for load testing
+        if (settings.launchArgs().syntheticCrowd) {
+            this->addModule<SyntheticCrowdModule>();
+        }
+
         GLOBED_EVENT(this, setupPreInit(level));
     }
 }
@@ -297,10 +318,30 @@ void GlobedGJBGL::setupAudio() {
 void GlobedGJBGL::setupPacketListeners() {
     auto& nm = NetworkManager::get();
 
-    nm.addListener<PlayerProfilesPacket>(this, [](std::shared_ptr<PlayerProfilesPacket> packet) {
+    nm.addListener<PlayerProfilesPacket>(this, [this](std::shared_ptr<PlayerProfilesPacket> packet) {
+        auto& fields = this->getFields();
+
+        if (fields.fullProfileRequestSentAt >= 0.f) {
+            // batches are held back until this arrives, so it can't be a reply to one
+            fields.fullProfileRequestSentAt = -1.f;
+        } else if (!fields.profileBatchConfirmed && !fields.profileBatchAwaiting.empty() && !packet->players.empty()) {
+            // a batch reply has only the requested players, anything else is a reply to some other request
+            bool isBatchReply = std::all_of(packet->players.begin(), packet->players.end(), [&](auto& player) {
+                return fields.profileBatchAwaiting.contains(player.accountId);
+            });
+
+            if (isBatchReply) {
+                fields.profileBatchConfirmed = true;
+                fields.profileBatchAwaiting.clear();
+            }
+        }
+
         auto& pcm = ProfileCacheManager::get();
         for (auto& player : packet->players) {
             pcm.insert(player);
+
+            // no need to ask for it again
+            fields.queuedProfileRequests.erase(player.accountId);
         }
     });
 
@@ -360,7 +401,20 @@ void GlobedGJBGL::setupPacketListeners() {
         if (this->m_fields->deafened || !settings.communication.voiceEnabled) return;
         if (!this->shouldLetMessageThrough(packet->sender)) return;
 
+        auto& fields = this->getFields();
         auto& vpm = VoicePlaybackManager::get();
+
+        fields.lastVoiceFrame[packet->sender] = fields.timeCounter;
+
+        // if there are too many speakers, don't decode the ones that didn't make the cut
+        size_t maxStreams = settings.communication.maxVoiceStreams;
+        if (maxStreams > 0 && !fields.activeVoiceStreams.contains(packet->sender)) {
+            if (fields.activeVoiceStreams.size() >= maxStreams) return;
+
+            fields.activeVoiceStreams.insert(packet->sender);
+            vpm.resumeStream(packet->sender);
+        }
+
         try {
             vpm.prepareStream(packet->sender);
 
@@ -417,12 +471,12 @@ void GlobedGJBGL::setupMisc() {
 
     // set the configured tps
     fields.configuredTps = nm.getServerTps();
+    fields.sendRate.reset(fields.configuredTps);
 
     // interpolator
     fields.interpolator = std::make_unique<PlayerInterpolator>(InterpolatorSettings {
         .realtime = false,
         .isPlatformer = m_level->isPlatformer(),
-        .expectedDelta = (1.0f / fields.configuredTps)
     });
 
     // player store
@@ -498,33 +552,47 @@ void GlobedGJBGL::setupUi() {
     fields.selfProgressIcon->updateIcons(pcm.getOwnData());
     fields.selfProgressIcon->setForceOnTop(true);
 
+    // every name label and status icon is drawn through the batches in this layer
+    Build<PlayerLabelLayer>::create()
+        .zOrder(11)
+        .parent(m_objectLayer)
+        .id("player-labels"_spr)
+        .store(fields.labelLayer);
+
+    fields.playerPool = std::make_unique<RemotePlayerPool>(m_objectLayer, &fields.camState);
+
     // status icons
     if (settings.players.statusIcons) {
-        Build<PlayerStatusIcons>::create(255)
+        Build<PlayerStatusIcons>::create(fields.labelLayer, 255)
             .scale(0.8f)
-            .anchorPoint(0.5f, 0.f)
             .pos(0.f, 25.f)
-            .parent(m_objectLayer)
             .id("self-status-icon"_spr)
             .store(fields.selfStatusIcons);
     }
 
+    // players far away from the camera are drawn as sprites in this batch node, see ComplexVisualPlayer::detailLevelFor
+    if (auto* frame = CCSpriteFrameCache::get()->spriteFrameByName("white-period.png"_spr)) {
+        Build(CCSpriteBatchNode::createWithTexture(frame->getTexture()))
+            .zOrder(10)
+            .parent(m_objectLayer)
+            .id("simplified-players"_spr)
+            .store(fields.simplifiedPlayerBatch);
+    }
+
     // own name
     if (settings.players.showNames && settings.players.ownName) {
         auto ownData = pcm.getOwnAccountData();
         auto ownSpecial = pcm.getOwnSpecialData();
 
-        Build<GlobedNameLabel>::create(ownData.name, ownSpecial)
-            .parent(m_objectLayer)
+        Build<BatchedNameLabel>::create(fields.labelLayer, ownData.name, ownSpecial)
             .id("self-name"_spr)
             .store(fields.ownNameLabel);
 
         fields.ownNameLabel->updateOpacity(settings.players.nameOpacity);
 
         if (settings.players.dualName) {
-            Build<GlobedNameLabel>::create(ownData.name, ownSpecial)
+            Build<BatchedNameLabel>::create(fields.labelLayer, ownData.name, ownSpecial)
                 .visible(false)
-                .parent(m_objectLayer)
                 .id("self-name-p2"_spr)
                 .store(fields.ownNameLabel2);
 
@@ -551,6 +619,7 @@ void GlobedGJBGL::postInitActions(float) {
     if (fields.globedReady) {
         auto& nm = NetworkManager::get();
         nm.send(RequestPlayerProfilesPacket::create(0));
+        fields.fullProfileRequestSentAt = fields.timeCounter;
 
         fields.shouldRequestMeta = true;
     }
@@ -560,7 +629,7 @@ void GlobedGJBGL::postInitActions(float) {
 
 /* Selectors */
 
-// selSendPlayerData - runs tps (default 30) times per second
+// selSendPlayerData - runs up to tps (default 30) times per second, depending on the connection
 void GlobedGJBGL::selSendPlayerData(float) {
 #define this GLOBED_INVALID_THIS
 
@@ -571,13 +640,14 @@ void GlobedGJBGL::selSendPlayerData(float) {
 
     // if (!self->isCurrentPlayLayer()) return;
     // TODO: idk remove this?
-    if (!self->accountForSpeedhack(0, 1.0f / fields.configuredTps, 0.8f)) return;
+    if (!self->accountForSpeedhack(0, fields.sendRate.getInterval(), 0.8f)) return;
 
     fields.totalSentPackets++;
     // additionally, if there are no players on the level, we drop down to 1 time per second as an optimization
     // or if we are quitting the level
 
-    if ((fields.players.empty() && fields.totalSentPackets % 30 != 15 && fields.pendingCounterChanges.empty()) || fields.quitting) return;
+    uint32_t perSecond = std::max<uint32_t>(1, std::round(fields.sendRate.getRate()));
+    if ((fields.players.empty() && fields.totalSentPackets % perSecond != perSecond / 2 && fields.pendingCounterChanges.empty()) || fields.quitting) return;
 
     auto data = self->gatherPlayerData();
     std::optional<PlayerMetadata> meta;
@@ -616,7 +686,25 @@ void GlobedGJBGL::selPeriodicalUpdate(float dt) {
     // if (!self->isCurrentPlayLayer()) return;
 
     // update the overlay
-    fields.overlay->updatePing(GameServerManager::get().getActivePing());
+    int ping = GameServerManager::get().getActivePing();
+    fields.overlay->updatePing(ping);
+
+    // adapt how often player data is sent to the connection, the server sends level data back at the same rate
+    if (ping > 0) {
+        fields.sendRate.updateRtt(ping * 1000);
+    }
+
+    // counted at the socket, so coalesced player data and injected level data don't skew the loss
+    auto& stats = PacketStats::get();
+    fields.sendRate.updateCounts(
+        stats.total(PlayerDataPacket::PACKET_ID, PacketStats::Direction::Outgoing),
+        stats.total(LevelDataPacket::PACKET_ID, PacketStats::Direction::Incoming)
+    );
+
+    if (fields.sendRate.update()) {
+        float interval = fields.sendRate.getInterval();
+        self->customSchedule(schedule_selector(GlobedGJBGL::selSendPlayerData), interval * fields.lastKnownTimeScale);
+    }
 
     auto& pcm = ProfileCacheManager::get();
 
@@ -674,8 +762,6 @@ void GlobedGJBGL::selPeriodicalUpdate(float dt) {
             self->handlePlayerLeave(id);
         }
     } else {
-        util::collections::SmallVector<int, 8> ids;
-
         // kick players that have left the level
         for (const auto& [playerId, remotePlayer] : fields.players) {
             // if the player doesnt exist in last LevelData packet, they have left the level
@@ -686,10 +772,15 @@ void GlobedGJBGL::selPeriodicalUpdate(float dt) {
 
             auto data = pcm.getData(playerId);
 
+            // profiles restored from the disk cache are used right away, but refetched once
+            if (data && pcm.shouldRevalidate(playerId)) {
+                fields.queuedProfileRequests.insert(playerId);
+            }
+
             if (!remotePlayer->isValidPlayer()) {
-                if (data.has_value()) {
+                if (data) {
                     // if the profile data already exists in cache, use it
-                    remotePlayer->updateAccountData(data.value(), true);
+                    self->queueAccountUpdate(playerId);
                     continue;
                 }
 
@@ -699,34 +790,29 @@ void GlobedGJBGL::selPeriodicalUpdate(float dt) {
                 }
 
                 if (remotePlayer->getDefaultTicks() == 0) {
-                    if (ids.size() < ids.capacity()) {
-                        ids.push_back(playerId);
-                    }
+                    fields.queuedProfileRequests.insert(playerId);
                 }
 
                 remotePlayer->incDefaultTicks();
-            } else if (data.has_value()) {
-                // still try to see if the cache has changed
-                remotePlayer->updateAccountData(data.value());
+            } else if (data && !(remotePlayer->getAccountData() == *data)) {
+                // the cache has changed
+                self->queueAccountUpdate(playerId);
             }
         }
 
-        if (ids.size() > 5) {
-            NetworkManager::get().send(RequestPlayerProfilesPacket::create(0));
-        } else {
-            for (int id : ids) {
-                NetworkManager::get().send(RequestPlayerProfilesPacket::create(id));
-            }
-        }
+        self->flushProfileRequests();
 
         for (int id : toRemove) {
             self->handlePlayerLeave(id);
         }
     }
 
-    // update the ping to the server if overlay is enabled
-    if (GlobedSettings::get().overlay.enabled) {
-        NetworkManager::get().updateServerPing();
+    // update the ping to the server, used by the overlay and the send rate
+    NetworkManager::get().updateServerPing();
+
+    // spread out the creation of spare players, so that joins don't have to create them
+    if (fields.playerPool) {
+        fields.playerPool->prewarm();
     }
 
     GLOBED_EVENT(self, selPeriodicalUpdate(dt));
@@ -738,6 +824,8 @@ void GlobedGJBGL::selUpdate(float timescaledDt) {
     // we cannot use `this` inside this function!!!!
 #define this GLOBED_INVALID_THIS
 
+    GLOBED_PROFILE_ZONE("GlobedGJBGL::selUpdate");
+
     auto self = GlobedGJBGL::get();
 
     if (!self) return;
@@ -850,7 +938,7 @@ void GlobedGJBGL::selUpdate(float timescaledDt) {
             } else {
                 fields.ownNameLabel2->setVisible(true);
                 fields.ownNameLabel2->setPosition(self->m_player2->getPosition() + dirVec * CCPoint{25.f, 25.f});
-                fields.ownNameLabel->setRotation(dir);
+                fields.ownNameLabel2->setRotation(dir);
             }
         }
     }
@@ -873,8 +961,8 @@ void GlobedGJBGL::selUpdateEstimators(float dt) {
 
     auto* self = GlobedGJBGL::get();
 
-    // update volume estimators
-    VoicePlaybackManager::get().updateAllEstimators(dt);
+    // volume estimators are fed directly from the audio thread, so only the stream selection and the overlay need updating here
+    self->updateActiveVoiceStreams();
 
     if (auto overlay = self->m_fields->voiceOverlay) {
         overlay->updateOverlay();
@@ -1032,34 +1120,171 @@ bool GlobedGJBGL::shouldLetMessageThrough(int playerId) {
     return true;
 }
 
-void GlobedGJBGL::updateProximityVolume(int playerId) {
+void GlobedGJBGL::queueAccountUpdate(int playerId) {
     auto& fields = this->getFields();
 
-    if (fields.deafened || !fields.isVoiceProximity) return;
+    // the player is checked every 250ms, so without this the same update would keep piling up while the queue is busy
+    if (!fields.queuedAccountUpdates.insert(playerId).second) return;
 
-    auto& vpm = VoicePlaybackManager::get();
+    // re-skinning a player is expensive, so when a lot of profiles arrive at once it's spread out over multiple frames
+    FrameScheduler::get().queue(FrameScheduler::Priority::Normal, this, [this, playerId] {
+        auto& fields = this->getFields();
+        fields.queuedAccountUpdates.erase(playerId);
+
+        if (!fields.players.contains(playerId)) return;
+
+        // the newest profile by the time this runs, not the one from when it was queued
+        auto data = ProfileCacheManager::get().getData(playerId);
+        if (!data) return;
+
+        auto* rp = fields.players.at(playerId);
+        rp->updateAccountData(*data, !rp->isValidPlayer());
+    });
+}
+
+void GlobedGJBGL::flushProfileRequests() {
+    auto& fields = this->getFields();
+    auto& nm = NetworkManager::get();
+
+    auto& queued = fields.queuedProfileRequests;
+    if (queued.empty()) return;
+
+    // the reply to the full request likely has these players already, and a batch sent now couldn't be told apart from it
+    if (fields.fullProfileRequestSentAt >= 0.f) {
+        if (fields.timeCounter - fields.fullProfileRequestSentAt < PROFILE_BATCH_TIMEOUT) return;
+
+        fields.fullProfileRequestSentAt = -1.f;
+    }
 
-    if (!fields.interpolator->hasPlayer(playerId)) {
-        // if we have no knowledge on the player, set volume to 0
-        vpm.setVolume(playerId, 0.f);
+    // older servers silently ignore the batch packet, in that case go back to requesting profiles one by one
+    if (!fields.profileBatchConfirmed && !fields.profileBatchUnsupported && fields.profileBatchSentAt >= 0.f
+        && fields.timeCounter - fields.profileBatchSentAt > PROFILE_BATCH_TIMEOUT)
+    {
+        log::info("Server did not respond to a batched profile request, falling back to individual requests");
+        fields.profileBatchUnsupported = true;
+    }
+
+    if (fields.profileBatchUnsupported) {
+        if (queued.size() > 5) {
+            nm.send(RequestPlayerProfilesPacket::create(0));
+        } else {
+            for (int id : queued) {
+                nm.send(RequestPlayerProfilesPacket::create(id));
+            }
+        }
+
+        queued.clear();
         return;
     }
 
+    // anything over the limit stays queued until the next flush
+    std::vector<int> ids;
+    ids.reserve(std::min(queued.size(), RequestPlayerProfilesBatchPacket::MAX_REQUESTED));
+
+    for (auto it = queued.begin(); it != queued.end() && ids.size() < RequestPlayerProfilesBatchPacket::MAX_REQUESTED;) {
+        ids.push_back(*it);
+        it = queued.erase(it);
+    }
+
+    if (!fields.profileBatchConfirmed) {
+        fields.profileBatchAwaiting.insert(ids.begin(), ids.end());
+    }
+
+    nm.send(RequestPlayerProfilesBatchPacket::create(std::move(ids)));
+
+    if (fields.profileBatchSentAt < 0.f) {
+        fields.profileBatchSentAt = fields.timeCounter;
+    }
+}
+
+float GlobedGJBGL::getProximityVolume(int playerId) {
+    auto& fields = this->getFields();
+
+    if (!fields.isVoiceProximity) return 1.f;
+
+    // if we have no knowledge on the player, they are silent
+    if (!fields.interpolator->hasPlayer(playerId)) return 0.f;
+
     auto& vstate = fields.interpolator->getPlayerState(playerId);
+    if (vstate.isInEditor) return 1.f;
 
     float distance = cocos2d::ccpDistance(m_player1->getPosition(), vstate.player1.position);
-    float volume = 1.f - std::clamp(distance, 0.01f, PROXIMITY_VOICE_LIMIT) / PROXIMITY_VOICE_LIMIT;
-    if (vstate.isInEditor) {
-        volume = 1.f;
-    }
+    return 1.f - std::clamp(distance, 0.01f, PROXIMITY_VOICE_LIMIT) / PROXIMITY_VOICE_LIMIT;
+}
 
+void GlobedGJBGL::updateProximityVolume(int playerId) {
+    auto& fields = this->getFields();
+
+    if (fields.deafened || !fields.isVoiceProximity) return;
+
+    auto& vpm = VoicePlaybackManager::get();
     auto& settings = GlobedSettings::get();
 
-    if (this->shouldLetMessageThrough(playerId)) {
+    float volume = this->getProximityVolume(playerId);
+
+    if (volume == 0.f || this->shouldLetMessageThrough(playerId)) {
         vpm.setVolume(playerId, volume * settings.communication.voiceVolume);
     }
 }
 
+void GlobedGJBGL::updateActiveVoiceStreams() {
+    auto& fields = this->getFields();
+    auto& settings = GlobedSettings::get();
+    auto& vpm = VoicePlaybackManager::get();
+
+    size_t maxStreams = settings.communication.maxVoiceStreams;
+
+    // forget players that stopped talking
+    for (auto it = fields.lastVoiceFrame.begin(); it != fields.lastVoiceFrame.end();) {
+        if (fields.timeCounter - it->second > VOICE_STREAM_IDLE_TIME) {
+            fields.activeVoiceStreams.erase(it->first);
+            it = fields.lastVoiceFrame.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (maxStreams == 0) {
+        fields.activeVoiceStreams.clear();
+
+        vpm.resumeAll();
+
+        return;
+    }
+
+    // rank everyone that is talking by how close and how loud they are
+    std::vector<std::pair<int, float>> speakers;
+    speakers.reserve(fields.lastVoiceFrame.size());
+
+    for (const auto& [playerId, _] : fields.lastVoiceFrame) {
+        bool active = fields.activeVoiceStreams.contains(playerId);
+
+        float score = this->getProximityVolume(playerId) + std::min(vpm.getLoudness(playerId) * 2.f, 0.5f);
+        if (active) {
+            score += VOICE_STREAM_HYSTERESIS;
+        }
+
+        speakers.emplace_back(playerId, score);
+    }
+
+    std::sort(speakers.begin(), speakers.end(), [](const auto& a, const auto& b) {
+        return a.second > b.second;
+    });
+
+    fields.activeVoiceStreams.clear();
+
+    for (size_t i = 0; i < speakers.size(); i++) {
+        int playerId = speakers[i].first;
+
+        if (i < maxStreams) {
+            fields.activeVoiceStreams.insert(playerId);
+            vpm.resumeStream(playerId);
+        } else {
+            vpm.suspendStream(playerId);
+        }
+    }
+}
+
 void GlobedGJBGL::notifyDeath() {
     auto& fields = this->getFields();
 
@@ -1130,23 +1355,17 @@ void GlobedGJBGL::handlePlayerJoin(int playerId) {
         }
     }
 
-    auto* rp = Build<RemotePlayer>::create(&fields.camState, progressIcon, progressArrow)
-        .zOrder(10)
-        .id(util::cocos::spr(fmt::format("remote-player-{}", playerId)))
-        .collect();
-
     auto& pcm = ProfileCacheManager::get();
     auto pcmData = pcm.getData(playerId);
-    if (pcmData.has_value()) {
-        rp->updateAccountData(pcmData.value(), true);
-    }
+
+    auto* rp = fields.playerPool->acquire(pcmData ? *pcmData : PlayerAccountData::DEFAULT_DATA, progressIcon, progressArrow);
+    rp->setID(util::cocos::spr(fmt::format("remote-player-{}", playerId)));
 
     auto& bl = BlockListManager::get();
     if (bl.isHidden(playerId)) {
         rp->setForciblyHidden(true);
     }
 
-    m_objectLayer->addChild(rp);
     fields.players.emplace(playerId, rp);
     fields.interpolator->addPlayer(playerId);
 
@@ -1171,6 +1390,9 @@ void GlobedGJBGL::handlePlayerLeave(int playerId) {
 
     auto& fields = this->getFields();
 
+    fields.lastVoiceFrame.erase(playerId);
+    fields.activeVoiceStreams.erase(playerId);
+
     if (!fields.players.contains(playerId)) return;
 
     auto rp = fields.players.at(playerId);
@@ -1181,9 +1403,7 @@ void GlobedGJBGL::handlePlayerLeave(int playerId) {
 
     GLOBED_EVENT(this, onPlayerLeave(rp));
 
-    rp->removeProgressIndicators();
-    rp->cleanupObjectLayer();
-    rp->removeFromParent();
+    fields.playerPool->release(rp);
 
     fields.players.erase(playerId);
     fields.interpolator->removePlayer(playerId);
@@ -1261,6 +1481,14 @@ void GlobedGJBGL::onQuitActions() {
 #endif // GLOBED_VOICE_SUPPORT
 
         GLOBED_EVENT(this, onQuit());
+
+        if (m_fields->playerPool) {
+            auto& stats = m_fields->playerPool->getStats();
+            log::debug(
+                "Player pool: {} hits, {} misses, {} prewarmed, {} discarded",
+                stats.hits, stats.misses, stats.prewarmed, stats.discarded
+            );
+        }
     }
 }
 
@@ -1290,20 +1518,29 @@ void GlobedGJBGL::disableAndRevertModifications() {
 }
 
 void GlobedGJBGL::pausedUpdate(float dt) {
-    // unpause dash effects and death effects
-    for (auto* child : CCArrayExt<CCNode*>(m_objectLayer->getChildren())) {
-        int tag1 = ComplexVisualPlayer::SPIDER_DASH_CIRCLE_WAVE_TAG;
-        int tag2 = ComplexVisualPlayer::SPIDER_DASH_SPRITE_TAG;
-        int tag3 = ComplexVisualPlayer::DEATH_EFFECT_TAG;
+    auto& fields = this->getFields();
 
-        int ctag = child->getTag();
+    // unpause dash effects and death effects, the ones that already finished got removed from the object layer
+    std::erase_if(fields.effectNodes, [](const Ref<CCNode>& node) {
+        return node->getParent() == nullptr;
+    });
 
-        if (ctag == tag1 || ctag == tag2 || ctag == tag3) {
-            child->resumeSchedulerAndActions();
-        }
+    for (auto& node : fields.effectNodes) {
+        node->resumeSchedulerAndActions();
     }
 }
 
+void GlobedGJBGL::trackEffectNode(CCNode* node) {
+    auto& fields = this->getFields();
+
+    // pausedUpdate only runs while paused, so finished effects also have to be dropped here or they pile up for the whole level
+    std::erase_if(fields.effectNodes, [](const Ref<CCNode>& node) {
+        return node->getParent() == nullptr;
+    });
+
+    fields.effectNodes.push_back(node);
+}
+
 bool GlobedGJBGL::accountForSpeedhack(int uniqueKey, float cap, float allowance) {
     auto* sched = CCScheduler::get();
     auto& fields = this->getFields();
@@ -1357,7 +1594,7 @@ bool GlobedGJBGL::rescheduleSelectors() {
     float timescale = sched->getTimeScale();
     m_fields->lastKnownTimeScale = timescale;
 
-    float pdInterval = (1.0f / m_fields->configuredTps) * timescale;
+    float pdInterval = m_fields->sendRate.getInterval() * timescale;
     float pmdInterval = 10.f * timescale;
     float updpInterval = 0.25f * timescale;
     float updeInterval = (1.0f / 30.f) * timescale;
@@ -11,7 +11,10 @@
 #include <game/module/base.hpp>
 #include <managers/hook.hpp>
 #include <net/manager.hpp>
+#include <net/send_rate_controller.hpp>
+#include <ui/game/player/label_layer.hpp>
 #include <ui/game/player/remote_player.hpp>
+#include <ui/game/player/remote_player_pool.hpp>
 #include <ui/game/overlay/overlay.hpp>
 #include <ui/game/progress/progress_icon.hpp>
 #include <ui/game/progress/progress_arrow.hpp>
@@ -29,11 +32,14 @@ struct GLOBED_DLL GlobedGJBGL : geode::Modify<GlobedGJBGL, GJBaseGameLayer> {
         bool setupWasCompleted = false;
         bool isEditor = false;
         uint32_t configuredTps = 0;
+        SendRateController sendRate; // how often player data is actually sent, between a floor and configuredTps
         uint32_t initialPlayerCount = 0;
 
         // in game stuff
         bool deafened = false;
         bool isVoiceProximity = false;
+        std::unordered_map<int, float> lastVoiceFrame; // timeCounter of the last voice frame received from each player
+        std::unordered_set<int> activeVoiceStreams; // players that are allowed to be decoded, when maxVoiceStreams is set
         bool shownFragmentationAlert = false;
         uint32_t totalSentPackets = 0;
         float timeCounter = 0.f;
@@ -71,16 +77,29 @@ struct GLOBED_DLL GlobedGJBGL : geode::Modify<GlobedGJBGL, GJBaseGameLayer> {
         // ui elements
         GlobedOverlay* overlay = nullptr;
         std::unordered_map<int, RemotePlayer*> players;
+        std::unique_ptr<RemotePlayerPool> playerPool; // players that left, reused on the next join
+        std::vector<Ref<CCNode>> effectNodes; // death and spider dash effects of remote players, resumed while paused
         Ref<PlayerProgressIcon> selfProgressIcon = nullptr;
         Ref<CCNode> progressBarWrapper = nullptr;
+        Ref<PlayerLabelLayer> labelLayer = nullptr; // name labels and status icons of all players, including ours
         Ref<PlayerStatusIcons> selfStatusIcons = nullptr;
         Ref<GlobedVoiceOverlay> voiceOverlay = nullptr;
         //Ref<GlobedChatOverlay> chatOverlay = nullptr;
-        Ref<GlobedNameLabel> ownNameLabel = nullptr;
-        Ref<GlobedNameLabel> ownNameLabel2 = nullptr;
+        Ref<BatchedNameLabel> ownNameLabel = nullptr;
+        Ref<BatchedNameLabel> ownNameLabel2 = nullptr;
         Ref<cocos2d::CCSprite> noticeAlert = nullptr;
+        Ref<cocos2d::CCSpriteBatchNode> simplifiedPlayerBatch = nullptr; // sprites of players that are far from the camera
         bool showingNoticeAlert = false;
 
+        // profile requests, coalesced and sent in selPeriodicalUpdate
+        std::unordered_set<int> queuedProfileRequests;
+        float fullProfileRequestSentAt = -1.f; // the request for every profile on the level, no batches are sent until it's answered
+        std::unordered_set<int> profileBatchAwaiting; // players in batches that got no reply yet, until a batch is confirmed
+        float profileBatchSentAt = -1.f;
+        bool profileBatchConfirmed = false;
+        bool profileBatchUnsupported = false;
+        std::unordered_set<int> queuedAccountUpdates; // players that already have a re-skin waiting in FrameScheduler
+
         // speedhack detection
         float lastKnownTimeScale = 1.0f;
         std::unordered_map<int, asp::time::Instant> lastSentPacket;
@@ -140,7 +159,7 @@ struct GLOBED_DLL GlobedGJBGL : geode::Modify<GlobedGJBGL, GJBaseGameLayer> {
 
     /* selectors */
 
-    // selSendPlayerData - runs tps (default 30) times per second
+    // selSendPlayerData - runs up to tps (default 30) times per second, depending on the connection
     void selSendPlayerData(float);
 
     // selSendPlayerMetadata - runs every 5 seconds
@@ -152,7 +171,7 @@ struct GLOBED_DLL GlobedGJBGL : geode::Modify<GlobedGJBGL, GJBaseGameLayer> {
     // selUpdate - runs every frame, increments the non-decreasing time counter, interpolates and updates players
     void selUpdate(float dt);
 
-    // setlUpdateEstimators - runs 30 times a second, updates volume estimators
+    // selUpdateEstimators - runs 30 times a second, updates the voice overlay
     void selUpdateEstimators(float);
 
     /* player related functions */
@@ -165,7 +184,15 @@ struct GLOBED_DLL GlobedGJBGL : geode::Modify<GlobedGJBGL, GJBaseGameLayer> {
     float getCameraDirectionAngle();
 
     bool shouldLetMessageThrough(int playerId);
+    float getProximityVolume(int playerId);
     void updateProximityVolume(int playerId);
+    // picks which voice streams get decoded, if there are more speakers than `maxVoiceStreams`
+    void updateActiveVoiceStreams();
+
+    // sends all queued profile requests in as few packets as possible
+    void flushProfileRequests();
+    // re-skins the player with their cached profile on a later frame, at most once per player until it runs
+    void queueAccountUpdate(int playerId);
 
     void handlePlayerJoin(int playerId);
     void handlePlayerLeave(int playerId);
@@ -196,6 +223,8 @@ struct GLOBED_DLL GlobedGJBGL : geode::Modify<GlobedGJBGL, GJBaseGameLayer> {
 
     // runs every frame while paused
     void pausedUpdate(float dt);
+    // keeps an effect node of a remote player running while the game is paused
+    void trackEffectNode(cocos2d::CCNode* node);
 
     template <typename T> requires (std::is_base_of_v<BaseGameplayModule, T>)
     void addModule() {
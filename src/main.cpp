@@ -5,6 +5,9 @@
 #include <hooks/all.hpp>
 #include <audio/manager.hpp>
 #include <crypto/box.hpp>
+#include <globed/profiler.hpp>
+#include <managers/frame_scheduler.hpp>
+#include <managers/memory_report.hpp>
 #include <managers/settings.hpp>
 #include <ui/error_check_node.hpp>
 #include <ui/notification/panel.hpp>
@@ -44,6 +47,12 @@ $on_mod(Loaded) {
     setupAsp();
     setupErrorCheckNode();
 
+    // other threads queue work into the scheduler, but it has to be created on the main thread
+    FrameScheduler::get();
+    MemoryReporter::get();
+
+    globed::profiler::setEnabled(GlobedSettings::get().launchArgs().profiler);
+
 #ifdef GLOBED_VOICE_SUPPORT
     GlobedAudioManager::get().preInitialize();
 #endif
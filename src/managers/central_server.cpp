@@ -3,6 +3,7 @@
 #include <managers/error_queues.hpp>
 #include <managers/game_server.hpp>
 #include <managers/account.hpp>
+#include <managers/web.hpp>
 #include <net/manager.hpp>
 
 #include <matjson/reflect.hpp>
@@ -11,13 +12,6 @@
 
 #include <asp/fs.hpp>
 
-static std::string identForServer(const CentralServer& server) {
-    auto s = util::crypto::hexEncode(util::crypto::simpleHash(server.url));
-    s.resize(16);
-
-    return s;
-}
-
 CentralServerManager::CentralServerManager() {
     this->reload();
 
@@ -186,26 +180,16 @@ void CentralServerManager::switchRoutine(int index, bool force) {
     gam.autoInitialize();
 }
 
-void CentralServerManager::updateCacheForActive(const std::string& response) {
-    auto server = this->getActive();
-    if (!server) return;
-
-    auto ident = identForServer(*server);
-
-    auto key = fmt::format("_server-cache-{}", ident);
-    Mod::get()->setSavedValue(key, response);
-}
-
 Result<> CentralServerManager::initFromCache() {
     auto server = this->getActive();
     if (!server) return Err("no active server");
 
-    auto cachedResp = Mod::get()->getSavedValue<std::string>(fmt::format("_server-cache-{}", identForServer(*server)));
-    if (cachedResp.empty()) {
+    auto cachedResp = WebRequestManager::get().getCachedServerMeta();
+    if (!cachedResp) {
         return Err("no cache");
     }
 
-    auto resp = GEODE_UNWRAP(matjson::parseAs<MetaResponse>(cachedResp));
+    auto resp = GEODE_UNWRAP(cachedResp->json<MetaResponse>());
     this->initFromMeta(resp);
 
     return Ok();
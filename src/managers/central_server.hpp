@@ -64,7 +64,7 @@ public:
     // clear the active authtoken, reinitialize account manager, clear game servers, and switch to a central server by its ID
     void switchRoutine(int index, bool force = false);
 
-    void updateCacheForActive(const std::string& response);
+    // initializes from the last server meta response stored in the http cache
     Result<> initFromCache();
     void initFromMeta(const MetaResponse& resp);
 
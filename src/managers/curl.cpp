@@ -6,11 +6,18 @@
 #include <ca_bundle.h>
 
 #include <crypto/chacha_secret_box.hpp>
+#include <managers/http_cache.hpp>
 #include <managers/settings.hpp>
 #include <util/crypto.hpp>
 #include <util/format.hpp>
 #include <util/net.hpp>
 
+#include <charconv>
+#include <unordered_set>
+
+#include <asp/sync.hpp>
+#include <asp/thread.hpp>
+
 constexpr static auto KEY = "bff252d2731a6c6ca26d7f5144bc750fd6723316619f86c8636ebdc13bf3214c";
 static ChaChaSecretBox g_box(util::crypto::hexDecode(KEY).unwrap());
 
@@ -25,32 +32,401 @@ struct CurlRequest::Data {
     bool m_followRedirects = true;
     bool m_encrypt = false;
     bool m_certVerification = true;
+    CurlCachePolicy m_cachePolicy = CurlCachePolicy::None;
+    DataSink m_sink;
 };
 
-/* CurlManager */
+static std::string buildUrl(const CurlRequest::Data& data) {
+    auto url = data.m_url;
+    bool first = url.find('?') == std::string::npos;
+    for (auto& [key, value] : data.m_queryParams) {
+        url += (first ? "?" : "&") + util::format::urlEncode(key) + "=" + util::format::urlEncode(value);
+        first = false;
+    }
 
-const char* CurlManager::getCurlVersion() {
-    return curl_version_info(CURLVERSION_NOW)->version;
+    return url;
 }
 
-CurlManager::Task CurlManager::send(CurlRequest& req) {
-    GLOBED_REQUIRE(req.m_data, "attempting to send the same CurlRequest twice");
+static bool usesCache(const CurlRequest::Data& data) {
+    // streamed bodies are never buffered, so there's nothing to store
+    return data.m_cachePolicy != CurlCachePolicy::None && data.m_method == "GET" && !data.m_sink;
+}
 
-    return Task::run([data = std::move(req.m_data)](auto, auto hasBeenCancelled) -> Task::Result {
-        // init curl
-        auto curl = curl_easy_init();
-        if (!curl) {
-            return CurlResponse::fatalError("curl initialization failed");
-        }
+/* CurlManager */
 
+// how many idle easy handles are kept around for reuse
+constexpr static size_t MAX_IDLE_HANDLES = 8;
+// don't trust the server's Content-Length further than this
+constexpr static size_t MAX_PREALLOCATION = 64 * 1024 * 1024;
+// upper bound on how long the worker sleeps, also bounds how long a cancelled request with no traffic lingers
+constexpr static int POLL_TIMEOUT_MS = 250;
+
+class CurlManager::Impl {
+public:
+    struct Transfer {
+        std::shared_ptr<CurlRequest::Data> data;
+        CURL* handle = nullptr;
+        curl_slist* headers = nullptr;
+        std::string url;
         CurlResponse response;
+        char errorBuffer[CURL_ERROR_SIZE];
+        std::function<void(Task::Result)> finish;
+        std::function<bool()> hasBeenCancelled;
+
+        // empty if the cache is not used for this request
+        std::string cacheKey;
+        HttpCache::Handle cached;
+    };
+
+    HttpCache cache;
+
+    Impl() : cache(Mod::get()->getSaveDir() / "http-cache") {
+        multi = curl_multi_init();
+        share = curl_share_init();
+
+        // connections, dns cache and tls sessions are all shared between requests.
+        // everything is only touched from the worker thread, so no lock callbacks are needed.
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+
+        curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, 6L);
+        curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, 16L);
+
+        thread.setStartFunction([this] {
+            geode::utils::thread::setName("Curl Worker");
+            cache.removeExpired();
+        });
+        thread.setLoopFunction(&Impl::threadFunc);
+        thread.start(this);
+    }
+
+    ~Impl() {
+        curl_multi_wakeup(multi);
+        thread.stopAndWait();
+
+        for (auto& [handle, transfer] : active) {
+            curl_multi_remove_handle(multi, handle);
+            curl_slist_free_all(transfer->headers);
+            curl_easy_cleanup(handle);
+        }
+
+        for (auto handle : idleHandles) {
+            curl_easy_cleanup(handle);
+        }
+
+        curl_multi_cleanup(multi);
+        curl_share_cleanup(share);
+    }
+
+    // Thread safe, the transfer is picked up by the worker thread.
+    void submit(std::unique_ptr<Transfer> transfer) {
+        pending.lock()->push_back(std::move(transfer));
+        curl_multi_wakeup(multi);
+    }
+
+    // Thread safe. Refreshes a stale cache entry without anyone waiting on the result,
+    // does nothing if this url is already being revalidated.
+    void revalidate(std::shared_ptr<CurlRequest::Data> data, std::string key, HttpCache::Handle cached) {
+        if (!revalidating.lock()->insert(key).second) {
+            return;
+        }
+
+        auto transfer = std::make_unique<Transfer>();
+        transfer->data = std::move(data);
+        transfer->url = key;
+        transfer->cacheKey = key;
+        transfer->cached = std::move(cached);
+        transfer->finish = [this, key = std::move(key)](auto) {
+            revalidating.lock()->erase(key);
+        };
+        transfer->hasBeenCancelled = [] { return false; };
+
+        this->submit(std::move(transfer));
+    }
+
+private:
+    CURLM* multi = nullptr;
+    CURLSH* share = nullptr;
+
+    asp::Mutex<std::vector<std::unique_ptr<Transfer>>> pending;
+    asp::Mutex<std::unordered_set<std::string>> revalidating;
+
+    // only accessed from the worker thread
+    std::unordered_map<CURL*, std::unique_ptr<Transfer>> active;
+    std::vector<CURL*> idleHandles;
+
+    asp::Thread<Impl*> thread;
+
+    void threadFunc(decltype(thread)::StopToken&) {
+        this->startPending();
+        this->dropCancelled();
+
+        int running = 0;
+        curl_multi_perform(multi, &running);
+
+        int left = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi, &left)) {
+            if (msg->msg != CURLMSG_DONE) continue;
+
+            // msg is invalidated once the handle is removed
+            CURL* handle = msg->easy_handle;
+            CURLcode code = msg->data.result;
+            this->completeTransfer(handle, code);
+        }
+
+        // sleeps until there is socket activity, a new request is submitted or the timeout runs out
+        curl_multi_poll(multi, nullptr, 0, POLL_TIMEOUT_MS, nullptr);
+    }
+
+    void startPending() {
+        std::vector<std::unique_ptr<Transfer>> toStart;
+        std::swap(toStart, *pending.lock());
+
+        for (auto& transfer : toStart) {
+            if (transfer->hasBeenCancelled()) {
+                transfer->finish(Task::Cancel());
+                continue;
+            }
+
+            if (this->answerFromDisk(*transfer)) {
+                continue;
+            }
+
+            transfer->handle = this->acquireHandle();
+            if (!transfer->handle) {
+                transfer->finish(CurlResponse::fatalError("curl initialization failed"));
+                continue;
+            }
+
+            this->setupTransfer(*transfer);
+
+            auto mcode = curl_multi_add_handle(multi, transfer->handle);
+            if (mcode != CURLM_OK) {
+                transfer->finish(CurlResponse::fatalError(fmt::format("curl_multi_add_handle failed: {}", curl_multi_strerror(mcode))));
+                curl_slist_free_all(transfer->headers);
+                this->releaseHandle(transfer->handle);
+                continue;
+            }
+
+            active.emplace(transfer->handle, std::move(transfer));
+        }
+    }
+
+    // The entry wasn't in memory when the request was sent, so it's read from disk here rather than on the caller's thread.
+    // Returns true if the transfer was finished with the cached response, otherwise it goes to the network as usual.
+    bool answerFromDisk(Transfer& transfer) {
+        if (transfer.cacheKey.empty() || transfer.cached) {
+            return false;
+        }
+
+        transfer.cached = cache.get(transfer.cacheKey);
+        if (!transfer.cached) {
+            return false;
+        }
+
+        bool fresh = transfer.cached->isFresh(HttpCache::now());
+        if (!fresh && transfer.data->m_cachePolicy != CurlCachePolicy::StaleWhileRevalidate) {
+            return false;
+        }
+
+        if (!fresh) {
+            this->revalidate(transfer.data, transfer.cacheKey, transfer.cached);
+        }
+
+        transfer.finish(CurlResponse::fromCacheEntry(*transfer.cached));
+        return true;
+    }
+
+    void dropCancelled() {
+        for (auto it = active.begin(); it != active.end();) {
+            auto& transfer = it->second;
+            if (!transfer->hasBeenCancelled()) {
+                ++it;
+                continue;
+            }
+
+            curl_multi_remove_handle(multi, transfer->handle);
+            curl_slist_free_all(transfer->headers);
+            this->releaseHandle(transfer->handle);
+            transfer->finish(Task::Cancel());
+
+            it = active.erase(it);
+        }
+    }
+
+    void completeTransfer(CURL* handle, CURLcode code) {
+        auto it = active.find(handle);
+        if (it == active.end()) {
+            curl_multi_remove_handle(multi, handle);
+            return;
+        }
+
+        auto transfer = std::move(it->second);
+        active.erase(it);
+
+        curl_multi_remove_handle(multi, handle);
+
+        auto& response = transfer->response;
+
+        if (code == CURLE_OK) {
+            long status = 0;
+            curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &status);
+            response.m_code = status;
+        } else {
+            std::string_view providedMessage{transfer->errorBuffer};
+
+            response.m_code = 0;
+
+            if (providedMessage.empty()) {
+                response.m_fatalMessage = fmt::format("Curl failed: {}", curl_easy_strerror(code));
+            } else {
+                response.m_fatalMessage = fmt::format("Curl failed ({}): {}", (int)code, providedMessage);
+            }
+        }
+
+        curl_slist_free_all(transfer->headers);
+        transfer->headers = nullptr;
+        this->releaseHandle(handle);
+
+        if (!transfer->cacheKey.empty()) {
+            this->updateCache(*transfer);
+        }
+
+        if (transfer->hasBeenCancelled()) {
+            transfer->finish(Task::Cancel());
+        } else {
+            transfer->finish(std::move(response));
+        }
+    }
+
+    void updateCache(Transfer& transfer) {
+        auto& response = transfer.response;
+
+        // on network errors, fall back to whatever we have, but let the caller know it's not up to date
+        if (!response.m_fatalMessage.empty()) {
+            if (transfer.cached) {
+                auto reason = std::move(response.m_fatalMessage);
+                response = CurlResponse::fromCacheEntry(*transfer.cached);
+                response.m_fallbackReason = std::move(reason);
+            }
+
+            return;
+        }
+
+        auto cc = HttpCacheControl::parse(response.header("Cache-Control"));
+
+        if (response.m_code == 304 && transfer.cached) {
+            cache.refresh(transfer.cacheKey, cc.maxAge);
+            response = CurlResponse::fromCacheEntry(*transfer.cached);
+            return;
+        }
+
+        if (!response.ok()) {
+            return;
+        }
+
+        if (cc.noStore) {
+            cache.remove(transfer.cacheKey);
+            return;
+        }
+
+        cache.put(transfer.cacheKey, HttpCacheEntry {
+            .code = response.m_code,
+            .etag = response.header("ETag"),
+            .lastModified = response.header("Last-Modified"),
+            .contentType = response.header("Content-Type"),
+            .storedAt = HttpCache::now(),
+            .maxAge = cc.maxAge,
+            .body = response.m_rawResponse,
+        });
+    }
+
+    CURL* acquireHandle() {
+        if (!idleHandles.empty()) {
+            auto handle = idleHandles.back();
+            idleHandles.pop_back();
+            return handle;
+        }
+
+        return curl_easy_init();
+    }
+
+    void releaseHandle(CURL* handle) {
+        // reset clears all options but keeps the handle's caches alive
+        if (idleHandles.size() < MAX_IDLE_HANDLES) {
+            curl_easy_reset(handle);
+            idleHandles.push_back(handle);
+        } else {
+            curl_easy_cleanup(handle);
+        }
+    }
+
+    static size_t writeCallback(char* data, size_t size, size_t nmemb, void* userdata) {
+        auto& transfer = *static_cast<Transfer*>(userdata);
+        size_t len = size * nmemb;
+
+        // returning anything other than `len` aborts the transfer
+        if (transfer.data->m_sink) {
+            return transfer.data->m_sink(std::span{reinterpret_cast<const uint8_t*>(data), len}) ? len : 0;
+        }
+
+        auto& target = transfer.response.m_rawResponse;
+        target.insert(target.end(), data, data + len);
+
+        return len;
+    }
+
+    // called once for every header line
+    static size_t headerCallback(char* buffer, size_t size, size_t nitems, void* userdata) {
+        auto& transfer = *static_cast<Transfer*>(userdata);
+        size_t len = size * nitems;
+
+        std::string_view line{buffer, len};
+
+        auto colon = line.find(':');
+        if (colon == std::string_view::npos) {
+            return len;
+        }
+
+        auto key = line.substr(0, colon);
+        auto value = line.substr(colon + 1);
+
+        while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+        while (!value.empty() && (value.back() == '\r' || value.back() == '\n' || value.back() == ' ')) value.remove_suffix(1);
+
+        // preallocate the body, unless it's going straight to a sink
+        if (!transfer.data->m_sink && isContentLength(key)) {
+            size_t length = 0;
+            auto [_, ec] = std::from_chars(value.data(), value.data() + value.size(), length);
+
+            if (ec == std::errc{}) {
+                transfer.response.m_rawResponse.reserve(std::min(length, MAX_PREALLOCATION));
+            }
+        }
 
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response.m_rawResponse);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, +[](char* data, size_t size, size_t nmemb, void* userdata) {
-            auto& target = *static_cast<std::vector<uint8_t>*>(userdata);
-            target.insert(target.end(), data, data + size * nmemb);
-            return size * nmemb;
+        transfer.response.m_headers.insert_or_assign(std::string(key), std::string(value));
+
+        return len;
+    }
+
+    static bool isContentLength(std::string_view key) {
+        constexpr std::string_view expected = "content-length";
+
+        return std::equal(key.begin(), key.end(), expected.begin(), expected.end(), [](char a, char b) {
+            return std::tolower(a) == b;
         });
+    }
+
+    void setupTransfer(Transfer& transfer) {
+        auto curl = transfer.handle;
+        auto& data = transfer.data;
+
+        curl_easy_setopt(curl, CURLOPT_SHARE, share);
+
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &Impl::writeCallback);
 
         // set headers
         curl_slist* headers = nullptr;
@@ -64,16 +440,21 @@ CurlManager::Task CurlManager::send(CurlRequest& req) {
             headers = curl_slist_append(headers, hdr.c_str());
         }
 
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        // make it a conditional request if we have a cached copy
+        if (transfer.cached) {
+            if (!transfer.cached->etag.empty()) {
+                headers = curl_slist_append(headers, fmt::format("If-None-Match: {}", transfer.cached->etag).c_str());
+            }
 
-        auto url = data->m_url;
-        bool first = url.find('?') == std::string::npos;
-        for (auto& [key, value] : data->m_queryParams) {
-            url += (first ? "?" : "&") + util::format::urlEncode(key) + "=" + util::format::urlEncode(value);
-            first = false;
+            if (!transfer.cached->lastModified.empty()) {
+                headers = curl_slist_append(headers, fmt::format("If-Modified-Since: {}", transfer.cached->lastModified).c_str());
+            }
         }
 
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        transfer.headers = headers;
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+
+        curl_easy_setopt(curl, CURLOPT_URL, transfer.url.c_str());
 
         if (data->m_method != "GET") {
             if (data->m_method == "POST") {
@@ -97,7 +478,7 @@ CurlManager::Task CurlManager::send(CurlRequest& req) {
             curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data->m_body.data());
             curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, data->m_body.size());
         } else if (data->m_method == "POST") {
-            // curl_easy_perform would freeze on a POST request with no fields, so set it to an empty string
+            // curl would freeze on a POST request with no fields, so set it to an empty string
             curl_easy_setopt(curl, CURLOPT_POSTFIELDS, "");
         }
 
@@ -105,11 +486,14 @@ CurlManager::Task CurlManager::send(CurlRequest& req) {
             curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1);
             curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2);
 
+            // the bundle is static, so there's no need for curl to copy it every time.
+            // the parsed store is then cached by curl for the lifetime of the multi handle, if the tls backend supports it.
             curl_blob cbb = {};
             cbb.data = const_cast<void*>(reinterpret_cast<const void*>(CA_BUNDLE_CONTENT));
             cbb.len = sizeof(CA_BUNDLE_CONTENT);
-            cbb.flags = CURL_BLOB_COPY;
+            cbb.flags = CURL_BLOB_NOCOPY;
             curl_easy_setopt(curl, CURLOPT_CAINFO_BLOB, &cbb);
+            curl_easy_setopt(curl, CURLOPT_CA_CACHE_TIMEOUT, 86400L);
         } else {
             curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0);
             curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0);
@@ -125,12 +509,16 @@ CurlManager::Task CurlManager::send(CurlRequest& req) {
             curl_easy_setopt(curl, CURLOPT_TIMEOUT, data->m_timeout);
         }
 
+        // use http/2 where available, and prefer multiplexing over an existing connection to opening a new one.
+        // plain http is always http/1.1, waiting there would only make every request to the same host go one after another
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        if (transfer.url.starts_with("https://")) {
+            curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+        }
+
         // follow redirects
         curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, data->m_followRedirects ? 1L : 0L);
 
-        // track progress
-        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
-
         // don't change the method from POST to GET when following a redirect
         curl_easy_setopt(curl, CURLOPT_POSTREDIR, CURL_REDIR_POST_ALL);
 
@@ -141,73 +529,96 @@ CurlManager::Task CurlManager::send(CurlRequest& req) {
             curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
         }
 
-        char errorBuffer[CURL_ERROR_SIZE];
-        errorBuffer[0] = '\0';
-        curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, errorBuffer);
+        transfer.errorBuffer[0] = '\0';
+        curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, transfer.errorBuffer);
 
         // get headers from the response
-        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &response);
-        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, (+[](char* buffer, size_t size, size_t nitems, void* ptr) {
-            auto& headers = static_cast<CurlResponse*>(ptr)->m_headers;
-            std::string line;
-            std::stringstream ss(std::string(buffer, size * nitems));
-            while (std::getline(ss, line)) {
-                auto colon = line.find(':');
-                if (colon == std::string::npos) continue;
-                auto key = line.substr(0, colon);
-                auto value = line.substr(colon + 2);
-                if (value.ends_with('\r')) {
-                    value = value.substr(0, value.size() - 1);
-                }
-                headers.insert_or_assign(key, value);
-            }
-            return size * nitems;
-        }));
-
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &transfer);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, &Impl::headerCallback);
 
-        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &hasBeenCancelled);
+        // abort transfers that are cancelled mid-way, rather than waiting for the next poll
         curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &transfer.hasBeenCancelled);
         curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, +[](void* ptr, curl_off_t dtotal, curl_off_t dnow, curl_off_t utotal, curl_off_t unow) -> int {
-            auto& hbc = *static_cast<decltype(hasBeenCancelled)*>(ptr);
+            auto& hbc = *static_cast<std::function<bool()>*>(ptr);
+            return hbc() ? 1 : 0;
+        });
+    }
+};
 
-            // check if request was cancelled
-            if (hbc()) {
-                return 1;
-            }
+CurlManager::CurlManager() : impl(std::make_unique<Impl>()) {}
 
-            return 0;
-        });
+CurlManager::~CurlManager() {}
 
-        // perform the request
-        CURLcode code = curl_easy_perform(curl);
+const char* CurlManager::getCurlVersion() {
+    return curl_version_info(CURLVERSION_NOW)->version;
+}
 
-        if (code == CURLE_OK) {
-            long status = 0;
-            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
-            response.m_code = status;
-        } else {
-            if (hasBeenCancelled()) {
-                curl_slist_free_all(headers);
-                curl_easy_cleanup(curl);
-                return Task::Cancel();
-            }
+CurlManager::Task CurlManager::send(CurlRequest& req) {
+    GLOBED_REQUIRE(req.m_data, "attempting to send the same CurlRequest twice");
 
-            std::string_view providedMessage{errorBuffer};
+    auto data = std::move(req.m_data);
+    auto url = buildUrl(*data);
 
-            response.m_code = 0;
+    std::string cacheKey;
+    HttpCache::Handle cached;
 
-            if (providedMessage.empty()) {
-                response.m_fatalMessage = fmt::format("Curl failed: {}", curl_easy_strerror(code));
-            } else {
-                response.m_fatalMessage = fmt::format("Curl failed ({}): {}", (int)code, providedMessage);
+    if (usesCache(*data)) {
+        cacheKey = url;
+        // entries that are only on disk are looked up by the worker, see answerFromDisk
+        cached = impl->cache.peek(cacheKey);
+
+        if (cached) {
+            bool fresh = cached->isFresh(HttpCache::now());
+
+            if (fresh || data->m_cachePolicy == CurlCachePolicy::StaleWhileRevalidate) {
+                if (!fresh) {
+                    impl->revalidate(data, cacheKey, cached);
+                }
+
+                return Task::immediate(CurlResponse::fromCacheEntry(*cached), "CurlManager cached web request");
             }
         }
+    }
+
+    return Task::runWithCallback([
+        this,
+        data = std::move(data),
+        url = std::move(url),
+        cacheKey = std::move(cacheKey),
+        cached = std::move(cached)
+    ](auto finish, auto, auto hasBeenCancelled) mutable {
+        auto transfer = std::make_unique<Impl::Transfer>();
+        transfer->data = std::move(data);
+        transfer->url = std::move(url);
+        transfer->cacheKey = std::move(cacheKey);
+        transfer->cached = std::move(cached);
+        transfer->finish = std::move(finish);
+        transfer->hasBeenCancelled = std::move(hasBeenCancelled);
+
+        impl->submit(std::move(transfer));
+    }, "CurlManager web request");
+}
+
+std::optional<CurlResponse> CurlManager::getCached(const CurlRequest& req) {
+    if (!req.m_data || !usesCache(*req.m_data)) {
+        return std::nullopt;
+    }
 
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
+    auto cached = impl->cache.get(buildUrl(*req.m_data));
+    if (!cached) {
+        return std::nullopt;
+    }
 
-        return response;
-    }, fmt::format("CurlManager web request"));
+    return CurlResponse::fromCacheEntry(*cached);
+}
+
+void CurlManager::invalidateCached(const CurlRequest& req) {
+    if (!req.m_data || !usesCache(*req.m_data)) {
+        return;
+    }
+
+    impl->cache.remove(buildUrl(*req.m_data));
 }
 
 /* CurlRequest */
@@ -306,6 +717,16 @@ CurlRequest& CurlRequest::certVerification(bool enc) {
     return *this;
 }
 
+CurlRequest& CurlRequest::cache(CurlCachePolicy policy) {
+    m_data->m_cachePolicy = policy;
+    return *this;
+}
+
+CurlRequest& CurlRequest::sink(DataSink sink) {
+    m_data->m_sink = std::move(sink);
+    return *this;
+}
+
 CurlManager::Task CurlRequest::send() {
     return CurlManager::get().send(*this);
 }
@@ -319,6 +740,19 @@ CurlResponse CurlResponse::fatalError(std::string_view message) {
     return resp;
 }
 
+CurlResponse CurlResponse::fromCacheEntry(const HttpCacheEntry& entry) {
+    CurlResponse resp;
+    resp.m_code = entry.code;
+    resp.m_fromCache = true;
+    resp.m_rawResponse = entry.body;
+
+    if (!entry.etag.empty()) resp.m_headers["ETag"] = entry.etag;
+    if (!entry.lastModified.empty()) resp.m_headers["Last-Modified"] = entry.lastModified;
+    if (!entry.contentType.empty()) resp.m_headers["Content-Type"] = entry.contentType;
+
+    return resp;
+}
+
 int CurlResponse::getCode() const {
     return m_code;
 }
@@ -327,12 +761,29 @@ bool CurlResponse::ok() const {
     return m_fatalMessage.empty() && m_code >= 200 && m_code < 300;
 }
 
+bool CurlResponse::isFromCache() const {
+    return m_fromCache;
+}
+
+bool CurlResponse::isFallback() const {
+    return !m_fallbackReason.empty();
+}
+
 std::string CurlResponse::header(std::string_view key) const {
     std::string k(key);
     if (m_headers.contains(k)) {
         return m_headers.at(k);
     }
 
+    // http/2 responses always have lowercase header names
+    for (const auto& [name, value] : m_headers) {
+        if (std::equal(name.begin(), name.end(), key.begin(), key.end(), [](char a, char b) {
+            return std::tolower(a) == std::tolower(b);
+        })) {
+            return value;
+        }
+    }
+
     return "";
 }
 
@@ -348,16 +799,30 @@ geode::Result<std::vector<uint8_t>> CurlResponse::data() {
     return Ok(m_rawResponse);
 }
 
+geode::Result<std::vector<uint8_t>> CurlResponse::takeData() {
+    if (!m_fatalMessage.empty()) {
+        return Err(m_fatalMessage);
+    }
+
+    return Ok(std::move(m_rawResponse));
+}
+
 geode::Result<std::string> CurlResponse::text() {
+    GLOBED_UNWRAP_INTO(this->textView(), auto view);
+
+    return Ok(std::string(view));
+}
+
+geode::Result<std::string_view> CurlResponse::textView() const {
     if (!m_fatalMessage.empty()) {
         return Err(m_fatalMessage);
     }
 
-    return Ok(std::string(&*m_rawResponse.begin(), &*m_rawResponse.end()));
+    return Ok(std::string_view(reinterpret_cast<const char*>(m_rawResponse.data()), m_rawResponse.size()));
 }
 
 geode::Result<matjson::Value> CurlResponse::json() {
-    GLOBED_UNWRAP_INTO(this->text(), auto str);
+    GLOBED_UNWRAP_INTO(this->textView(), auto str);
 
     auto val = matjson::parse(str);
     if (!val) {
@@ -370,6 +835,8 @@ geode::Result<matjson::Value> CurlResponse::json() {
 std::string CurlResponse::getError() {
     if (!m_fatalMessage.empty()) {
         return fmt::format("Fatal error: {}", m_fatalMessage);
+    } else if (!m_fallbackReason.empty()) {
+        return fmt::format("Fatal error: {}", m_fallbackReason);
     } else {
         return fmt::format("code {}: {}", m_code, this->text().unwrapOr("<no content>"));
     }
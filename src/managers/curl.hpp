@@ -3,6 +3,7 @@
 #include <defs/assert.hpp>
 #include <defs/minimal_geode.hpp>
 #include <stdint.h>
+#include <span>
 #include <matjson.hpp>
 #include <Geode/Result.hpp>
 #include <Geode/utils/Task.hpp>
@@ -13,6 +14,18 @@
 #include <asp/time/Duration.hpp>
 
 struct CurlRequest;
+struct HttpCacheEntry;
+
+// How a GET request interacts with the on-disk http cache
+enum class CurlCachePolicy {
+    // the cache is not used at all
+    None,
+    // fresh entries are served from the cache, otherwise a conditional request is made.
+    // if the request fails, the cached copy is returned instead of the error, with `CurlResponse::isFallback` set.
+    Revalidate,
+    // any cached entry is returned immediately, stale ones are revalidated in the background
+    StaleWhileRevalidate,
+};
 
 struct GLOBED_DLL CurlResponse {
     CurlResponse() {}
@@ -25,12 +38,21 @@ struct GLOBED_DLL CurlResponse {
 
     int getCode() const;
     bool ok() const;
+    // whether this response was served from the http cache, rather than the network
+    bool isFromCache() const;
+    // whether the request failed and this is the stale cached copy instead. `getError` returns why it failed
+    bool isFallback() const;
 
     std::string header(std::string_view key) const;
     const std::unordered_map<std::string, std::string>& headers(std::string_view key) const;
 
     Result<std::vector<uint8_t>> data();
+    // like `data()`, but moves the body out of the response instead of copying it
+    Result<std::vector<uint8_t>> takeData();
     Result<std::string> text();
+    // a view into the response body, valid for as long as the response is
+    Result<std::string_view> textView() const;
+    // parsed directly from the response body, without copying it into a string first
     Result<matjson::Value> json();
 
     template <typename T>
@@ -55,15 +77,21 @@ struct GLOBED_DLL CurlResponse {
 
 private:
     int m_code = 0;
+    bool m_fromCache = false;
     std::string m_fatalMessage;
+    std::string m_fallbackReason; // the error of the failed request, if this is a fallback
     std::vector<uint8_t> m_rawResponse;
     std::unordered_map<std::string, std::string> m_headers;
 
+    static CurlResponse fromCacheEntry(const HttpCacheEntry& entry);
+
     friend class CurlManager;
 };
 
-class GLOBED_DLL CurlManager : public SingletonBase<CurlManager> {
-    friend class SingletonBase;
+// All requests are performed on a single worker thread through one curl multi handle,
+// so connections, DNS lookups and TLS sessions are reused between requests.
+class GLOBED_DLL CurlManager : public SingletonLeakBase<CurlManager> {
+    friend class SingletonLeakBase;
 
 public:
     using Task = geode::Task<CurlResponse>;
@@ -71,10 +99,24 @@ public:
     const char* getCurlVersion();
     Task send(CurlRequest& req);
 
+    // returns the cached response for this request regardless of its age, without making any requests.
+    // unlike send, this reads the entry from disk on the calling thread, so it's only meant for small responses needed right away
+    std::optional<CurlResponse> getCached(const CurlRequest& req);
+    void invalidateCached(const CurlRequest& req);
+
+protected:
+    CurlManager();
+    ~CurlManager();
+
 private:
+    class Impl;
+    std::unique_ptr<Impl> impl;
 };
 
 struct CurlRequest {
+    // receives the response body in chunks as it arrives, return false to abort the transfer
+    using DataSink = std::function<bool(std::span<const uint8_t>)>;
+
     CurlRequest();
     CurlRequest& header(std::string_view name, std::string_view value);
     CurlRequest& param(std::string_view name, std::string_view value);
@@ -107,6 +149,10 @@ struct CurlRequest {
     CurlRequest& customMethod(std::string_view url, std::string_view method);
     CurlRequest& encrypted(bool enc);
     CurlRequest& certVerification(bool enc);
+    // only applies to GET requests
+    CurlRequest& cache(CurlCachePolicy policy);
+    // streams the body into `sink` instead of buffering it, the response will then have an empty body
+    CurlRequest& sink(DataSink sink);
 
     CurlManager::Task send();
 
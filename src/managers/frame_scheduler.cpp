@@ -0,0 +1,129 @@
+#include "frame_scheduler.hpp"
+
+#include <globed/profiler.hpp>
+#include <managers/settings.hpp>
+
+#include <asp/time/Instant.hpp>
+
+using namespace geode::prelude;
+using namespace asp::time;
+
+// how often budget overruns are reported in the log
+constexpr static float OVERRUN_REPORT_INTERVAL = 5.f;
+
+FrameScheduler::FrameScheduler() {}
+
+void FrameScheduler::queue(Priority priority, Task&& task) {
+    (*queues.lock())[(size_t)priority].push_back(QueuedTask {
+        .task = std::move(task),
+        .owner = std::nullopt,
+    });
+}
+
+void FrameScheduler::queue(Priority priority, CCObject* owner, Task&& task) {
+    (*queues.lock())[(size_t)priority].push_back(QueuedTask {
+        .task = std::move(task),
+        .owner = WeakRef(owner),
+    });
+}
+
+bool FrameScheduler::hasBudget(Priority priority) {
+    if (priority == Priority::Gameplay) return true;
+
+    this->beginFrameIfNeeded();
+
+    return spent < this->getBudget();
+}
+
+void FrameScheduler::addSpent(Duration time) {
+    this->beginFrameIfNeeded();
+
+    spent += time;
+}
+
+Duration FrameScheduler::getBudget() {
+    return Duration::fromMillis(GlobedSettings::get().globed.frameBudget.get());
+}
+
+FrameScheduler::Stats FrameScheduler::getStats() {
+    return stats;
+}
+
+void FrameScheduler::update(float dt) {
+    this->beginFrameIfNeeded();
+    this->reportOverruns(dt);
+
+    bool ranAny = false;
+
+    for (size_t i = 0; i < PRIORITY_COUNT; i++) {
+        auto priority = (Priority)i;
+
+        // at least one task runs every frame, so that the queue always makes progress
+        while (!ranAny || this->hasBudget(priority)) {
+            auto task = this->popTask(priority);
+            if (!task) break;
+
+            // the owner is gone, so is whatever the task was going to update
+            if (task->owner && !task->owner->valid()) continue;
+
+            GLOBED_PROFILE_ZONE("FrameScheduler task");
+
+            auto start = Instant::now();
+            task->task();
+            this->addSpent(start.elapsed());
+
+            stats.executed++;
+            ranAny = true;
+        }
+    }
+
+    auto locked = queues.lock();
+    for (auto& queue : *locked) {
+        stats.deferred += queue.size();
+    }
+}
+
+void FrameScheduler::beginFrameIfNeeded() {
+    auto frame = CCDirector::get()->getTotalFrames();
+    if (frame == currentFrame) return;
+
+    currentFrame = frame;
+
+    if (spent > this->getBudget()) {
+        stats.overruns++;
+        unreportedOverruns++;
+        unreportedWorst = std::max(unreportedWorst, spent);
+    }
+
+    stats.worstFrame = std::max(stats.worstFrame, spent);
+    spent = Duration{};
+}
+
+std::optional<FrameScheduler::QueuedTask> FrameScheduler::popTask(Priority priority) {
+    auto locked = queues.lock();
+    auto& queue = (*locked)[(size_t)priority];
+
+    if (queue.empty()) return std::nullopt;
+
+    auto task = std::move(queue.front());
+    queue.pop_front();
+
+    return task;
+}
+
+void FrameScheduler::reportOverruns(float dt) {
+    sinceOverrunReport += dt;
+
+    if (sinceOverrunReport < OVERRUN_REPORT_INTERVAL) return;
+    sinceOverrunReport = 0.f;
+
+    if (unreportedOverruns == 0) return;
+
+    log::debug(
+        "Frame budget ({}) exceeded in {} frames over the last {}s, worst frame: {}",
+        this->getBudget().toString(), unreportedOverruns, OVERRUN_REPORT_INTERVAL, unreportedWorst.toString()
+    );
+
+    unreportedOverruns = 0;
+    unreportedWorst = Duration{};
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <defs/geode.hpp>
+#include <util/singleton.hpp>
+
+#include <asp/sync.hpp>
+#include <asp/time/Duration.hpp>
+
+#include <deque>
+
+// Runs Globed work on the main thread within a per-frame time budget, so that a burst of packets or callbacks
+// doesn't turn into a lagspike. Work that doesn't fit in the budget is pushed to the next frame, in priority order.
+class FrameScheduler : public SingletonNodeBase<FrameScheduler, true> {
+    friend class SingletonNodeBase;
+
+    FrameScheduler();
+
+public:
+    // Lower values run first
+    enum class Priority : uint8_t {
+        Gameplay,   // never deferred, always runs in the frame it was queued for
+        Network,    // dispatching packets and callbacks from the network thread
+        Normal,     // profile refreshes and such
+        Ui,         // list rebuilds, nobody notices these being a frame late
+    };
+
+    static constexpr size_t PRIORITY_COUNT = 4;
+
+    using Task = std::function<void()>;
+
+    struct Stats {
+        size_t executed = 0;
+        size_t deferred = 0; // how many times a task had to wait for a later frame
+        size_t overruns = 0; // frames where the budget was exceeded
+        asp::time::Duration worstFrame{};
+    };
+
+    // Thread safe.
+    void queue(Priority priority, Task&& task);
+    // Must be called from the main thread. The task is dropped if `owner` gets destroyed before it runs.
+    void queue(Priority priority, cocos2d::CCObject* owner, Task&& task);
+
+    // For work that doesn't go through the queue (like packet dispatch), but should still respect the budget.
+    // Gameplay work always has budget, everything else only until the budget for this frame is used up.
+    bool hasBudget(Priority priority);
+    // Counts time spent on work outside of the queue towards the budget of this frame
+    void addSpent(asp::time::Duration time);
+
+    asp::time::Duration getBudget();
+    Stats getStats();
+
+    void update(float dt) override;
+
+private:
+    struct QueuedTask {
+        Task task;
+        std::optional<geode::WeakRef<cocos2d::CCObject>> owner;
+    };
+
+    asp::Mutex<std::array<std::deque<QueuedTask>, PRIORITY_COUNT>> queues;
+
+    unsigned int currentFrame = 0;
+    asp::time::Duration spent{};
+    Stats stats;
+
+    // overruns are logged in batches rather than every frame
+    size_t unreportedOverruns = 0;
+    asp::time::Duration unreportedWorst{};
+    float sinceOverrunReport = 0.f;
+
+    void beginFrameIfNeeded();
+    std::optional<QueuedTask> popTask(Priority priority);
+    void reportOverruns(float dt);
+};
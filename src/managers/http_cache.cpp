@@ -0,0 +1,282 @@
+#include "http_cache.hpp"
+
+#include <data/bytebuffer.hpp>
+#include <util/crypto.hpp>
+
+#include <asp/time/SystemTime.hpp>
+
+#include <charconv>
+#include <fstream>
+
+using namespace asp::time;
+
+constexpr static uint32_t FILE_MAGIC = 0x47484331; // GHC1
+constexpr static uint16_t FILE_VERSION = 2;
+
+bool HttpCacheEntry::isFresh(int64_t now) const {
+    return now - storedAt < maxAge;
+}
+
+HttpCacheControl HttpCacheControl::parse(std::string_view header) {
+    HttpCacheControl out;
+
+    while (!header.empty()) {
+        auto comma = header.find(',');
+        auto directive = header.substr(0, comma);
+        header = comma == std::string_view::npos ? std::string_view{} : header.substr(comma + 1);
+
+        while (!directive.empty() && directive.front() == ' ') directive.remove_prefix(1);
+        while (!directive.empty() && directive.back() == ' ') directive.remove_suffix(1);
+
+        if (directive == "no-store") {
+            out.noStore = true;
+        } else if (directive == "no-cache") {
+            out.maxAge = 0;
+        } else if (directive.starts_with("max-age=")) {
+            directive.remove_prefix(sizeof("max-age=") - 1);
+
+            int64_t value = 0;
+            auto [_, ec] = std::from_chars(directive.data(), directive.data() + directive.size(), value);
+            if (ec == std::errc{} && value > 0) {
+                out.maxAge = value;
+            }
+        }
+    }
+
+    return out;
+}
+
+HttpCache::HttpCache(std::filesystem::path directory) : directory(std::move(directory)) {
+    std::error_code ec;
+    std::filesystem::create_directories(this->directory, ec);
+
+    if (ec) {
+        log::warn("Failed to create http cache directory {}: {}", this->directory, ec.message());
+    }
+}
+
+HttpCache::Handle HttpCache::get(const std::string& key) {
+    if (auto entry = this->peek(key)) {
+        return entry;
+    }
+
+    auto entry = this->loadFromDisk(key);
+    if (!entry) {
+        return nullptr;
+    }
+
+    if (now() - entry->storedAt > MAX_ENTRY_AGE) {
+        this->remove(key);
+        return nullptr;
+    }
+
+    this->memory.lock()->insert(key, entry);
+    return entry;
+}
+
+HttpCache::Handle HttpCache::peek(const std::string& key) {
+    auto memory = this->memory.lock();
+    auto it = memory->entries.find(key);
+
+    if (it == memory->entries.end()) {
+        return nullptr;
+    }
+
+    memory->lru.splice(memory->lru.begin(), memory->lru, it->second.lruPos);
+    return it->second.entry;
+}
+
+void HttpCache::put(const std::string& key, HttpCacheEntry entry) {
+    if (entry.body.size() > MAX_BODY_SIZE) {
+        this->remove(key);
+        return;
+    }
+
+    this->saveToDisk(key, entry);
+    this->memory.lock()->insert(key, std::make_shared<const HttpCacheEntry>(std::move(entry)));
+}
+
+void HttpCache::refresh(const std::string& key, int64_t maxAge) {
+    auto existing = this->get(key);
+    if (!existing) return;
+
+    HttpCacheEntry entry = *existing;
+    entry.storedAt = now();
+    entry.maxAge = maxAge;
+
+    this->put(key, std::move(entry));
+}
+
+void HttpCache::remove(const std::string& key) {
+    this->memory.lock()->erase(key);
+
+    std::error_code ec;
+    std::filesystem::remove(this->pathForKey(key), ec);
+}
+
+void HttpCache::removeExpired() {
+    // every write replaces the file, so its modification time is when the entry was last stored or refreshed
+    auto cutoff = std::filesystem::file_time_type::clock::now() - std::chrono::seconds(MAX_ENTRY_AGE);
+
+    std::error_code ec;
+    size_t removed = 0;
+
+    for (auto& file : std::filesystem::directory_iterator(directory, ec)) {
+        std::error_code fileEc;
+        auto& path = file.path();
+
+        bool expired = path.extension() == ".tmp" || file.last_write_time(fileEc) < cutoff;
+        if (fileEc || !expired) continue;
+
+        if (std::filesystem::remove(path, fileEc)) {
+            removed++;
+        }
+    }
+
+    if (removed > 0) {
+        log::debug("Removed {} expired http cache entries", removed);
+    }
+}
+
+void HttpCache::Memory::insert(const std::string& key, Handle entry) {
+    this->erase(key);
+
+    // the newest entry always stays, even if it's bigger than the limit by itself
+    while (!lru.empty() && size + entry->body.size() > MAX_MEMORY_SIZE) {
+        this->erase(lru.back());
+    }
+
+    size += entry->body.size();
+    lru.push_front(key);
+    entries.emplace(key, MemoryEntry {
+        .entry = std::move(entry),
+        .lruPos = lru.begin(),
+    });
+}
+
+void HttpCache::Memory::erase(const std::string& key) {
+    auto it = entries.find(key);
+    if (it == entries.end()) return;
+
+    // `key` may be the list node itself, so that goes last
+    auto lruPos = it->second.lruPos;
+    size -= it->second.entry->body.size();
+    entries.erase(it);
+    lru.erase(lruPos);
+}
+
+int64_t HttpCache::now() {
+    return static_cast<int64_t>(SystemTime::now().timeSinceEpoch().seconds());
+}
+
+std::filesystem::path HttpCache::pathForKey(const std::string& key) {
+    auto name = util::crypto::hexEncode(util::crypto::simpleHash(key));
+    name.resize(32);
+
+    return directory / (name + ".bin");
+}
+
+HttpCache::Handle HttpCache::loadFromDisk(const std::string& key) {
+    auto path = this->pathForKey(key);
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        return nullptr;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return nullptr;
+    }
+
+    util::data::bytevector data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ByteBuffer bb(std::move(data));
+
+    HttpCacheEntry entry;
+
+    auto result = [&]() -> ByteBuffer::DecodeResult<bool> {
+        GLOBED_UNWRAP_INTO(bb.readU32(), auto magic);
+        GLOBED_UNWRAP_INTO(bb.readU16(), auto version);
+
+        if (magic != FILE_MAGIC || version != FILE_VERSION) {
+            return Ok(false);
+        }
+
+        // guards against two urls hashing to the same file
+        GLOBED_UNWRAP_INTO(bb.readValue<std::string>(), auto storedKey);
+        if (storedKey != key) {
+            return Ok(false);
+        }
+
+        GLOBED_UNWRAP_INTO(bb.readI32(), entry.code);
+        GLOBED_UNWRAP_INTO(bb.readValue<std::string>(), entry.etag);
+        GLOBED_UNWRAP_INTO(bb.readValue<std::string>(), entry.lastModified);
+        GLOBED_UNWRAP_INTO(bb.readValue<std::string>(), entry.contentType);
+        GLOBED_UNWRAP_INTO(bb.readI64(), entry.storedAt);
+        GLOBED_UNWRAP_INTO(bb.readI64(), entry.maxAge);
+        // bodies can be longer than what a length prefix of ByteBuffer fits
+        GLOBED_UNWRAP_INTO(bb.readU32(), auto bodySize);
+        if (bodySize > MAX_BODY_SIZE) {
+            return Ok(false);
+        }
+
+        entry.body.resize(bodySize);
+        GLOBED_UNWRAP(bb.readBytesInto(entry.body.data(), bodySize));
+
+        return Ok(true);
+    }();
+
+    if (result.isErr()) {
+        log::warn("Failed to read http cache entry for {}: {}", key, ByteBuffer::strerror(result.unwrapErr()));
+        return nullptr;
+    }
+
+    if (!result.unwrap()) {
+        return nullptr;
+    }
+
+    return std::make_shared<const HttpCacheEntry>(std::move(entry));
+}
+
+void HttpCache::saveToDisk(const std::string& key, const HttpCacheEntry& entry) {
+    ByteBuffer bb;
+    bb.writeU32(FILE_MAGIC);
+    bb.writeU16(FILE_VERSION);
+    bb.writeValue(key);
+    bb.writeI32(entry.code);
+    bb.writeValue(entry.etag);
+    bb.writeValue(entry.lastModified);
+    bb.writeValue(entry.contentType);
+    bb.writeI64(entry.storedAt);
+    bb.writeI64(entry.maxAge);
+    bb.writeU32(entry.body.size());
+
+    auto path = this->pathForKey(key);
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+
+    {
+        std::ofstream file(tmpPath, std::ios::binary);
+        if (!file.is_open()) {
+            log::warn("Failed to open {} for writing", tmpPath);
+            return;
+        }
+
+        // the body goes right after the header, no need to copy it into the buffer first
+        file.write(reinterpret_cast<const char*>(bb.data().data()), bb.size());
+        file.write(reinterpret_cast<const char*>(entry.body.data()), entry.body.size());
+        if (!file) {
+            log::warn("Failed to write {}", tmpPath);
+            return;
+        }
+    }
+
+    // rename so that a crash mid-write never leaves a truncated entry behind
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+
+    if (ec) {
+        log::warn("Failed to move {} into place: {}", tmpPath, ec.message());
+        std::filesystem::remove(tmpPath, ec);
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <defs/geode.hpp>
+#include <asp/sync.hpp>
+
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A single cached response, along with everything needed to revalidate it.
+struct HttpCacheEntry {
+    int code = 0;
+    std::string etag;
+    std::string lastModified;
+    std::string contentType;
+    int64_t storedAt = 0; // unix seconds
+    int64_t maxAge = 0; // seconds, taken from Cache-Control
+    std::vector<uint8_t> body;
+
+    bool isFresh(int64_t now) const;
+};
+
+// Parsed subset of the Cache-Control header that matters for a client-side cache.
+struct HttpCacheControl {
+    bool noStore = false;
+    int64_t maxAge = 0;
+
+    static HttpCacheControl parse(std::string_view header);
+};
+
+// On-disk cache of GET responses, keyed by the full URL. Thread safe.
+// Every entry is stored in its own file, and kept in memory once it has been read, up to MAX_MEMORY_SIZE in total.
+// Past that the least recently used entries are dropped from memory, and read from disk again when needed.
+// Entries can be up to MAX_BODY_SIZE, so anything that may touch the disk should be called from a worker thread.
+class HttpCache {
+public:
+    using Handle = std::shared_ptr<const HttpCacheEntry>;
+
+    // responses bigger than this are never cached
+    static constexpr size_t MAX_BODY_SIZE = 4 * 1024 * 1024;
+    // total size of the bodies kept in memory
+    static constexpr size_t MAX_MEMORY_SIZE = 8 * 1024 * 1024;
+    // entries not updated for this long are thrown away when read, and by removeExpired
+    static constexpr int64_t MAX_ENTRY_AGE = 60 * 60 * 24 * 30;
+
+    HttpCache(std::filesystem::path directory);
+
+    // returns nullptr if there is no entry for this key. reads the entry from disk if it's not in memory yet
+    Handle get(const std::string& key);
+    // like get, but only looks at entries already in memory, so it never blocks on the disk
+    Handle peek(const std::string& key);
+    void put(const std::string& key, HttpCacheEntry entry);
+    // marks the entry as fresh again, called after a 304 response
+    void refresh(const std::string& key, int64_t maxAge);
+    void remove(const std::string& key);
+    // deletes entries that were not updated for MAX_ENTRY_AGE, and files left behind by interrupted writes
+    void removeExpired();
+
+    static int64_t now();
+
+private:
+    struct MemoryEntry {
+        Handle entry;
+        std::list<std::string>::iterator lruPos;
+    };
+
+    struct Memory {
+        std::unordered_map<std::string, MemoryEntry> entries;
+        std::list<std::string> lru; // most recently used at the front
+        size_t size = 0;
+
+        void insert(const std::string& key, Handle entry);
+        void erase(const std::string& key);
+    };
+
+    std::filesystem::path directory;
+    asp::Mutex<Memory> memory;
+
+    std::filesystem::path pathForKey(const std::string& key);
+    Handle loadFromDisk(const std::string& key);
+    void saveToDisk(const std::string& key, const HttpCacheEntry& entry);
+};
@@ -0,0 +1,195 @@
+#include "icon_residency.hpp"
+
+#include <hooks/game_manager.hpp>
+#include <managers/settings.hpp>
+#include <util/memory.hpp>
+
+using namespace geode::prelude;
+
+// how often to check whether anything needs to be evicted
+constexpr static float EVICTION_INTERVAL = 1.f;
+
+IconResidencyManager::IconResidencyManager() {}
+
+bool IconResidencyManager::request(int iconId, IconType type, CCObject* owner, Callback callback) {
+    auto* gm = static_cast<HookedGameManager*>(globed::cachedSingleton<GameManager>());
+    int key = gm->keyForIcon(iconId, (int)type);
+
+    if (entries.contains(key)) {
+        auto& entry = entries.at(key);
+
+        if (!entry.loading) {
+            this->touch(entry);
+            return true;
+        }
+
+        entry.waiters.push_back(Waiter { WeakRef(owner), std::move(callback) });
+        return false;
+    }
+
+    // loaded by something else, e.g. preloading or the game itself
+    if (gm->getCachedIcon(iconId, (int)type)) {
+        return true;
+    }
+
+    if (gm->sheetNameForIcon(iconId, (int)type).empty()) {
+        return true;
+    }
+
+    auto& entry = entries.emplace(key, Entry {
+        .iconId = iconId,
+        .type = type,
+    }).first->second;
+
+    entry.waiters.push_back(Waiter { WeakRef(owner), std::move(callback) });
+
+    this->startLoading(key, entry);
+
+    // on android the icon is loaded synchronously, so it may already be done
+    return !entries.at(key).loading;
+}
+
+void IconResidencyManager::acquire(int iconId, IconType type) {
+    int key = globed::cachedSingleton<GameManager>()->keyForIcon(iconId, (int)type);
+
+    if (entries.contains(key)) {
+        entries.at(key).users++;
+    }
+}
+
+void IconResidencyManager::release(int iconId, IconType type) {
+    int key = globed::cachedSingleton<GameManager>()->keyForIcon(iconId, (int)type);
+
+    if (entries.contains(key)) {
+        auto& entry = entries.at(key);
+        entry.users = std::max(entry.users - 1, 0);
+    }
+}
+
+size_t IconResidencyManager::getResidentBytes() {
+    return residentBytes;
+}
+
+size_t IconResidencyManager::getBudgetBytes() {
+    return static_cast<size_t>(GlobedSettings::get().globed.iconMemoryBudget) * 1024 * 1024;
+}
+
+void IconResidencyManager::update(float dt) {
+    sinceEvictionCheck += dt;
+
+    if (sinceEvictionCheck < EVICTION_INTERVAL) {
+        return;
+    }
+
+    sinceEvictionCheck = 0.f;
+    this->evictIfNeeded();
+}
+
+void IconResidencyManager::startLoading(int key, Entry& entry) {
+    auto* gm = globed::cachedSingleton<GameManager>();
+
+#ifdef GEODE_IS_ANDROID
+    // async texture loading is not reliable on android, the icon is still tracked for eviction though
+    gm->loadIcon(entry.iconId, (int)entry.type, -1);
+    this->finishLoading(key);
+#else
+    int tag = nextTag++;
+    pendingLoads[tag] = key;
+
+    auto sheetName = gm->sheetNameForIcon(entry.iconId, (int)entry.type);
+
+    CCTextureCache::sharedTextureCache()->addImageAsync(
+        (sheetName + ".png").c_str(),
+        this,
+        menu_selector(IconResidencyManager::onTextureLoaded),
+        tag,
+        kCCTexture2DPixelFormat_RGBA8888
+    );
+#endif
+}
+
+void IconResidencyManager::onTextureLoaded(CCObject* obj) {
+    auto* texture = static_cast<CCTexture2D*>(obj);
+    int tag = texture->getTag();
+
+    if (!pendingLoads.contains(tag)) {
+        log::warn("icon residency: unknown async load tag {}", tag);
+        return;
+    }
+
+    int key = pendingLoads.at(tag);
+    pendingLoads.erase(tag);
+
+    if (!entries.contains(key)) return;
+
+    auto& entry = entries.at(key);
+
+    // texture is in the texture cache now, this only adds the sprite frames
+    globed::cachedSingleton<GameManager>()->loadIcon(entry.iconId, (int)entry.type, -1);
+
+    this->finishLoading(key);
+}
+
+void IconResidencyManager::finishLoading(int key) {
+    auto* gm = static_cast<HookedGameManager*>(globed::cachedSingleton<GameManager>());
+    auto& entry = entries.at(key);
+
+    auto* texture = gm->getCachedIcon(entry.iconId, (int)entry.type);
+    if (!texture) {
+        log::warn("icon residency: failed to load icon (id: {}, type: {})", entry.iconId, (int)entry.type);
+
+        // callbacks are still invoked so that the placeholder can be replaced by whatever the game has
+        auto waiters = std::move(entry.waiters);
+        entries.erase(key);
+
+        for (auto& waiter : waiters) {
+            if (waiter.owner.lock()) waiter.callback();
+        }
+
+        return;
+    }
+
+    entry.loading = false;
+    entry.bytes = static_cast<size_t>(texture->getPixelsWide()) * texture->getPixelsHigh() * 4;
+    residentBytes += entry.bytes;
+    util::memory::add(util::memory::Tag::IconTextures, entry.bytes);
+
+    lru.push_front(key);
+    entry.lruPos = lru.begin();
+
+    auto waiters = std::move(entry.waiters);
+    for (auto& waiter : waiters) {
+        if (waiter.owner.lock()) waiter.callback();
+    }
+}
+
+void IconResidencyManager::touch(Entry& entry) {
+    lru.splice(lru.begin(), lru, entry.lruPos);
+}
+
+void IconResidencyManager::evictIfNeeded() {
+    size_t budget = this->getBudgetBytes();
+
+    // walk from the least recently used end, skipping icons that are still displayed
+    auto it = lru.end();
+    while (residentBytes > budget && it != lru.begin()) {
+        --it;
+
+        int key = *it;
+        if (entries.at(key).users > 0) continue;
+
+        it = lru.erase(it);
+        this->evict(key);
+    }
+}
+
+void IconResidencyManager::evict(int key) {
+    auto* gm = static_cast<HookedGameManager*>(globed::cachedSingleton<GameManager>());
+    auto& entry = entries.at(key);
+
+    gm->evictIcon(entry.iconId, (int)entry.type);
+
+    residentBytes -= entry.bytes;
+    util::memory::remove(util::memory::Tag::IconTextures, entry.bytes);
+    entries.erase(key);
+}
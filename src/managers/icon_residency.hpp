@@ -0,0 +1,62 @@
+#pragma once
+
+#include <defs/geode.hpp>
+#include <util/singleton.hpp>
+
+#include <list>
+
+// Loads icon sheets for remote players on demand and keeps the memory used by them within a budget.
+// Icons that are in use by at least one player are never evicted, the rest are evicted in least recently used order.
+// Icons that were already loaded by other means (preloading, the game itself) are not tracked.
+// Everything that shows the icon of another player (ComplexVisualPlayer, GlobedSimplePlayer) acquires it while it's displayed.
+class IconResidencyManager : public SingletonNodeBase<IconResidencyManager, true> {
+    friend class SingletonNodeBase;
+
+    IconResidencyManager();
+
+public:
+    using Callback = std::function<void()>;
+
+    // Returns true if the icon is loaded and can be used right away. Otherwise the icon gets queued for loading,
+    // and `callback` is invoked on the main thread once it's loaded, unless `owner` has been destroyed by then.
+    bool request(int iconId, IconType type, cocos2d::CCObject* owner, Callback callback);
+
+    // Marks the icon as used, so that it won't be evicted until every user has released it.
+    void acquire(int iconId, IconType type);
+    void release(int iconId, IconType type);
+
+    size_t getResidentBytes();
+    size_t getBudgetBytes();
+
+    void update(float dt) override;
+
+private:
+    struct Waiter {
+        geode::WeakRef<cocos2d::CCObject> owner;
+        Callback callback;
+    };
+
+    struct Entry {
+        int iconId;
+        IconType type;
+        size_t bytes = 0;
+        int users = 0;
+        bool loading = true;
+        std::vector<Waiter> waiters;
+        std::list<int>::iterator lruPos;
+    };
+
+    std::unordered_map<int, Entry> entries; // key from GameManager::keyForIcon
+    std::list<int> lru; // front is the most recently used, only contains loaded entries
+    std::unordered_map<int, int> pendingLoads; // async load tag -> key
+    size_t residentBytes = 0;
+    int nextTag = 1;
+    float sinceEvictionCheck = 0.f;
+
+    void startLoading(int key, Entry& entry);
+    void onTextureLoaded(cocos2d::CCObject* obj);
+    void finishLoading(int key);
+    void touch(Entry& entry);
+    void evictIfNeeded();
+    void evict(int key);
+};
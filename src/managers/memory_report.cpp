@@ -0,0 +1,45 @@
+#include "memory_report.hpp"
+
+#include <util/format.hpp>
+
+using namespace geode::prelude;
+
+constexpr static float REPORT_INTERVAL = 60.f;
+
+MemoryReporter::MemoryReporter() {}
+
+std::string MemoryReporter::makeReport() {
+    std::string out;
+    size_t total = 0;
+
+    for (auto& usage : util::memory::usageAll()) {
+        out += fmt::format("{}: {} (peak {})\n", usage.name, util::format::formatBytes(usage.current), util::format::formatBytes(usage.peak));
+        total += usage.current;
+    }
+
+    out += fmt::format("Total: {}", util::format::formatBytes(total));
+
+    return out;
+}
+
+void MemoryReporter::update(float dt) {
+    sinceReport += dt;
+
+    if (sinceReport < REPORT_INTERVAL) {
+        return;
+    }
+
+    sinceReport = 0.f;
+
+    auto usage = util::memory::usageAll();
+
+    bool changed = lastReported.size() != usage.size();
+    for (size_t i = 0; !changed && i < usage.size(); i++) {
+        changed = usage[i].current != lastReported[i].current || usage[i].peak != lastReported[i].peak;
+    }
+
+    if (!changed) return;
+
+    lastReported = std::move(usage);
+    log::info("Memory usage:\n{}", makeReport());
+}
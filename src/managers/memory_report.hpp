@@ -0,0 +1,22 @@
+#pragma once
+
+#include <defs/geode.hpp>
+#include <util/memory.hpp>
+#include <util/singleton.hpp>
+
+// Periodically logs the memory usage of every subsystem tracked by `util::memory`, whenever it changed since the last report.
+class MemoryReporter : public SingletonNodeBase<MemoryReporter, true> {
+    friend class SingletonNodeBase;
+
+    MemoryReporter();
+
+public:
+    // One line per subsystem with the current and the peak usage, plus the total
+    static std::string makeReport();
+
+    void update(float dt) override;
+
+private:
+    float sinceReport = 0.f;
+    std::vector<util::memory::Usage> lastReported;
+};
@@ -1,19 +1,196 @@
 #include "profile_cache.hpp"
 
+#include <data/bytebuffer.hpp>
+#include <util/memory.hpp>
+#include <asp/time/SystemTime.hpp>
+
+using namespace asp::time;
+
+static int64_t unixNow() {
+    return static_cast<int64_t>(SystemTime::now().timeSinceEpoch().seconds());
+}
+
+// rough size of a cache entry, the constant is for the shared_ptr control block, the entry and the map and list nodes
+static size_t entrySize(const PlayerAccountData& data) {
+    size_t size = sizeof(PlayerAccountData) + 96;
+
+    if (data.name.capacity() > sizeof(std::string)) {
+        size += data.name.capacity();
+    }
+
+    if (data.specialUserData.roles) {
+        size += data.specialUserData.roles->capacity();
+    }
+
+    return size;
+}
+
+ProfileCacheManager::ProfileCacheManager() {
+    auto result = this->loadFromDisk();
+    if (result.isErr()) {
+        log::warn("Failed to load profile cache: {}", result.unwrapErr());
+        this->clear();
+    }
+}
+
 void ProfileCacheManager::insert(const PlayerAccountData& data) {
-    cache[data.accountId] = data;
+    // if nothing changed, keep the old handle alive instead of reallocating
+    if (cache.contains(data.accountId)) {
+        auto& entry = cache.at(data.accountId);
+
+        if (*entry.data == data) {
+            entry.updatedAt = unixNow();
+            entry.stale = false;
+            this->touch(entry);
+            return;
+        }
+    }
+
+    this->insertEntry(std::make_shared<const PlayerAccountData>(data), unixNow(), false);
 }
 
-std::optional<PlayerAccountData> ProfileCacheManager::getData(int32_t accountId) {
+void ProfileCacheManager::insertEntry(Handle data, int64_t updatedAt, bool stale) {
+    int32_t accountId = data->accountId;
+
+    util::memory::add(util::memory::Tag::ProfileCache, entrySize(*data));
+
     if (cache.contains(accountId)) {
-        return cache.at(accountId);
+        auto& entry = cache.at(accountId);
+        util::memory::remove(util::memory::Tag::ProfileCache, entrySize(*entry.data));
+
+        entry.data = std::move(data);
+        entry.updatedAt = updatedAt;
+        entry.stale = stale;
+        this->touch(entry);
+        return;
+    }
+
+    if (cache.size() >= MAX_ENTRIES) {
+        util::memory::remove(util::memory::Tag::ProfileCache, entrySize(*cache.at(lru.back()).data));
+        cache.erase(lru.back());
+        lru.pop_back();
+    }
+
+    lru.push_front(accountId);
+    cache.emplace(accountId, Entry {
+        .data = std::move(data),
+        .updatedAt = updatedAt,
+        .stale = stale,
+        .lruPos = lru.begin(),
+    });
+}
+
+void ProfileCacheManager::touch(Entry& entry) {
+    lru.splice(lru.begin(), lru, entry.lruPos);
+}
+
+ProfileCacheManager::Handle ProfileCacheManager::getData(int32_t accountId) {
+    auto it = cache.find(accountId);
+    if (it == cache.end()) {
+        return nullptr;
     }
 
-    return std::nullopt;
+    this->touch(it->second);
+    return it->second.data;
 }
 
 void ProfileCacheManager::clear() {
+    for (auto& [_, entry] : cache) {
+        util::memory::remove(util::memory::Tag::ProfileCache, entrySize(*entry.data));
+    }
+
     cache.clear();
+    lru.clear();
+}
+
+bool ProfileCacheManager::shouldRevalidate(int32_t accountId) {
+    auto it = cache.find(accountId);
+    if (it == cache.end() || !it->second.stale) {
+        return false;
+    }
+
+    // if the request fails, the entry simply stays as is until the next session
+    it->second.stale = false;
+    return true;
+}
+
+std::filesystem::path ProfileCacheManager::cachePath() {
+    return Mod::get()->getSaveDir() / "profile-cache.bin";
+}
+
+void ProfileCacheManager::saveToDisk() {
+    ByteBuffer bb;
+    bb.writeU32(FILE_MAGIC);
+    bb.writeU16(FILE_VERSION);
+    bb.writeU32(cache.size());
+
+    // least recently used first, so that loading it back preserves the order
+    for (auto it = lru.rbegin(); it != lru.rend(); it++) {
+        auto& entry = cache.at(*it);
+        bb.writeI64(entry.updatedAt);
+        bb.writeValue(*entry.data);
+    }
+
+    auto path = this->cachePath();
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        log::warn("Failed to open {} for writing", path);
+        return;
+    }
+
+    file.write(reinterpret_cast<const char*>(bb.data().data()), bb.size());
+}
+
+Result<> ProfileCacheManager::loadFromDisk() {
+    auto path = this->cachePath();
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        return Ok();
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return Err("Failed to open file");
+    }
+
+    util::data::bytevector data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ByteBuffer bb(std::move(data));
+
+    auto result = [&]() -> ByteBuffer::DecodeResult<> {
+        GLOBED_UNWRAP_INTO(bb.readU32(), auto magic);
+        GLOBED_UNWRAP_INTO(bb.readU16(), auto version);
+
+        // a different version is not an error, the cache is just thrown away
+        if (magic != FILE_MAGIC || version != FILE_VERSION) {
+            return Ok();
+        }
+
+        GLOBED_UNWRAP_INTO(bb.readU32(), auto count);
+
+        int64_t now = unixNow();
+
+        for (size_t i = 0; i < count; i++) {
+            GLOBED_UNWRAP_INTO(bb.readI64(), auto updatedAt);
+            GLOBED_UNWRAP_INTO(bb.readValue<PlayerAccountData>(), auto accountData);
+
+            if (now - updatedAt > MAX_ENTRY_AGE) {
+                continue;
+            }
+
+            this->insertEntry(std::make_shared<const PlayerAccountData>(std::move(accountData)), updatedAt, true);
+        }
+
+        return Ok();
+    }();
+
+    if (result.isErr()) {
+        return Err(ByteBuffer::strerror(result.unwrapErr()));
+    }
+
+    log::debug("Loaded {} profiles from the profile cache", cache.size());
+
+    return Ok();
 }
 
 void ProfileCacheManager::setOwnDataAuto() {
@@ -87,3 +264,7 @@ SpecialUserData& ProfileCacheManager::getOwnSpecialData() {
 bool ProfileCacheManager::changedAccount(int newAccountId) {
     return inited && ownData.accountId != newAccountId;
 }
+
+$on_mod(DataSaved) {
+    ProfileCacheManager::get().saveToDisk();
+}
@@ -5,12 +5,34 @@
 #include <data/types/gd.hpp>
 #include <util/singleton.hpp>
 
+#include <list>
+
+/*
+* ProfileCacheManager keeps the account data of other players, bounded by an LRU policy.
+* The cache is written to disk whenever the mod data is saved and read back on startup,
+* entries loaded from disk are served immediately but are considered stale until they are refetched.
+*/
 class ProfileCacheManager : public SingletonBase<ProfileCacheManager> {
+protected:
+    friend class SingletonBase;
+    ProfileCacheManager();
+
 public:
+    using Handle = std::shared_ptr<const PlayerAccountData>;
+
+    static constexpr size_t MAX_ENTRIES = 1024;
+
     void insert(const PlayerAccountData& data);
-    std::optional<PlayerAccountData> getData(int32_t accountId);
+    // returns nullptr if there is no data for this player.
+    // the handle stays valid even if the entry gets evicted or replaced.
+    Handle getData(int32_t accountId);
     void clear();
 
+    // returns true once for every stale entry, so that the caller can request fresh data
+    bool shouldRevalidate(int32_t accountId);
+
+    void saveToDisk();
+
     // gather player's icons and call `setOwnData`;
     void setOwnDataAuto();
     void setOwnData(const PlayerIconData& data);
@@ -24,8 +46,26 @@ public:
     bool pendingChanges = false;
 
 private:
-    std::unordered_map<int32_t, PlayerAccountData> cache;
+    static constexpr uint32_t FILE_MAGIC = 0x47504331; // GPC1
+    static constexpr uint16_t FILE_VERSION = 1;
+    // entries older than this are not loaded from disk at all
+    static constexpr int64_t MAX_ENTRY_AGE = 60 * 60 * 24 * 14;
+
+    struct Entry {
+        Handle data;
+        int64_t updatedAt; // unix timestamp of when this profile was received from the server
+        bool stale;        // loaded from disk, and not refreshed yet in this session
+        std::list<int32_t>::iterator lruPos;
+    };
+
+    std::unordered_map<int32_t, Entry> cache;
+    std::list<int32_t> lru; // most recently used at the front
     PlayerAccountData ownData;
     SpecialUserData ownSpecialData;
     bool inited = false;
-};
\ No newline at end of file
+
+    void insertEntry(Handle data, int64_t updatedAt, bool stale);
+    void touch(Entry& entry);
+    Result<> loadFromDisk();
+    std::filesystem::path cachePath();
+};
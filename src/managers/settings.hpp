@@ -58,6 +58,8 @@ public:
         Arg<"globed-fake-server-data"> fakeData;
         Arg<"globed-reset-settings"> resetSettings;
         Arg<"globed-dev-stuff"> devStuff;
+        Arg<"globed-profiler"> profiler;
+        Arg<"globed-synthetic-crowd"> syntheticCrowd;
     };
 
 private:
@@ -259,10 +261,14 @@ public:
         Setting<bool, true> autoconnect;
         Setting<bool, true> preloadAssets;
         Setting<bool, false> deferPreloadAssets;
+        Setting<bool, true> preloadTextureCache;
+        LimitedSetting<int, 128, 16, 1024> iconMemoryBudget; // in megabytes, only applies when icons are not preloaded
+        LimitedSetting<int, 4, 1, 16> frameBudget; // in milliseconds, how long deferrable work can take each frame
         LimitedEnumSetting<InvitesFrom, InvitesFrom::Friends, InvitesFrom::Everyone, InvitesFrom::Nobody> invitesFrom;
         Setting<bool, true> editorSupport;
         Setting<bool, false> increaseLevelList;
         Setting<int, 0> fragmentationLimit;
+        Setting<bool, false> reliableUdp;
         Setting<bool, false> compressedPlayerCount;
         Setting<bool, true> useDiscordRPC;
         Setting<bool, true> changelogPopups;
@@ -284,6 +290,7 @@ public:
         LimitedSetting<float, 0.3f, 0.f, 1.f> opacity;
         Setting<bool, true> hideConditionally;
         LimitedSetting<int, 3, 0, 3> position; // 0-3 topleft, topright, bottomleft, bottomright
+        Setting<bool, false> packetStats;
     };
 
     struct Communication {
@@ -296,6 +303,7 @@ public:
         Setting<int, 0> audioDevice;
         Setting<bool, true> deafenNotification;
         Setting<bool, false> voiceLoopback; // TODO unimpl
+        LimitedSetting<int, 8, 0, 64> maxVoiceStreams; // 0 means unlimited
     };
 
     struct LevelUI {
@@ -319,6 +327,7 @@ public:
         Setting<bool, false> ownName;
         Setting<bool, false> rotateNames;
         Setting<bool, false> hidePracticePlayers;
+        Setting<bool, true> simplifyDistant;
     };
 
     struct Advanced {};
@@ -420,22 +429,22 @@ private:
 // Launch args
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::LaunchArgs, (
-    crtFix, netDump, verboseCurl, skipPreload, debugPreload, skipResourceCheck, tracing, noSslVerification, fakeData, resetSettings, devStuff
+    crtFix, netDump, verboseCurl, skipPreload, debugPreload, skipResourceCheck, tracing, noSslVerification, fakeData, resetSettings, devStuff, profiler, syntheticCrowd
 ));
 
 // Settings
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Globed, (
-    autoconnect, preloadAssets, deferPreloadAssets, invitesFrom, editorSupport, increaseLevelList, fragmentationLimit, compressedPlayerCount, useDiscordRPC, editorChanges, changelogPopups, pinnedLevelCollapsed,
+    autoconnect, preloadAssets, deferPreloadAssets, preloadTextureCache, iconMemoryBudget, frameBudget, invitesFrom, editorSupport, increaseLevelList, fragmentationLimit, reliableUdp, compressedPlayerCount, useDiscordRPC, editorChanges, changelogPopups, pinnedLevelCollapsed,
     isInvisible, noInvites, hideInGame, hideRoles
 ));
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Overlay, (
-    enabled, opacity, hideConditionally, position
+    enabled, opacity, hideConditionally, position, packetStats
 ));
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Communication, (
-    voiceEnabled, voiceProximity, classicProximity, voiceVolume, onlyFriends, lowerAudioLatency, audioDevice, deafenNotification, voiceLoopback
+    voiceEnabled, voiceProximity, classicProximity, voiceVolume, onlyFriends, lowerAudioLatency, audioDevice, deafenNotification, voiceLoopback, maxVoiceStreams
 ));
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::LevelUI, (
@@ -443,7 +452,7 @@ GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::LevelUI, (
 ));
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Players, (
-    playerOpacity, showNames, dualName, nameOpacity, statusIcons, deathEffects, defaultDeathEffect, hideNearby, forceVisibility, ownName, hidePracticePlayers, rotateNames
+    playerOpacity, showNames, dualName, nameOpacity, statusIcons, deathEffects, defaultDeathEffect, hideNearby, forceVisibility, ownName, hidePracticePlayers, rotateNames, simplifyDistant
 ));
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Advanced, ());
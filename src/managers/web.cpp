@@ -127,7 +127,9 @@ RequestTask WebRequestManager::testServer(std::string_view url) {
 }
 
 RequestTask WebRequestManager::fetchCredits() {
-    return this->get("https://credits.globed.dev/credits");
+    return this->get("https://credits.globed.dev/credits", 10, [](CurlRequest& req) {
+        req.cache(CurlCachePolicy::StaleWhileRevalidate);
+    });
 }
 
 RequestTask WebRequestManager::fetchServers(std::string_view urlOverride) {
@@ -139,20 +141,44 @@ RequestTask WebRequestManager::fetchServers(std::string_view urlOverride) {
 }
 
 RequestTask WebRequestManager::fetchServerMeta(std::string_view urlOverride) {
-    auto url = urlOverride.empty() ? makeCentralUrl("v3/meta") : makeUrl(urlOverride, "v3/meta");
+    // overrides are only used for testing servers, so they are never cached
+    if (!urlOverride.empty()) {
+        return this->get(makeUrl(urlOverride, "v3/meta"), 10, [&](CurlRequest& req) {
+            req.param("protocol", NetworkManager::get().getUsedProtocol());
+        });
+    }
 
-    return this->get(url, 10, [&](CurlRequest& req) {
-        req.param("protocol", NetworkManager::get().getUsedProtocol());
-    });
+    auto request = makeServerMetaRequest();
+    return mapTask(request.timeout(Duration::fromSecs(10)).send());
+}
+
+std::optional<CurlResponse> WebRequestManager::getCachedServerMeta() {
+    return CurlManager::get().getCached(makeServerMetaRequest());
+}
+
+void WebRequestManager::invalidateCachedServerMeta() {
+    CurlManager::get().invalidateCached(makeServerMetaRequest());
+}
+
+CurlRequest WebRequestManager::makeServerMetaRequest() {
+    auto request = CurlRequest();
+    request.get(makeCentralUrl("v3/meta"));
+    request.param("protocol", NetworkManager::get().getUsedProtocol());
+    request.cache(CurlCachePolicy::Revalidate);
+
+    return request;
 }
 
 RequestTask WebRequestManager::fetchFeaturedLevel() {
-    return this->get(makeCentralUrl("flevel/current"));
+    return this->get(makeCentralUrl("flevel/current"), 10, [](CurlRequest& req) {
+        req.cache(CurlCachePolicy::Revalidate);
+    });
 }
 
 RequestTask WebRequestManager::fetchFeaturedLevelHistory(int page) {
     return this->get(makeCentralUrl("flevel/historyv2"), 10, [&](CurlRequest& req) {
         req.param("page", page);
+        req.cache(CurlCachePolicy::StaleWhileRevalidate);
     });
 }
 
@@ -23,6 +23,9 @@ public:
     Task fetchCredits();
     [[deprecated]] Task fetchServers(std::string_view urlOverride = {});
     Task fetchServerMeta(std::string_view urlOverride = {});
+    // the last server meta response for the active central server, if there is one on disk
+    std::optional<CurlResponse> getCachedServerMeta();
+    void invalidateCachedServerMeta();
     Task fetchFeaturedLevel();
     Task fetchFeaturedLevelHistory(int page);
     Task setFeaturedLevel(int levelId, int rateTier, std::string_view levelName, std::string_view levelAuthor, int difficulty);
@@ -35,6 +38,8 @@ public:
     Task testCloudflareDomainTrace(std::string_view domain);
 
 private:
+    CurlRequest makeServerMetaRequest();
+
     Task get(std::string_view url);
     Task get(std::string_view url, int timeoutS);
     Task get(std::string_view url, int timeoutS, std::function<void(CurlRequest&)> additional);
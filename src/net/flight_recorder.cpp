@@ -0,0 +1,179 @@
+#include "flight_recorder.hpp"
+
+#include <data/bytebuffer.hpp>
+
+#include <fstream>
+
+using namespace geode::prelude;
+
+NetFlightRecorder::NetFlightRecorder() : epoch(std::chrono::steady_clock::now()) {}
+
+void NetFlightRecorder::record(Event event, uint32_t a, uint64_t b, uint64_t c) {
+    uint64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+
+    records.push(Record { timestamp, event, a, b, c });
+}
+
+Result<std::filesystem::path> NetFlightRecorder::dump(std::string_view name) {
+    // disconnects can happen on multiple threads at once, and they all dump to the same file
+    auto _lock = dumpMutex.lock();
+
+    auto threads = records.snapshot();
+
+    ByteBuffer bb;
+    bb.writeU32(FILE_MAGIC);
+    bb.writeU16(FILE_VERSION);
+    bb.writeU32(threads.size());
+
+    for (auto& thread : threads) {
+        bb.writeValue(thread.threadName);
+        bb.writeU32(thread.entries.size());
+
+        for (auto& rec : thread.entries) {
+            bb.writeU64(rec.timestamp);
+            bb.writeU32((uint32_t) rec.event);
+            bb.writeU32(rec.a);
+            bb.writeU64(rec.b);
+            bb.writeU64(rec.c);
+        }
+    }
+
+    auto path = Mod::get()->getSaveDir() / fmt::format("{}.bin", name);
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return Err(fmt::format("failed to open {}", path));
+    }
+
+    file.write(reinterpret_cast<const char*>(bb.data().data()), bb.size());
+
+    if (!file) {
+        return Err(fmt::format("failed to write to {}", path));
+    }
+
+    return Ok(path);
+}
+
+const char* NetFlightRecorder::eventName(Event event) {
+    switch (event) {
+        case Event::Poll: return "Poll";
+        case Event::TcpReceive: return "TcpReceive";
+        case Event::TcpSend: return "TcpSend";
+        case Event::UdpReceive: return "UdpReceive";
+        case Event::UdpSend: return "UdpSend";
+        case Event::UdpFrame: return "UdpFrame";
+        case Event::PacketEncoded: return "PacketEncoded";
+        case Event::PacketDecoded: return "PacketDecoded";
+        case Event::PacketDecodeFailed: return "PacketDecodeFailed";
+        case Event::PacketDispatched: return "PacketDispatched";
+        case Event::SendQueued: return "SendQueued";
+        case Event::IncomingQueueDepth: return "IncomingQueueDepth";
+        case Event::SocketError: return "SocketError";
+        case Event::StateChange: return "StateChange";
+        case Event::Disconnect: return "Disconnect";
+    }
+
+    return "Unknown";
+}
+
+static const char* errorSiteName(NetFlightRecorder::ErrorSite site) {
+    using enum NetFlightRecorder::ErrorSite;
+
+    switch (site) {
+        case Poll: return "poll";
+        case TcpReceive: return "tcp receive";
+        case TcpSend: return "tcp send";
+        case UdpReceive: return "udp receive";
+        case UdpSend: return "udp send";
+        case Decode: return "decode";
+    }
+
+    return "unknown";
+}
+
+static std::string formatArgs(NetFlightRecorder::Event event, uint32_t a, uint64_t b, uint64_t c) {
+    using Event = NetFlightRecorder::Event;
+
+    switch (event) {
+        case Event::Poll: {
+            constexpr const char* results[] = {"none", "tcp", "udp", "tcp+udp"};
+            return fmt::format("timeout = {}ms, result = {}", a, b < 4 ? results[b] : "?");
+        }
+        case Event::TcpReceive: return fmt::format("requested = {}, result = {}", a, (int64_t) b);
+        case Event::TcpSend: return fmt::format("bytes = {}, result = {}", a, (int64_t) b);
+        case Event::UdpReceive: return fmt::format("bytes = {}, from server = {}", a, b != 0);
+        case Event::UdpSend: return fmt::format("bytes = {}, result = {}", a, (int64_t) b);
+        case Event::UdpFrame: return fmt::format("marker = {}", a);
+        case Event::PacketEncoded: return fmt::format("id = {}, encrypted = {}, size = {}", a, b != 0, c);
+        case Event::PacketDecoded:
+            return fmt::format("id = {}, encrypted = {}, length = {}, took {}us", a, (b & 1) != 0, b >> 1, c);
+        case Event::PacketDecodeFailed: return fmt::format("id = {}", a);
+        case Event::PacketDispatched: return fmt::format("id = {}, dispatch took {}us", a, b);
+        case Event::SendQueued: return fmt::format("id = {}, queue depth = {}", a, b);
+        case Event::IncomingQueueDepth: return fmt::format("depth = {}", a);
+        case Event::SocketError:
+            return fmt::format("{} failed, code = {}", errorSiteName((NetFlightRecorder::ErrorSite) a), (int64_t) b);
+        case Event::StateChange: return fmt::format("state = {}", a);
+        case Event::Disconnect: return fmt::format("quiet = {}", a != 0);
+    }
+
+    return fmt::format("{}, {}, {}", a, b, c);
+}
+
+Result<std::string> NetFlightRecorder::decode(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return Err(fmt::format("failed to open {}", path));
+    }
+
+    util::data::bytevector data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ByteBuffer bb(std::move(data));
+
+    std::string out;
+
+    // false if the file is not a flight recorder dump, or is from a different version
+    auto result = [&]() -> ByteBuffer::DecodeResult<bool> {
+        GLOBED_UNWRAP_INTO(bb.readU32(), auto magic);
+        GLOBED_UNWRAP_INTO(bb.readU16(), auto version);
+
+        if (magic != FILE_MAGIC || version != FILE_VERSION) {
+            return Ok(false);
+        }
+
+        GLOBED_UNWRAP_INTO(bb.readU32(), auto threadCount);
+
+        for (size_t t = 0; t < threadCount; t++) {
+            GLOBED_UNWRAP_INTO(bb.readValue<std::string>(), auto threadName);
+            GLOBED_UNWRAP_INTO(bb.readU32(), auto count);
+
+            out += fmt::format("=== {} ({} events) ===\n", threadName.empty() ? "unnamed thread" : threadName, count);
+
+            for (size_t i = 0; i < count; i++) {
+                GLOBED_UNWRAP_INTO(bb.readU64(), auto timestamp);
+                GLOBED_UNWRAP_INTO(bb.readU32(), auto event);
+                GLOBED_UNWRAP_INTO(bb.readU32(), auto a);
+                GLOBED_UNWRAP_INTO(bb.readU64(), auto b);
+                GLOBED_UNWRAP_INTO(bb.readU64(), auto c);
+
+                out += fmt::format(
+                    "[{:.6f}] {}: {}\n",
+                    timestamp / 1'000'000'000.0, eventName((Event) event), formatArgs((Event) event, a, b, c)
+                );
+            }
+
+            out += '\n';
+        }
+
+        return Ok(true);
+    }();
+
+    if (result.isErr()) {
+        return Err(fmt::format("failed to decode {}: {}", path, ByteBuffer::strerror(result.unwrapErr())));
+    }
+
+    if (!result.unwrap()) {
+        return Err(fmt::format("{} is not a network flight recording (or is from another version)", path));
+    }
+
+    return Ok(std::move(out));
+}
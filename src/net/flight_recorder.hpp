@@ -0,0 +1,80 @@
+#pragma once
+
+#include <defs/geode.hpp>
+#include <util/per_thread_ring.hpp>
+#include <util/singleton.hpp>
+
+#include <asp/sync.hpp>
+
+#include <filesystem>
+
+/*
+* Always-on recorder of network events, meant for debugging issues that go away as soon as you start logging.
+* Every thread writes fixed-size binary records into its own ring buffer, nothing gets formatted until the recording is dumped.
+* The recording is dumped to the save directory on every disconnect, and can also be dumped on demand.
+*/
+class NetFlightRecorder : public SingletonLeakBase<NetFlightRecorder> {
+    friend class SingletonLeakBase;
+
+    NetFlightRecorder();
+
+public:
+    // The meaning of the arguments is listed next to each event
+    enum class Event : uint32_t {
+        Poll,               // a = timeout (ms), b = result (0 none, 1 tcp, 2 udp, 3 both)
+        TcpReceive,         // a = requested bytes, b = result
+        TcpSend,            // a = bytes, b = result
+        UdpReceive,         // a = bytes, b = from connected address
+        UdpSend,            // a = bytes, b = result
+        UdpFrame,           // a = marker
+        PacketEncoded,      // a = packet id, b = encrypted, c = size
+        PacketDecoded,      // a = packet id, b = encrypted | (length << 1), c = decode time (us)
+        PacketDecodeFailed, // a = packet id
+        PacketDispatched,   // a = packet id, b = time spent running the listeners (us)
+        SendQueued,         // a = packet id, b = send queue depth
+        IncomingQueueDepth, // a = depth of the incoming packet queue
+        SocketError,        // a = ErrorSite, b = error code
+        StateChange,        // a = new connection state
+        Disconnect,         // a = quiet
+    };
+
+    enum class ErrorSite : uint32_t {
+        Poll, TcpReceive, TcpSend, UdpReceive, UdpSend, Decode,
+    };
+
+    static constexpr uint32_t FILE_MAGIC = 0x474e4652; // GNFR
+    static constexpr uint16_t FILE_VERSION = 1;
+
+    void record(Event event, uint32_t a = 0, uint64_t b = 0, uint64_t c = 0);
+
+    // Writes the records of every thread to a file in the save directory and returns its path.
+    // `name` is used as the file name, so dumps with the same name overwrite each other.
+    geode::Result<std::filesystem::path> dump(std::string_view name);
+
+    // Turns a dump back into text, one event per line
+    static geode::Result<std::string> decode(const std::filesystem::path& path);
+
+    static const char* eventName(Event event);
+
+private:
+    struct Record {
+        uint64_t timestamp; // nanoseconds since the recorder was created
+        Event event;
+        uint32_t a;
+        uint64_t b;
+        uint64_t c;
+    };
+
+    // 8192 records are 256 KB per thread, which is at least several seconds on the busiest thread
+    static constexpr size_t BUFFER_CAPACITY = 1 << 13;
+
+    std::chrono::steady_clock::time_point epoch;
+    util::collections::PerThreadRing<Record, BUFFER_CAPACITY> records;
+    asp::Mutex<> dumpMutex;
+};
+
+namespace globed {
+    inline void netRecord(NetFlightRecorder::Event event, uint32_t a = 0, uint64_t b = 0, uint64_t c = 0) {
+        NetFlightRecorder::get().record(event, a, b, c);
+    }
+}
@@ -2,12 +2,17 @@
 
 #include <data/bytebuffer.hpp>
 #include <data/packets/match.hpp>
+#include <globed/profiler.hpp>
+#include <net/flight_recorder.hpp>
+#include <net/packet_capture.hpp>
+#include <net/packet_stats.hpp>
 #include <managers/settings.hpp>
 #include <util/debug.hpp>
 #include <util/net.hpp>
-#include <util/format.hpp>
 #include <util/crypto.hpp>
 
+#include <asp/time/Instant.hpp>
+
 #ifdef GEODE_IS_WINDOWS
 # include <WinSock2.h>
 #else
@@ -23,6 +28,13 @@ using namespace asp::time;
 using PollResult = GameSocket::PollResult;
 using Protocol = GameSocket::Protocol;
 using ReceivedPacket = GameSocket::ReceivedPacket;
+using NetEvent = NetFlightRecorder::Event;
+using ErrorSite = NetFlightRecorder::ErrorSite;
+
+// connection packets always go over tcp, the session on the server is tied to that connection
+static bool isConnectionPacket(packetid_t id) {
+    return id / 1000 == 10;
+}
 
 GameSocket::GameSocket() {
     globed::netLog("GameSocket: created new socket with bufsize={}", DATA_BUF_SIZE);
@@ -66,6 +78,19 @@ void GameSocket::disconnect() {
     tcpSocket.disconnect();
     udpSocket.disconnect();
     udpBuffer.clear();
+
+    reliable.lock()->reset();
+    reliableRequested = false;
+    reliableHelloAttempts = 0;
+    receiveResetPending = true;
+}
+
+void GameSocket::applyPendingReset() {
+    if (!receiveResetPending) return;
+
+    receiveResetPending = false;
+    reliableReady.clear();
+    awaitingFrames = false;
 }
 
 bool GameSocket::isConnected() {
@@ -80,26 +105,24 @@ Result<std::shared_ptr<Packet>> GameSocket::recvPacketTCP() {
     GLOBED_UNWRAP(tcpSocket.recvExact(reinterpret_cast<char*>(bb.data().data()), 4));
 
     auto packetSize = bb.readU32().unwrapOr(0); // must always be 4 bytes so cant error
-    globed::netLog("GameSocket::recvPacketTCP received message length, {} bytes", packetSize);
 
     GLOBED_REQUIRE_SAFE(packetSize < DATA_BUF_SIZE, "packet is too big, rejecting")
 
     GLOBED_UNWRAP(tcpSocket.recvExact(reinterpret_cast<char*>(dataBuffer), packetSize));
 
-    globed::netLog("GameSocket::recvPacketTCP received entirety of the message, decoding!");
-
     ByteBuffer buf(dataBuffer, packetSize);
 
-    auto retval = this->decodePacket(buf);
+    auto retval = this->decodePacket(buf, Protocol::Tcp);
     if (retval) {
-        auto& pkt = retval.unwrap();
-        PacketLogger::get().record(pkt->getPacketId(), pkt->getEncrypted(), false, buf.size());
+        PacketStats::get().record(*retval.unwrap(), PacketStats::Direction::Incoming, packetSize);
     }
 
     return retval;
 }
 
 Result<std::optional<ReceivedPacket>> GameSocket::recvPacketUDP(bool skipMarker) {
+    this->applyPendingReset();
+
     auto recvResult = udpSocket.receive(reinterpret_cast<char*>(dataBuffer), DATA_BUF_SIZE);
 
     ReceivedPacket out;
@@ -121,20 +144,20 @@ Result<std::optional<ReceivedPacket>> GameSocket::recvPacketUDP(bool skipMarker)
         }
 #endif
 
-        globed::netLog("GameSocket::recvPacketUDP fail: code {}", recvResult.result);
+        globed::netRecord(NetEvent::SocketError, (uint32_t) ErrorSite::UdpReceive, code);
         return Err(fmt::format("udp recv failed ({}): {}", recvResult.result, util::net::lastErrorString(code)));
     }
 
-    globed::netLog("GameSocket::recvPacketUDP received {} bytes (fromConnected = {})", (size_t)recvResult.result, out.fromConnected);
+    globed::netRecord(NetEvent::UdpReceive, recvResult.result, out.fromConnected);
 
     ByteBuffer buf(dataBuffer, (size_t)recvResult.result);
 
     // if not from active server, dont't read the marker
     if (!out.fromConnected || skipMarker) {
-        GLOBED_UNWRAP_INTO(this->decodePacket(buf), out.packet);
+        GLOBED_UNWRAP_INTO(this->decodePacket(buf, Protocol::Udp), out.packet);
 
         if (out.packet) {
-            PacketLogger::get().record(out.packet->getPacketId(), out.packet->getEncrypted(), false, buf.size());
+            PacketStats::get().record(*out.packet, PacketStats::Direction::Incoming, recvResult.result);
         }
 
         return Ok(std::move(out));
@@ -147,30 +170,63 @@ Result<std::optional<ReceivedPacket>> GameSocket::recvPacketUDP(bool skipMarker)
         return Err(fmt::to_string(marker.unwrapErr()));
     }
 
-    globed::netLog("GameSocket::recvPacketUDP marker = {:X}", (int) *marker);
+    globed::netRecord(NetEvent::UdpFrame, *marker);
+
+    size_t packetSize = buf.size() - buf.getPosition();
+    bool fragmented = false;
+    awaitingFrames = false;
 
     if (*marker == MARKER_UDP_PACKET) {
-        GLOBED_UNWRAP_INTO(this->decodePacket(buf), out.packet);
+        GLOBED_UNWRAP_INTO(this->decodePacket(buf, Protocol::Udp), out.packet);
     } else if (*marker == MARKER_UDP_FRAME) {
         GLOBED_UNWRAP_INTO(udpBuffer.pushFrameFromBuffer(buf), auto maybeBuf);
         if (!maybeBuf.empty()) {
+            packetSize = maybeBuf.size();
+            fragmented = true;
+
             ByteBuffer toDecode(std::move(maybeBuf));
-            GLOBED_UNWRAP_INTO(this->decodePacket(toDecode), out.packet);
+            GLOBED_UNWRAP_INTO(this->decodePacket(toDecode, Protocol::Udp), out.packet);
         } else {
+            awaitingFrames = true;
+            return Ok(std::nullopt);
+        }
+    } else if (*marker == ReliableChannel::MARKER) {
+        // stats are recorded for every completed packet in handleReliableFrame
+        GLOBED_UNWRAP(this->handleReliableFrame(buf));
+
+        if (reliableReady.empty()) {
             return Ok(std::nullopt);
         }
+
+        out.packet = std::move(reliableReady.front());
+        reliableReady.pop_front();
+
+        return Ok(std::move(out));
     } else {
         return Err("invalid marker at the start of a udp packet");
     }
 
     if (out.packet) {
-        PacketLogger::get().record(out.packet->getPacketId(), out.packet->getEncrypted(), false, buf.size());
+        PacketStats::get().record(*out.packet, PacketStats::Direction::Incoming, packetSize, fragmented);
     }
 
     return Ok(std::move(out));
 }
 
 Result<ReceivedPacket> GameSocket::recvPacket(int timeoutMs) {
+    this->applyPendingReset();
+
+    // a single reliable frame can complete multiple packets, if it filled a gap
+    if (!reliableReady.empty()) {
+        auto packet = std::move(reliableReady.front());
+        reliableReady.pop_front();
+
+        return Ok(ReceivedPacket {
+            .packet = std::move(packet),
+            .fromConnected = true
+        });
+    }
+
     // negative value means poll indefinitely until either tcp or udp receives data
     GLOBED_UNWRAP_INTO(this->poll(timeoutMs), auto pollResult);
 
@@ -178,8 +234,6 @@ Result<ReceivedPacket> GameSocket::recvPacket(int timeoutMs) {
         return Err("timed out");
     }
 
-    globed::netLog("GameSocket::recvPacket successful poll on {}, trying to receive", (int) pollResult);
-
     // prioritize TCP, if the result is Tcp or Both, we care about TCP.
     if (pollResult != PollResult::Udp) {
         // It is possible that the tcp socket was disconnected in the middle of the poll,
@@ -196,8 +250,6 @@ Result<ReceivedPacket> GameSocket::recvPacket(int timeoutMs) {
             if (res) {
                 auto pkt = std::move(res).unwrap();
 
-                globed::netLog("GameSocket::recvPacket returning received TCP packet (id = {})", pkt ? pkt->getPacketId() : 0);
-
                 return Ok(ReceivedPacket {
                     .packet = std::move(pkt),
                     .fromConnected = true
@@ -214,19 +266,18 @@ Result<ReceivedPacket> GameSocket::recvPacket(int timeoutMs) {
 
     if (udpres && udpres.unwrap().has_value()) {
         auto pkt = std::move(**udpres);
-        globed::netLog(
-            "GameSocket::recvPacket returning received UDP packet (id = {}, fromConnected = {})",
-            pkt.packet ? pkt.packet->getPacketId() : 0, pkt.fromConnected
-        );
         return Ok(std::move(pkt));
     } else if (!udpres) {
         globed::netLog("GameSocket::recvPacket error receiving UDP packet: {}", udpres.unwrapErr());
         return Err("recvPacketUDP failed: {}", udpres.unwrapErr());
     }
 
-    // if it was a frame keep trying
-    globed::netLog("GameSocket::recvPacket UDP frame was received, waiting for other frames..");
+    // acks and reliable frames that are out of order, no need to wait for anything else
+    if (!awaitingFrames) {
+        return Err("timed out");
+    }
 
+    // if it was a frame keep trying
     for (;;) {
         GLOBED_UNWRAP_INTO(udpSocket.poll(25), auto pollres);
         if (!pollres) {
@@ -237,18 +288,10 @@ Result<ReceivedPacket> GameSocket::recvPacket(int timeoutMs) {
         auto udpres = this->recvPacketUDP();
         if (udpres && udpres.unwrap().has_value()) {
             auto pkt = std::move(**udpres);
-
-            globed::netLog(
-                "GameSocket::recvPacket returning received UDP (frame!) packet (id = {}, fromConnected = {})",
-                pkt.packet ? pkt.packet->getPacketId() : 0, pkt.fromConnected
-            );
-
             return Ok(std::move(pkt));
         } else if (!udpres) {
             globed::netLog("GameSocket::recvPacket error receiving (frame!) UDP packet: {}", udpres.unwrapErr());
             return Err(fmt::format("recvPacketUDP failed: {}", std::move(std::move(udpres).unwrapErr())));
-        } else {
-            globed::netLog("GameSocket::recvPacket received UDP frame but message is incomplete, looping..");
         }
     }
 }
@@ -260,8 +303,6 @@ Result<ReceivedPacket> GameSocket::recvPacket() {
 Result<> GameSocket::sendPacket(std::shared_ptr<Packet> packet, Protocol protocol) {
     GLOBED_REQUIRE_SAFE(this->isConnected(), "attempting to send a packet while disconnected")
 
-    globed::netLog("GameSocket::sendPacket(packet={{id={}, encrypted={}}}, protocol={})", packet->getPacketId(), packet->getEncrypted(), (int) protocol);
-
     bool useTcp = false;
     switch (protocol) {
         case Protocol::Tcp: useTcp = true; break;
@@ -269,18 +310,28 @@ Result<> GameSocket::sendPacket(std::shared_ptr<Packet> packet, Protocol protoco
         default: useTcp = packet->getUseTcp(); break;
     }
 
+    // when the server supports it, reliable packets go over udp, unless the caller explicitly wants tcp
+    bool reliableUdp = useTcp
+        && protocol == Protocol::Unspecified
+        && !isConnectionPacket(packet->getPacketId())
+        && this->isReliableActive();
+
+    if (reliableUdp) {
+        useTcp = false;
+    }
+
     ByteBuffer buf;
     GLOBED_UNWRAP(this->encodePacket(*packet, buf, useTcp))
 
     if (dumpPackets) {
-        this->dumpPacket(packet->getPacketId(), buf, true);
+        this->capturePacket(PacketCapture::Direction::Outgoing, useTcp ? Protocol::Tcp : Protocol::Udp, false, buf, 0);
     }
 
-#ifdef GLOBED_DEBUG_PACKETS
-    PacketLogger::get().record(packet->getPacketId(), packet->getEncrypted(), true, buf.size());
-#endif
+    PacketStats::get().record(*packet, PacketStats::Direction::Outgoing, buf.size());
 
-    if (useTcp) {
+    if (reliableUdp) {
+        GLOBED_UNWRAP(this->sendReliable(*packet, buf));
+    } else if (useTcp) {
         GLOBED_UNWRAP(tcpSocket.sendAll(reinterpret_cast<const char*>(buf.data().data()), buf.size()));
     } else {
         GLOBED_UNWRAP(udpSocket.send(reinterpret_cast<const char*>(buf.data().data()), buf.size()));
@@ -306,12 +357,10 @@ Result<> GameSocket::sendPacketTo(std::shared_ptr<Packet> packet, const NetworkA
     GLOBED_UNWRAP(this->encodePacket(*packet, buf, false))
 
     if (dumpPackets) {
-        this->dumpPacket(packet->getPacketId(), buf, true);
+        this->capturePacket(PacketCapture::Direction::Outgoing, Protocol::Udp, false, buf, 0);
     }
 
-#ifdef GLOBED_DEBUG_PACKETS
-    PacketLogger::get().record(packet->getPacketId(), packet->getEncrypted(), true, buf.size());
-#endif
+    PacketStats::get().record(*packet, PacketStats::Direction::Outgoing, buf.size());
 
     GLOBED_UNWRAP_INTO(udpSocket.sendTo(reinterpret_cast<const char*>(buf.data().data()), buf.size(), address), auto res)
 
@@ -344,15 +393,111 @@ void GameSocket::createBox() {
 }
 
 void GameSocket::togglePacketLogging(bool state) {
+    auto& capture = PacketCapture::get();
+
+    if (state && !capture.isCapturing()) {
+        auto res = capture.start();
+        if (!res) {
+            log::warn("Failed to start the packet capture: {}", res.unwrapErr());
+            return;
+        }
+
+        log::debug("Capturing packets to {}", res.unwrap());
+    } else if (!state) {
+        capture.stop();
+    }
+
     dumpPackets = state;
 }
 
-Result<PollResult> GameSocket::poll(int timeoutMs) {
-    globed::netLog("GameSocket::poll(timeoutMs={})", timeoutMs);
+void GameSocket::requestReliable() {
+    globed::netLog("GameSocket::requestReliable");
+    reliableRequested = true;
+}
+
+bool GameSocket::isReliableActive() {
+    return reliableRequested && reliable.lock()->isEstablished();
+}
+
+Result<> GameSocket::updateReliable() {
+    if (!reliableRequested) return Ok();
+
+    auto chan = reliable.lock();
 
+    if (!chan->isEstablished()) {
+        if (reliableHelloAttempts > 0 && reliableHelloSentAt.elapsed().millis() < 1000) {
+            return Ok();
+        }
+
+        if (reliableHelloAttempts >= RELIABLE_HELLO_ATTEMPTS) {
+            log::info("Server did not answer the reliable UDP hello, using TCP");
+            reliableRequested = false;
+            return Ok();
+        }
+
+        reliableHelloAttempts++;
+        reliableHelloSentAt = Instant::now();
+
+        std::vector<ReliableChannel::Datagram> hello = { chan->makeHello() };
+        chan.unlock();
+
+        return this->sendDatagrams(hello);
+    }
+
+    GLOBED_UNWRAP_INTO(chan->poll(), auto datagrams);
+    chan.unlock();
+
+    return this->sendDatagrams(datagrams);
+}
+
+ReliableChannel::Stats GameSocket::getReliableStats() {
+    return reliable.lock()->getStats();
+}
+
+Result<> GameSocket::sendReliable(const Packet& packet, ByteBuffer& buffer) {
+    // same limit as what the server uses for fragmenting packets it sends to us
+    size_t mtu = RELIABLE_MTU;
+    int limit = GlobedSettings::get().globed.fragmentationLimit.get();
+    if (limit > 0) {
+        mtu = std::min<size_t>(mtu, limit);
+    }
+
+    const auto& data = buffer.data();
+    GLOBED_UNWRAP_INTO(reliable.lock()->send(ReliableChannel::channelFor(packet.getPacketId()), data.data(), data.size(), mtu), auto datagrams);
+
+    return this->sendDatagrams(datagrams);
+}
+
+Result<> GameSocket::sendDatagrams(const std::vector<ReliableChannel::Datagram>& datagrams) {
+    for (const auto& datagram : datagrams) {
+        GLOBED_UNWRAP(udpSocket.send(reinterpret_cast<const char*>(datagram.data()), datagram.size()));
+    }
+
+    return Ok();
+}
+
+Result<> GameSocket::handleReliableFrame(ByteBuffer& buffer) {
+    std::vector<ReliableChannel::Datagram> replies;
+    GLOBED_UNWRAP_INTO(reliable.lock()->receive(buffer, replies), auto completed);
+    GLOBED_UNWRAP(this->sendDatagrams(replies));
+
+    for (auto& data : completed) {
+        size_t size = data.size();
+
+        ByteBuffer toDecode(std::move(data));
+        GLOBED_UNWRAP_INTO(this->decodePacket(toDecode, Protocol::Udp), auto packet);
+
+        PacketStats::get().record(*packet, PacketStats::Direction::Incoming, size);
+        reliableReady.push_back(std::move(packet));
+    }
+
+    return Ok();
+}
+
+Result<PollResult> GameSocket::poll(int timeoutMs) {
     if (!tcpSocket.connected) {
         GLOBED_UNWRAP_INTO(udpSocket.poll(timeoutMs), auto res);
-        globed::netLog("GameSocket::poll polled only udp, result: {}", res);
+        globed::netRecord(NetEvent::Poll, timeoutMs, res ? (uint64_t) PollResult::Udp : (uint64_t) PollResult::None);
         return Ok(res ? PollResult::Udp : PollResult::None);
     }
 
@@ -367,27 +512,30 @@ Result<PollResult> GameSocket::poll(int timeoutMs) {
 
     if (result == -1) {
         auto code = util::net::lastErrorCode();
-        globed::netLog("(E) GameSocket::poll failed! code {}", code);
+        globed::netRecord(NetEvent::SocketError, (uint32_t) ErrorSite::Poll, code);
         return Err(util::net::lastErrorString(code));
     }
 
     bool tcp = fds[0].revents & POLLIN;
     bool udp = fds[1].revents & POLLIN;
 
+    PollResult pollResult;
     if (tcp && udp) {
-        return Ok(PollResult::Both);
+        pollResult = PollResult::Both;
     } else if (tcp) {
-        return Ok(PollResult::Tcp);
+        pollResult = PollResult::Tcp;
     } else if (udp) {
-        return Ok(PollResult::Udp);
+        pollResult = PollResult::Udp;
     } else {
-        return Ok(PollResult::None);
+        pollResult = PollResult::None;
     }
+
+    globed::netRecord(NetEvent::Poll, timeoutMs, (uint64_t) pollResult);
+
+    return Ok(pollResult);
 }
 
 Result<bool> GameSocket::poll(Protocol proto, int timeoutMs) {
-    globed::netLog("GameSocket::poll(proto={}, timeoutMs={})", (int) proto, timeoutMs);
-
     GLOBED_REQUIRE_SAFE(proto != Protocol::Unspecified, "invalid protocol");
 
     GLOBED_SOCKET_POLLFD fd;
@@ -406,16 +554,20 @@ Result<bool> GameSocket::poll(Protocol proto, int timeoutMs) {
     int result = GLOBED_SOCKET_POLL(&fd, 1, timeoutMs);
     if (result == -1) {
         auto code = util::net::lastErrorCode();
-        globed::netLog("(E) GameSocket::poll failed! code {}", code);
+        globed::netRecord(NetEvent::SocketError, (uint32_t) ErrorSite::Poll, code);
         return Err(util::net::lastErrorString(code));
     }
 
-    globed::netLog("GameSocket::poll result: {}", bool(fd.revents & POLLIN));
+    bool ready = fd.revents & POLLIN;
+    auto pollResult = !ready ? PollResult::None : (proto == Protocol::Tcp ? PollResult::Tcp : PollResult::Udp);
+    globed::netRecord(NetEvent::Poll, timeoutMs, (uint64_t) pollResult);
 
-    return Ok((bool) (fd.revents & POLLIN));
+    return Ok(ready);
 }
 
 Result<> GameSocket::encodePacket(Packet& packet, ByteBuffer& buffer, bool tcp) {
+    GLOBED_PROFILE_ZONE("GameSocket::encodePacket");
+
     PacketHeader header = {
         .id = packet.getPacketId(),
         .encrypted = packet.getEncrypted(),
@@ -431,8 +583,6 @@ Result<> GameSocket::encodePacket(Packet& packet, ByteBuffer& buffer, bool tcp)
     buffer.writeValue<PacketHeader>(header);
     packet.encode(buffer);
 
-    globed::netLog("GameSocket::encodePacket: encoding packet: id={}, encrypted={}, totalsize={} (pre-encryption)", header.id, header.encrypted, buffer.size());
-
     if (packet.getEncrypted()) {
         GLOBED_REQUIRE_SAFE(cryptoBox.get() != nullptr, "attempted to encrypt a packet when no cryptobox is initialized")
 
@@ -457,10 +607,17 @@ Result<> GameSocket::encodePacket(Packet& packet, ByteBuffer& buffer, bool tcp)
         buffer.setPosition(lastPos);
     }
 
+    globed::netRecord(NetEvent::PacketEncoded, header.id, header.encrypted, buffer.size() - startPos);
+
     return Ok();
 }
 
-Result<std::shared_ptr<Packet>> GameSocket::decodePacket(ByteBuffer& buffer) {
+Result<std::shared_ptr<Packet>> GameSocket::decodePacket(ByteBuffer& buffer, Protocol protocol, bool cleartext) {
+    GLOBED_PROFILE_ZONE("GameSocket::decodePacket");
+
+    auto startedAt = Instant::now();
+    size_t headerStart = buffer.getPosition();
+
     // read header
     auto header = buffer.readValue<PacketHeader>().unwrap(); // we know that the header must be present by now.
 
@@ -468,18 +625,16 @@ Result<std::shared_ptr<Packet>> GameSocket::decodePacket(ByteBuffer& buffer) {
     size_t messageStart = buffer.getPosition();
     size_t messageLength = buffer.size() - messageStart;
 
-    globed::netLog("GameSocket::decodePacket: Decoded header: id={}, encrypted={}, length={}", header.id, header.encrypted, messageLength);
-
     auto packet = matchPacket(header.id);
 
     GLOBED_REQUIRE_SAFE(packet.get() != nullptr, std::string("invalid server-side packet: ") + std::to_string(header.id))
 
-    if (packet->getEncrypted() && !header.encrypted) {
-        globed::netLog("(W) GameSocket::decodePacket: warning, mismatched encryption!!");
+    if (packet->getEncrypted() && !header.encrypted && !cleartext) {
+        globed::netRecord(NetEvent::PacketDecodeFailed, header.id);
         GLOBED_REQUIRE_SAFE(false, fmt::format("server sent a cleartext packet when expected an encrypted one ({})", header.id))
     }
 
-    if (header.encrypted) {
+    if (header.encrypted && !cleartext) {
         GLOBED_REQUIRE_SAFE(cryptoBox.get() != nullptr, "attempted to decrypt a packet when no cryptobox is initialized")
         bytevector& bufvec = buffer.data();
 
@@ -488,35 +643,31 @@ Result<std::shared_ptr<Packet>> GameSocket::decodePacket(ByteBuffer& buffer) {
     }
 
     if (dumpPackets) {
-        this->dumpPacket(header.id, buffer, false);
+        this->capturePacket(PacketCapture::Direction::Incoming, protocol, true, buffer, headerStart);
     }
 
     auto result = packet->decode(buffer);
     if (result.isErr()) {
         auto errmsg = ByteBuffer::strerror(result.unwrapErr());
 
-        globed::netLog("(W) GameSocket::decodePacket: failed to decode packet: {}", errmsg);
+        globed::netRecord(NetEvent::PacketDecodeFailed, header.id);
 
         return Err(fmt::format("Decoding packet ID {} failed: {}", header.id, errmsg));
     }
 
+    globed::netRecord(
+        NetEvent::PacketDecoded,
+        header.id,
+        (uint64_t) header.encrypted | ((uint64_t) messageLength << 1),
+        startedAt.elapsed().micros()
+    );
+
     return Ok(std::move(packet));
 }
 
-void GameSocket::dumpPacket(packetid_t id, ByteBuffer& buffer, bool sending) {
-    log::debug("{} packet {}", sending ? "Sending" : "Receiving", id);
-
-    auto folder = Mod::get()->getSaveDir() / "packets";
-    (void) geode::utils::file::createDirectoryAll(folder);
-    util::misc::callOnce("networkmanager-log-to-file", [&] {
-        log::debug("Packet log folder: {}", folder);
-    });
-
-    auto datetime = util::format::formatDateTime(SystemTime::now());
-    auto filepath = folder / fmt::format("{}-{}.bin", id, datetime);
-
-    std::ofstream fs(filepath, std::ios::binary);
+void GameSocket::capturePacket(PacketCapture::Direction direction, Protocol protocol, bool cleartext, ByteBuffer& buffer, size_t start) {
+    auto transport = protocol == Protocol::Tcp ? PacketCapture::Transport::Tcp : PacketCapture::Transport::Udp;
 
     const auto& vec = buffer.data();
-    fs.write(reinterpret_cast<const char*>(vec.data()), vec.size());
-}
\ No newline at end of file
+    PacketCapture::get().capture(direction, transport, cleartext, vec.data() + start, vec.size() - start);
+}
@@ -4,10 +4,18 @@
 #include "udp_socket.hpp"
 #include "tcp_socket.hpp"
 #include "udp_frame_buffer.hpp"
+#include "reliable_channel.hpp"
+
+#include "packet_capture.hpp"
 
 #include <data/packets/packet.hpp>
 #include <crypto/box.hpp>
 
+#include <asp/sync.hpp>
+#include <asp/time/Instant.hpp>
+
+#include <deque>
+
 class GLOBED_DLL GameSocket {
     static constexpr uint8_t MARKER_CONN_INITIAL = 0xe0;
     static constexpr uint8_t MARKER_CONN_RECOVERY = 0xe1;
@@ -62,6 +70,15 @@ public:
 
     void togglePacketLogging(bool enabled);
 
+    // Starts asking the server to use reliable UDP frames instead of the TCP connection for reliable packets.
+    // If the server doesn't answer, everything keeps going over TCP.
+    void requestReliable();
+    // Whether reliable packets are currently being sent over UDP
+    bool isReliableActive();
+    // Retransmits lost reliable frames and retries the hello. Fails if the reliable connection is dead.
+    Result<> updateReliable();
+    ReliableChannel::Stats getReliableStats();
+
     enum class PollResult {
         None, Tcp, Udp, Both
     };
@@ -72,11 +89,26 @@ public:
 
 private:
     friend class NetworkManager;
+    friend class PacketReplay;
 
     TcpSocket tcpSocket;
     UdpSocket udpSocket;
     UdpFrameBuffer udpBuffer;
 
+    static constexpr size_t RELIABLE_MTU = 1400;
+    static constexpr size_t RELIABLE_HELLO_ATTEMPTS = 5;
+
+    asp::Mutex<ReliableChannel> reliable;
+    asp::AtomicBool reliableRequested = false;
+    size_t reliableHelloAttempts = 0;
+    asp::time::Instant reliableHelloSentAt = asp::time::Instant::now();
+    // packets completed by a single reliable frame, only touched by the receiving thread
+    std::deque<std::shared_ptr<Packet>> reliableReady;
+    // set when the last udp datagram was a part of a fragmented packet, only touched by the receiving thread
+    bool awaitingFrames = false;
+    // set by disconnect, which may run on any thread, so that the receiving thread resets the two above before it receives anything else
+    asp::AtomicBool receiveResetPending = false;
+
     std::unique_ptr<CryptoBox> cryptoBox;
     util::data::byte* dataBuffer;
 
@@ -85,8 +117,18 @@ private:
     // Write a packet, packet header, and optionally length if the packet is TCP to the given buffer.
     Result<> encodePacket(Packet& packet, ByteBuffer& buffer, bool tcp);
 
-    // Decode a packet from a buffer
-    Result<std::shared_ptr<Packet>> decodePacket(ByteBuffer& buffer);
+    // Decode a packet from a buffer. `protocol` is only used for packet captures.
+    // If `cleartext` is true, the packet data is assumed to already be decrypted (used when replaying a capture)
+    Result<std::shared_ptr<Packet>> decodePacket(ByteBuffer& buffer, Protocol protocol, bool cleartext = false);
+
+    // Send an encoded packet (without the tcp length prefix) through the reliable channel
+    Result<> sendReliable(const Packet& packet, ByteBuffer& buffer);
+    Result<> sendDatagrams(const std::vector<ReliableChannel::Datagram>& datagrams);
+    // Handle a reliable frame, fills `reliableReady` with any packets that were completed
+    Result<> handleReliableFrame(ByteBuffer& buffer);
+    // Called by the receiving thread, drops the state of the previous connection if it was disconnected since
+    void applyPendingReset();
 
-    void dumpPacket(packetid_t id, ByteBuffer& buffer, bool sending);
+    // Write the contents of the buffer starting at `start` to the active packet capture
+    void capturePacket(PacketCapture::Direction direction, Protocol protocol, bool cleartext, ByteBuffer& buffer, size_t start);
 };
@@ -3,6 +3,7 @@
 #include "address.hpp"
 #include "listener.hpp"
 #include "game_socket.hpp"
+#include "send_scheduler.hpp"
 
 #include <Geode/ui/GeodeUI.hpp>
 #include <asp/sync.hpp>
@@ -11,10 +12,13 @@
 
 #include <data/packets/all.hpp>
 #include <defs/minimal_geode.hpp>
+#include <globed/profiler.hpp>
 #include <globed/tracing.hpp>
+#include <net/flight_recorder.hpp>
 #include <managers/account.hpp>
 #include <managers/admin.hpp>
 #include <managers/error_queues.hpp>
+#include <managers/frame_scheduler.hpp>
 #include <managers/game_server.hpp>
 #include <managers/central_server.hpp>
 #include <managers/profile_cache.hpp>
@@ -27,6 +31,7 @@
 #include <util/cocos.hpp>
 #include <util/crypto.hpp>
 #include <util/format.hpp>
+#include <util/memory.hpp>
 #include <util/time.hpp>
 #include <util/net.hpp>
 #include <util/ui.hpp>
@@ -57,6 +62,7 @@ struct AtomicConnectionState {
 
     AtomicConnectionState& operator=(ConnectionState state) {
         inner.store(static_cast<inner_t>(state));
+        globed::netRecord(NetFlightRecorder::Event::StateChange, static_cast<uint32_t>(state));
         return *this;
     }
 
@@ -105,20 +111,37 @@ public:
             gam.authToken.lock()->clear();
 
             // clear the queue
-            while (auto t = packetQueue.tryPop());
+            while (auto t = packetQueue.tryPop()) {
+                util::memory::remove(util::memory::Tag::IncomingPackets, t.value()->getObjectSize());
+            }
 
             return;
         }
 
         if (packetQueue.empty()) return;
 
+        GLOBED_PROFILE_ZONE("PacketListenerPool::update");
+
         // clear any dead listeners
         this->removeDeadListeners();
 
-        while (auto packet_ = packetQueue.tryPop()) {
+        // packets that don't fit in the frame budget stay in the queue until the next frame,
+        // but at least one is always dispatched so that a slow frame can't stall the queue forever
+        auto& fs = FrameScheduler::get();
+        bool dispatchedAny = false;
+
+        while (!dispatchedAny || fs.hasBudget(FrameScheduler::Priority::Network)) {
+            auto packet_ = packetQueue.tryPop();
+            if (!packet_) break;
+
+            auto startedAt = Instant::now();
+            dispatchedAny = true;
+
             auto& packet = packet_.value();
             packetid_t id = packet->getPacketId();
 
+            util::memory::remove(util::memory::Tag::IncomingPackets, packet->getObjectSize());
+
             bool invoked = false;
             auto& lsm = listeners[id];
 
@@ -142,6 +165,10 @@ public:
                     }
                 }
             }
+
+            auto took = startedAt.elapsed();
+            fs.addSpent(took);
+            globed::netRecord(NetFlightRecorder::Event::PacketDispatched, id, took.micros());
         }
     }
 
@@ -187,7 +214,9 @@ public:
 
     // Push a packet to the queue. Thread safe.
     void pushPacket(std::shared_ptr<Packet> packet) {
+        util::memory::add(util::memory::Tag::IncomingPackets, packet->getObjectSize());
         packetQueue.push(std::move(packet));
+        globed::netRecord(NetFlightRecorder::Event::IncomingQueueDepth, packetQueue.size());
     }
 
 private:
@@ -207,9 +236,8 @@ protected:
     static constexpr int BUILTIN_LISTENER_PRIORITY = 10000000;
 
     struct TaskPingServers {};
-    struct TaskSendPacket {
-        std::shared_ptr<Packet> packet;
-    };
+    // the packet itself is in `sendQueue`, this only wakes up the thread and sends whatever has the highest priority
+    struct TaskSendPacket {};
     struct TaskPingActive {};
 
     struct GlobalListener {
@@ -235,6 +263,7 @@ protected:
     GameSocket socket;
     asp::Thread<NetworkManager::Impl*> threadRecv, threadMain;
     asp::Channel<Task> taskQueue;
+    SendScheduler sendQueue;
 
     // Note that we intentionally don't use Ref here,
     // as we use the destructor to know if the object owning the listener has been destroyed.
@@ -384,7 +413,10 @@ protected:
     void disconnect(bool quiet = false, bool noclear = false) {
         bool wasEstablished = state == ConnectionState::Established;
 
+        bool wasDisconnected = state == ConnectionState::Disconnected;
+
         globed::netLog("NetworkManagerImpl::disconnect(quiet={}, noclear={}, prevstate={})", quiet, noclear, state.inner.load());
+        globed::netRecord(NetFlightRecorder::Event::Disconnect, quiet);
 
         this->resetConnectionState();
 
@@ -395,6 +427,10 @@ protected:
 
         socket.disconnect();
 
+        if (!wasDisconnected) {
+            this->saveFlightRecording();
+        }
+
         // singletons could have been destructed before NetworkManager, so this could be UB. Additionally will break autoconnect.
         if (!noclear) {
             RoomManager::get().setGlobal();
@@ -425,10 +461,22 @@ protected:
     }
 
     void send(std::shared_ptr<Packet> packet) {
-        globed::netLog("NetworkManagerImpl::send(packet = {{id = {}}})", packet->getPacketId());
-        taskQueue.push(TaskSendPacket {
-            .packet = std::move(packet)
-        });
+        packetid_t id = packet->getPacketId();
+
+        // if an unsent packet got replaced, there already is a task queued for it
+        if (!sendQueue.push(std::move(packet))) {
+            taskQueue.push(TaskSendPacket {});
+        }
+
+        globed::netRecord(NetFlightRecorder::Event::SendQueued, id, sendQueue.size());
+    }
+
+    // Keeps the flight recording of the last connection around, so that it can be looked at after something went wrong
+    void saveFlightRecording() {
+        auto res = NetFlightRecorder::get().dump("net-flight-last");
+        if (!res) {
+            log::warn("Failed to save the network flight recording: {}", res.unwrapErr());
+        }
     }
 
     void pingServers() {
@@ -523,7 +571,7 @@ protected:
     template <HasPacketID Pty>
     void addInternalListenerSync(PacketCallbackSpecific<Pty>&& callback) {
         this->addInternalListener<Pty>([cb = std::move(callback)](std::shared_ptr<Pty> packet) {
-            Loader::get()->queueInMainThread([cb = std::move(cb), packet = std::move(packet)] {
+            FrameScheduler::get().queue(FrameScheduler::Priority::Network, [cb = std::move(cb), packet = std::move(packet)] {
                 cb(std::move(packet));
             });
         });
@@ -761,6 +809,11 @@ protected:
 
         state = ConnectionState::Established;
 
+        // servers that don't know about reliable frames just ignore the hello and everything stays on tcp
+        if (GlobedSettings::get().globed.reliableUdp) {
+            socket.requestReliable();
+        }
+
         if (recovering || wasFromRecovery) {
             recovering = false;
             recoverAttempt = 0;
@@ -922,8 +975,6 @@ protected:
 
         *lastReceivedPacket.lock() = SystemTime::now();
 
-        globed::netLog("NetworkManagerImpl::threadRecvFunc dispatching packet {}", id);
-
         this->callListener(std::move(packet));
     }
 
@@ -1055,6 +1106,7 @@ protected:
         // Detect if the tcp socket has unexpectedly disconnected and start recovering the connection
         else if (state == ConnectionState::Established && !socket.isConnected()) {
             globed::netLog("NetworkManagerImpl::threadMainFunc connection was lost, starting to recover");
+            this->saveFlightRecording();
 
             ErrorQueues::get().warn("[Globed] connection lost, reconnecting..");
 
@@ -1096,6 +1148,7 @@ protected:
 
         if (this->established()) {
             this->maybeSendKeepalive();
+            this->updateReliable();
         }
 
         // poll for any incoming packets
@@ -1106,15 +1159,31 @@ protected:
             if (std::holds_alternative<TaskPingServers>(task)) {
                 this->handlePingTask();
             } else if (std::holds_alternative<TaskSendPacket>(task)) {
-                this->handleSendPacketTask(std::move(std::get<TaskSendPacket>(task)));
+                if (auto packet = sendQueue.pop()) {
+                    this->handleSendPacket(std::move(packet));
+                }
             } else if (std::holds_alternative<TaskPingActive>(task)) {
                 this->handlePingActive();
             }
+
+            // retransmissions shouldn't wait until the queue is empty
+            if (this->established()) {
+                this->updateReliable();
+            }
         }
 
         std::this_thread::yield();
     }
 
+    void updateReliable() {
+        auto result = socket.updateReliable();
+        if (!result) {
+            // same as a timeout, disconnect but allow to reconnect
+            log::warn("reliable channel failed: {}", result.unwrapErr());
+            socket.disconnect();
+        }
+    }
+
     void maybeSendKeepalive() {
         if (!this->established()) return;
 
@@ -1182,16 +1251,16 @@ protected:
         }
     }
 
-    void handleSendPacketTask(TaskSendPacket task) {
-        if (task.packet->getUseTcp()) {
+    void handleSendPacket(std::shared_ptr<Packet> packet) {
+        if (packet->getUseTcp()) {
             lastTcpExchange = SystemTime::now();
         }
 
         try {
-            auto result = socket.sendPacket(task.packet);
+            auto result = socket.sendPacket(packet);
             if (!result) {
                 auto error = result.unwrapErr();
-                log::debug("failed to send packet {}: {}", task.packet->getPacketId(), error);
+                log::debug("failed to send packet {}: {}", packet->getPacketId(), error);
                 this->onConnectionError(error);
                 return;
             }
@@ -1285,6 +1354,22 @@ void NetworkManager::togglePacketLogging(bool enabled) {
     impl->togglePacketLogging(enabled);
 }
 
+void NetworkManager::injectPacket(std::shared_ptr<Packet> packet) {
+    PacketListenerPool::get().pushPacket(std::move(packet));
+}
+
+std::vector<SendQueueStats> NetworkManager::getSendQueueStats() {
+    return impl->sendQueue.getStats();
+}
+
+std::optional<ReliableChannel::Stats> NetworkManager::getReliableStats() {
+    if (!impl->socket.isReliableActive()) {
+        return std::nullopt;
+    }
+
+    return impl->socket.getReliableStats();
+}
+
 uint16_t NetworkManager::getUsedProtocol() {
     return impl->getUsedProtocol();
 }
@@ -3,6 +3,7 @@
 #include <Geode/Result.hpp>
 #include <defs/platform.hpp>
 
+#include <net/reliable_channel.hpp>
 #include <util/singleton.hpp>
 
 using packetid_t = uint16_t;
@@ -12,6 +13,7 @@ class NetworkAddress;
 struct GameServer;
 class Packet;
 struct UserPrivacyFlags;
+struct SendQueueStats;
 
 template <typename T>
 concept HasPacketID = requires { T::PACKET_ID; };
@@ -96,9 +98,19 @@ public:
     // Removes all listeners.
     void removeAllListeners();
 
-    // Enable whether packets are logged to a file (and to the console)
+    // Enable whether packets are captured to a file (see PacketCapture)
     void togglePacketLogging(bool enabled);
 
+    // Pushes a packet straight to the packet listeners, as if it was received from the server.
+    // Internal listeners are skipped, so this never affects the connection. Thread safe.
+    void injectPacket(std::shared_ptr<Packet> packet);
+
+    // Returns the number of queued packets and how long they waited before being sent, for every priority class (see SendScheduler)
+    std::vector<SendQueueStats> getSendQueueStats();
+
+    // Returns the stats of the reliable UDP channel, or nothing if reliable packets go over TCP
+    std::optional<ReliableChannel::Stats> getReliableStats();
+
     // Returns the protocol version of this client
     uint16_t getUsedProtocol();
 
@@ -0,0 +1,142 @@
+#include "packet_capture.hpp"
+
+#include <data/bytebuffer.hpp>
+#include <globed/tracing.hpp>
+#include <util/format.hpp>
+#include <util/memory.hpp>
+
+#include <asp/time/SystemTime.hpp>
+
+using namespace geode::prelude;
+using namespace asp::time;
+
+PacketCapture::PacketCapture() {
+    thread.setStartFunction([] { geode::utils::thread::setName("Packet Capture Thread"); });
+    thread.setLoopFunction(&PacketCapture::threadFunc);
+    thread.start(this);
+}
+
+PacketCapture::~PacketCapture() {
+    TRACE("[PacketCapture] waiting for thread to stop");
+    thread.stopAndWait();
+    this->finish();
+    TRACE("[PacketCapture] thread halted");
+}
+
+Result<std::filesystem::path> PacketCapture::start() {
+    auto folder = captureFolder();
+    GLOBED_UNWRAP(geode::utils::file::createDirectoryAll(folder));
+
+    auto path = folder / fmt::format("capture-{}.gcap", util::format::formatDateTime(SystemTime::now(), false));
+
+    // the start command is queued before flipping the flag, so no record can end up in the previous file
+    commands.push(CmdStart { path });
+    *startedAt.lock() = Instant::now();
+    capturing = true;
+
+    return Ok(path);
+}
+
+void PacketCapture::stop() {
+    if (!capturing) return;
+
+    capturing = false;
+    commands.push(CmdStop {});
+}
+
+bool PacketCapture::isCapturing() {
+    return capturing;
+}
+
+void PacketCapture::capture(Direction direction, Transport transport, bool cleartext, const util::data::byte* data, size_t size) {
+    if (!capturing) return;
+
+    auto started = startedAt.lock();
+    if (!*started) return;
+
+    // the queue can grow big if the disk can't keep up, so it's counted until the record is written out
+    util::memory::add(util::memory::Tag::PacketCapture, size);
+
+    commands.push(Record {
+        .timestamp = static_cast<uint64_t>(started->value().elapsed().micros()),
+        .direction = direction,
+        .transport = transport,
+        .cleartext = cleartext,
+        .payload = util::data::bytevector(data, data + size),
+    });
+}
+
+std::filesystem::path PacketCapture::captureFolder() {
+    return Mod::get()->getSaveDir() / "packets";
+}
+
+void PacketCapture::threadFunc(decltype(thread)::StopToken&) {
+    auto cmd_ = commands.popTimeout(Duration::fromMillis(100));
+    if (!cmd_) return;
+
+    auto cmd = std::move(cmd_.value());
+
+    if (auto* start = std::get_if<CmdStart>(&cmd)) {
+        this->finish();
+
+        file.open(start->path, std::ios::binary);
+        if (!file.is_open()) {
+            log::warn("Failed to open packet capture file {}", start->path);
+            return;
+        }
+
+        ByteBuffer bb;
+        bb.writeU32(FILE_MAGIC);
+        bb.writeU16(FILE_VERSION);
+        bb.writeU64(SystemTime::now().timeSinceEpoch().millis());
+
+        file.write(reinterpret_cast<const char*>(bb.data().data()), bb.size());
+        writtenBytes = bb.size();
+
+        log::debug("Started packet capture: {}", start->path);
+    } else if (auto* record = std::get_if<Record>(&cmd)) {
+        this->writeRecord(*record);
+        util::memory::remove(util::memory::Tag::PacketCapture, record->payload.size());
+    } else {
+        this->finish();
+    }
+}
+
+void PacketCapture::writeRecord(const Record& record) {
+    if (!file.is_open()) return;
+
+    ByteBuffer bb;
+    bb.writeU64(record.timestamp);
+    bb.writeU8(static_cast<uint8_t>(record.direction));
+    bb.writeU8(static_cast<uint8_t>(record.transport));
+    bb.writeU8(record.cleartext ? FLAG_CLEARTEXT : 0);
+    bb.writeU32(record.payload.size());
+
+    file.write(reinterpret_cast<const char*>(bb.data().data()), bb.size());
+    file.write(reinterpret_cast<const char*>(record.payload.data()), record.payload.size());
+
+    index.push_back(writtenBytes);
+    writtenBytes += bb.size() + record.payload.size();
+}
+
+void PacketCapture::finish() {
+    if (!file.is_open()) return;
+
+    // index: record count, offsets, then the offset of the index itself and a magic, so it can be found from the end of the file
+    ByteBuffer bb;
+    bb.writeU32(index.size());
+    for (auto offset : index) {
+        bb.writeU64(offset);
+    }
+
+    bb.writeU64(writtenBytes);
+    bb.writeU32(INDEX_MAGIC);
+
+    file.write(reinterpret_cast<const char*>(bb.data().data()), bb.size());
+    file.close();
+
+    log::debug("Finished packet capture, {} records", index.size());
+
+    index.clear();
+    writtenBytes = 0;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <defs/geode.hpp>
+#include <util/data.hpp>
+#include <util/singleton.hpp>
+
+#include <asp/sync.hpp>
+#include <asp/sync/Channel.hpp>
+#include <asp/thread/Thread.hpp>
+#include <asp/time/Instant.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <variant>
+
+/*
+* Records every packet sent and received during a session into a single capture file, which can later be replayed with `PacketReplay`.
+*
+* The file is append-only, a header followed by records (timestamp, direction, transport, payload).
+* When the capture is stopped, an index of record offsets is appended at the end. If the game crashes before that,
+* the index is missing but the file can still be read by walking the records one by one.
+*
+* Incoming packets are stored after decryption, as the session keys are gone by the time anyone looks at the capture.
+* Outgoing packets are stored exactly as sent over the wire.
+*/
+class PacketCapture : public SingletonBase<PacketCapture> {
+    friend class SingletonBase;
+
+    PacketCapture();
+    ~PacketCapture();
+
+public:
+    enum class Direction : uint8_t {
+        Incoming, Outgoing
+    };
+
+    enum class Transport : uint8_t {
+        Tcp, Udp
+    };
+
+    struct Record {
+        uint64_t timestamp; // microseconds since the capture was started
+        Direction direction;
+        Transport transport;
+        bool cleartext;     // whether the payload is a packet header + unencrypted packet data, that can be decoded again
+        util::data::bytevector payload;
+    };
+
+    struct CaptureFile {
+        uint64_t startedAt; // unix timestamp in milliseconds
+        std::vector<Record> records;
+    };
+
+    static constexpr uint32_t FILE_MAGIC = 0x47504346; // GPCF
+    static constexpr uint32_t INDEX_MAGIC = 0x47504349; // GPCI
+    static constexpr uint16_t FILE_VERSION = 1;
+    // record header: timestamp, direction, transport, flags, payload length
+    static constexpr size_t RECORD_HEADER_SIZE = 8 + 1 + 1 + 1 + 4;
+    static constexpr uint8_t FLAG_CLEARTEXT = 1 << 0;
+
+    // Starts a new capture in the `packets` folder of the save directory, finishing the current one if there is one
+    geode::Result<std::filesystem::path> start();
+    void stop();
+    bool isCapturing();
+
+    // Thread safe, does nothing if not capturing. The data is copied and written to the file on the capture thread.
+    void capture(Direction direction, Transport transport, bool cleartext, const util::data::byte* data, size_t size);
+
+    static std::filesystem::path captureFolder();
+    static geode::Result<CaptureFile> load(const std::filesystem::path& path);
+
+private:
+    struct CmdStart {
+        std::filesystem::path path;
+    };
+
+    struct CmdStop {};
+
+    using Command = std::variant<CmdStart, Record, CmdStop>;
+
+    asp::Thread<PacketCapture*> thread;
+    asp::Channel<Command> commands;
+    asp::AtomicBool capturing = false;
+    asp::Mutex<std::optional<asp::time::Instant>> startedAt;
+
+    // only touched by the capture thread
+    std::ofstream file;
+    std::vector<uint64_t> index;
+    uint64_t writtenBytes = 0;
+
+    void threadFunc(decltype(thread)::StopToken&);
+    void writeRecord(const Record& record);
+    void finish();
+};
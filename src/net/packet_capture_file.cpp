@@ -0,0 +1,123 @@
+#include "packet_capture.hpp"
+
+#include <data/bytebuffer.hpp>
+
+// Reading capture files is separate from recording them, so that it can be used without the capture thread (e.g. in bench/)
+
+using namespace geode::prelude;
+
+Result<PacketCapture::CaptureFile> PacketCapture::load(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return Err(fmt::format("failed to open {}", path));
+    }
+
+    util::data::bytevector data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    size_t fileSize = data.size();
+    ByteBuffer bb(std::move(data));
+
+    CaptureFile out;
+
+    // sizes and offsets in the file are not trusted, they are checked against this before allocating or seeking
+    auto remaining = [&]() -> size_t {
+        return bb.getPosition() < fileSize ? fileSize - bb.getPosition() : 0;
+    };
+
+    auto readRecord = [&]() -> ByteBuffer::DecodeResult<Record> {
+        GLOBED_UNWRAP_INTO(bb.readU64(), auto timestamp);
+        GLOBED_UNWRAP_INTO(bb.readU8(), auto direction);
+        GLOBED_UNWRAP_INTO(bb.readU8(), auto transport);
+        GLOBED_UNWRAP_INTO(bb.readU8(), auto flags);
+        GLOBED_UNWRAP_INTO(bb.readU32(), auto length);
+
+        if (length > remaining()) {
+            return Err(ByteBuffer::DecodeError::NotEnoughData);
+        }
+
+        util::data::bytevector payload(length);
+        GLOBED_UNWRAP(bb.readBytesInto(payload.data(), length));
+
+        return Ok(Record {
+            .timestamp = timestamp,
+            .direction = static_cast<Direction>(direction),
+            .transport = static_cast<Transport>(transport),
+            .cleartext = (flags & FLAG_CLEARTEXT) != 0,
+            .payload = std::move(payload),
+        });
+    };
+
+    // false if the file is not a capture, or is from a different version
+    auto result = [&]() -> ByteBuffer::DecodeResult<bool> {
+        GLOBED_UNWRAP_INTO(bb.readU32(), auto magic);
+        GLOBED_UNWRAP_INTO(bb.readU16(), auto version);
+
+        if (magic != FILE_MAGIC || version != FILE_VERSION) {
+            return Ok(false);
+        }
+
+        GLOBED_UNWRAP_INTO(bb.readU64(), out.startedAt);
+
+        size_t headerEnd = bb.getPosition();
+
+        // try to use the index first
+        if (fileSize >= headerEnd + 4 + 8 + 4) {
+            bb.setPosition(fileSize - 4);
+            GLOBED_UNWRAP_INTO(bb.readU32(), auto indexMagic);
+
+            if (indexMagic == INDEX_MAGIC) {
+                bb.setPosition(fileSize - 4 - 8);
+                GLOBED_UNWRAP_INTO(bb.readU64(), auto indexOffset);
+
+                if (indexOffset < headerEnd || indexOffset > fileSize - 4 - 8 - 4) {
+                    return Err(ByteBuffer::DecodeError::NotEnoughData);
+                }
+
+                bb.setPosition(indexOffset);
+                GLOBED_UNWRAP_INTO(bb.readU32(), auto count);
+
+                if (static_cast<uint64_t>(count) * 8 > remaining()) {
+                    return Err(ByteBuffer::DecodeError::NotEnoughData);
+                }
+
+                std::vector<uint64_t> offsets(count);
+                for (auto& offset : offsets) {
+                    GLOBED_UNWRAP_INTO(bb.readU64(), offset);
+                }
+
+                out.records.reserve(count);
+                for (auto offset : offsets) {
+                    if (offset < headerEnd || offset >= indexOffset) {
+                        return Err(ByteBuffer::DecodeError::NotEnoughData);
+                    }
+
+                    bb.setPosition(offset);
+                    GLOBED_UNWRAP_INTO(readRecord(), auto record);
+                    out.records.push_back(std::move(record));
+                }
+
+                return Ok(true);
+            }
+        }
+
+        // no index, the capture was never finished. read records until the end, the last one may be cut off
+        bb.setPosition(headerEnd);
+        while (fileSize - bb.getPosition() >= RECORD_HEADER_SIZE) {
+            auto record = readRecord();
+            if (!record) break;
+
+            out.records.push_back(std::move(record).unwrap());
+        }
+
+        return Ok(true);
+    }();
+
+    if (result.isErr()) {
+        return Err(fmt::format("failed to read {}: {}", path, ByteBuffer::strerror(result.unwrapErr())));
+    }
+
+    if (!result.unwrap()) {
+        return Err(fmt::format("{} is not a packet capture (or is from another version)", path));
+    }
+
+    return Ok(std::move(out));
+}
@@ -0,0 +1,155 @@
+#include "packet_replay.hpp"
+
+#include <data/bytebuffer.hpp>
+#include <globed/tracing.hpp>
+#include <net/manager.hpp>
+
+using namespace geode::prelude;
+using namespace asp::time;
+
+using Direction = PacketCapture::Direction;
+using Transport = PacketCapture::Transport;
+
+// the longest the replay thread sleeps at once, so that stopping the replay doesn't take long
+constexpr static uint64_t MAX_SLEEP_US = 50'000;
+
+PacketReplay::PacketReplay() {
+    thread.setStartFunction([] { geode::utils::thread::setName("Packet Replay Thread"); });
+    thread.setLoopFunction(&PacketReplay::threadFunc);
+    thread.start(this);
+}
+
+PacketReplay::~PacketReplay() {
+    TRACE("[PacketReplay] waiting for thread to stop");
+    thread.stopAndWait();
+    TRACE("[PacketReplay] thread halted");
+}
+
+Result<> PacketReplay::start(const std::filesystem::path& path, float speed) {
+    // the replayed packets would get mixed up with the ones from the server
+    if (!isDisconnected()) {
+        return Err("cannot replay a capture while connected to a server");
+    }
+
+    GLOBED_UNWRAP_INTO(PacketCapture::load(path), auto capture);
+
+    // outgoing packets are encrypted and can't be decoded, and packets from before decryption was captured can't be either
+    std::erase_if(capture.records, [](const auto& record) {
+        return record.direction != Direction::Incoming || !record.cleartext;
+    });
+
+    log::info("Replaying {} packets from {} (speed: {})", capture.records.size(), path, speed);
+
+    *session.lock() = Session {
+        .records = std::move(capture.records),
+        .speed = speed,
+        .startedAt = Instant::now(),
+    };
+
+    return Ok();
+}
+
+void PacketReplay::stop() {
+    auto s = session.lock();
+    if (*s) {
+        this->finishSession(s->value());
+        *s = std::nullopt;
+    }
+}
+
+bool PacketReplay::isReplaying() {
+    return session.lock()->has_value();
+}
+
+std::optional<std::filesystem::path> PacketReplay::latestCapture() {
+    std::error_code ec;
+    auto folder = PacketCapture::captureFolder();
+
+    std::optional<std::filesystem::path> latest;
+    std::filesystem::file_time_type latestTime{};
+
+    for (auto& entry : std::filesystem::directory_iterator(folder, ec)) {
+        if (entry.path().extension() != ".gcap") continue;
+
+        auto time = entry.last_write_time(ec);
+        if (ec) continue;
+
+        if (!latest || time > latestTime) {
+            latest = entry.path();
+            latestTime = time;
+        }
+    }
+
+    return latest;
+}
+
+void PacketReplay::threadFunc(decltype(thread)::StopToken&) {
+    auto s = session.lock();
+    if (!*s) {
+        s.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return;
+    }
+
+    auto& sess = s->value();
+
+    if (sess.next >= sess.records.size()) {
+        this->finishSession(sess);
+        *s = std::nullopt;
+        return;
+    }
+
+    // a connection was started in the meantime
+    if (!isDisconnected()) {
+        log::warn("Replay: stopping, a connection to a server was started");
+        this->finishSession(sess);
+        *s = std::nullopt;
+        return;
+    }
+
+    auto& record = sess.records[sess.next];
+
+    if (sess.speed > 0.f) {
+        auto dueAt = static_cast<uint64_t>(record.timestamp / sess.speed);
+        auto elapsed = static_cast<uint64_t>(sess.startedAt.elapsed().micros());
+
+        if (elapsed < dueAt) {
+            s.unlock();
+            std::this_thread::sleep_for(std::chrono::microseconds(std::min(dueAt - elapsed, MAX_SLEEP_US)));
+            return;
+        }
+    }
+
+    sess.next++;
+
+    ByteBuffer buf(std::move(record.payload));
+    auto protocol = record.transport == Transport::Tcp ? GameSocket::Protocol::Tcp : GameSocket::Protocol::Udp;
+
+    auto decodeStart = Instant::now();
+    auto packet = socket.decodePacket(buf, protocol, true);
+    sess.decodeTime += decodeStart.elapsed();
+
+    if (!packet) {
+        sess.failed++;
+        log::warn("Replay: {}", packet.unwrapErr());
+        return;
+    }
+
+    sess.decoded++;
+    NetworkManager::get().injectPacket(std::move(packet).unwrap());
+}
+
+bool PacketReplay::isDisconnected() {
+    return NetworkManager::get().getConnectionState() == NetworkManager::ConnectionState::Disconnected;
+}
+
+void PacketReplay::finishSession(Session& sess) {
+    log::info(
+        "Replay finished: {} packets decoded, {} failed, decoding took {} in total ({} per packet), replay took {}",
+        sess.decoded,
+        sess.failed,
+        sess.decodeTime.toString(),
+        sess.decoded > 0 ? Duration::fromMicros(sess.decodeTime.micros() / sess.decoded).toString() : "n/a",
+        sess.startedAt.elapsed().toString()
+    );
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "game_socket.hpp"
+#include "packet_capture.hpp"
+
+#include <asp/sync.hpp>
+#include <asp/thread/Thread.hpp>
+#include <asp/time/Instant.hpp>
+
+/*
+* Feeds the incoming packets of a capture back through the decoder and the packet listeners, without any server.
+* Meant for profiling decoding and dispatch offline, or reproducing a session that went wrong.
+* Packets are not given to the internal listeners of NetworkManager, so the connection state is left alone.
+* Only works while disconnected, the replay refuses to start or stops when there is a connection to a server.
+*/
+class PacketReplay : public SingletonBase<PacketReplay> {
+    friend class SingletonBase;
+
+    PacketReplay();
+    ~PacketReplay();
+
+public:
+    // 1.0 replays at the recorded speed, 2.0 twice as fast, 0 (or less) as fast as possible
+    geode::Result<> start(const std::filesystem::path& path, float speed = 1.f);
+    void stop();
+    bool isReplaying();
+
+    // The most recently modified capture in the capture folder, if there is one
+    static std::optional<std::filesystem::path> latestCapture();
+
+private:
+    struct Session {
+        std::vector<PacketCapture::Record> records;
+        size_t next = 0;
+        float speed;
+        asp::time::Instant startedAt;
+
+        size_t decoded = 0;
+        size_t failed = 0;
+        asp::time::Duration decodeTime{};
+    };
+
+    asp::Thread<PacketReplay*> thread;
+    asp::Mutex<std::optional<Session>> session;
+
+    // only used on the replay thread, for decoding
+    GameSocket socket;
+
+    void threadFunc(decltype(thread)::StopToken&);
+    static bool isDisconnected();
+    void finishSession(Session& session);
+};
@@ -0,0 +1,180 @@
+#include "packet_stats.hpp"
+
+using namespace geode::prelude;
+
+constexpr static auto RELAXED = std::memory_order::relaxed;
+
+void PacketStats::record(const Packet& packet, Direction direction, size_t bytes, bool fragmented) {
+    auto* slot = this->findSlot(packet.getPacketId(), packet.getPacketName());
+    if (!slot) return;
+
+    bool incoming = direction == Direction::Incoming;
+
+    (incoming ? slot->packetsIn : slot->packetsOut).fetch_add(1, RELAXED);
+    (incoming ? slot->bytesIn : slot->bytesOut).fetch_add(bytes, RELAXED);
+    (packet.getEncrypted() ? slot->encrypted : slot->cleartext).fetch_add(1, RELAXED);
+    (fragmented ? slot->fragmented : slot->whole).fetch_add(1, RELAXED);
+
+    uint32_t second = this->currentSecond();
+    auto& bucket = slot->buckets[second % BUCKETS];
+
+    addToBucket(incoming ? bucket.packetsIn : bucket.packetsOut, second, 1);
+    addToBucket(incoming ? bucket.bytesIn : bucket.bytesOut, second, bytes);
+}
+
+uint64_t PacketStats::total(packetid_t id, Direction direction) {
+    auto* slot = this->findExistingSlot(id);
+    if (!slot) return 0;
+
+    return (direction == Direction::Incoming ? slot->packetsIn : slot->packetsOut).load(RELAXED);
+}
+
+std::vector<PacketStats::Snapshot> PacketStats::snapshot() {
+    std::vector<Snapshot> out;
+
+    uint32_t now = this->currentSecond();
+
+    for (auto& slot : slots) {
+        uint32_t id = slot.id.load(std::memory_order::acquire);
+        if (id == EMPTY_SLOT) continue;
+
+        Snapshot snap {
+            .id = static_cast<packetid_t>(id),
+            .name = slot.name.load(std::memory_order::acquire),
+            .packetsIn = slot.packetsIn.load(RELAXED),
+            .packetsOut = slot.packetsOut.load(RELAXED),
+            .bytesIn = slot.bytesIn.load(RELAXED),
+            .bytesOut = slot.bytesOut.load(RELAXED),
+            .encrypted = slot.encrypted.load(RELAXED),
+            .cleartext = slot.cleartext.load(RELAXED),
+            .fragmented = slot.fragmented.load(RELAXED),
+            .whole = slot.whole.load(RELAXED),
+        };
+
+        // only complete seconds count, the current one is still being filled
+        for (uint32_t ago = 1; ago <= 10 && ago <= now; ago++) {
+            uint32_t second = now - ago;
+            auto& bucket = slot.buckets[second % BUCKETS];
+
+            // counters still holding an older second had no packets in this one
+            float packetsIn = readBucket(bucket.packetsIn, second);
+            float packetsOut = readBucket(bucket.packetsOut, second);
+            float bytesIn = readBucket(bucket.bytesIn, second);
+            float bytesOut = readBucket(bucket.bytesOut, second);
+
+            if (ago == 1) {
+                snap.packetsIn1s = packetsIn;
+                snap.packetsOut1s = packetsOut;
+                snap.bytesIn1s = bytesIn;
+                snap.bytesOut1s = bytesOut;
+            }
+
+            snap.packetsIn10s += packetsIn;
+            snap.packetsOut10s += packetsOut;
+            snap.bytesIn10s += bytesIn;
+            snap.bytesOut10s += bytesOut;
+        }
+
+        // right after startup there aren't 10 seconds to average over yet
+        float window = std::clamp<uint32_t>(now, 1, 10);
+        snap.packetsIn10s /= window;
+        snap.packetsOut10s /= window;
+        snap.bytesIn10s /= window;
+        snap.bytesOut10s /= window;
+
+        out.push_back(snap);
+    }
+
+    return out;
+}
+
+PacketStats::Snapshot PacketStats::sum(const std::vector<Snapshot>& snapshots) {
+    Snapshot total;
+
+    for (auto& snap : snapshots) {
+        total.packetsIn += snap.packetsIn;
+        total.packetsOut += snap.packetsOut;
+        total.bytesIn += snap.bytesIn;
+        total.bytesOut += snap.bytesOut;
+        total.encrypted += snap.encrypted;
+        total.cleartext += snap.cleartext;
+        total.fragmented += snap.fragmented;
+        total.whole += snap.whole;
+
+        total.packetsIn1s += snap.packetsIn1s;
+        total.packetsOut1s += snap.packetsOut1s;
+        total.packetsIn10s += snap.packetsIn10s;
+        total.packetsOut10s += snap.packetsOut10s;
+        total.bytesIn1s += snap.bytesIn1s;
+        total.bytesOut1s += snap.bytesOut1s;
+        total.bytesIn10s += snap.bytesIn10s;
+        total.bytesOut10s += snap.bytesOut10s;
+    }
+
+    return total;
+}
+
+PacketStats::Slot* PacketStats::findSlot(packetid_t id, const char* name) {
+    // open addressing, slots are claimed once and never freed
+    size_t start = (id * 2654435761u) % MAX_TYPES;
+
+    for (size_t i = 0; i < MAX_TYPES; i++) {
+        auto& slot = slots[(start + i) % MAX_TYPES];
+
+        uint32_t current = slot.id.load(std::memory_order::acquire);
+        if (current == id) return &slot;
+
+        if (current == EMPTY_SLOT) {
+            // a reader can briefly see the id without the name, snapshots handle a null name
+            if (slot.id.compare_exchange_strong(current, id, std::memory_order::acq_rel)) {
+                slot.name.store(name, std::memory_order::release);
+                return &slot;
+            }
+
+            // someone else claimed it first, maybe for the same id
+            if (current == id) return &slot;
+        }
+    }
+
+    // all slots taken, should never happen
+    return nullptr;
+}
+
+PacketStats::Slot* PacketStats::findExistingSlot(packetid_t id) {
+    // same probing as findSlot, but doesn't claim a slot for a type that was never seen
+    size_t start = (id * 2654435761u) % MAX_TYPES;
+
+    for (size_t i = 0; i < MAX_TYPES; i++) {
+        auto& slot = slots[(start + i) % MAX_TYPES];
+
+        uint32_t current = slot.id.load(std::memory_order::acquire);
+        if (current == id) return &slot;
+        if (current == EMPTY_SLOT) return nullptr;
+    }
+
+    return nullptr;
+}
+
+uint32_t PacketStats::currentSecond() {
+    return static_cast<uint32_t>(startedAt.elapsed().millis() / 1000);
+}
+
+void PacketStats::addToBucket(std::atomic<uint64_t>& counter, uint32_t second, uint32_t amount) {
+    uint64_t current = counter.load(RELAXED);
+    uint64_t next;
+
+    // the first packet in a new second replaces whatever was left from BUCKETS seconds ago.
+    // a single packet type never gets near 4 GB in one second, so the count can't overflow into the second
+    do {
+        if (static_cast<uint32_t>(current >> 32) == second) {
+            next = current + amount;
+        } else {
+            next = (static_cast<uint64_t>(second) << 32) | amount;
+        }
+    } while (!counter.compare_exchange_weak(current, next, RELAXED));
+}
+
+uint32_t PacketStats::readBucket(const std::atomic<uint64_t>& counter, uint32_t second) {
+    uint64_t value = counter.load(RELAXED);
+    return static_cast<uint32_t>(value >> 32) == second ? static_cast<uint32_t>(value) : 0;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <data/packets/packet.hpp>
+#include <util/singleton.hpp>
+
+#include <asp/time/Instant.hpp>
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+/*
+* Always-on traffic counters for every packet type: packets and bytes in each direction, encrypted vs cleartext,
+* fragmented vs whole, and rolling per-second rates over the last 1 and 10 seconds.
+*
+* Packets are recorded from more than one thread: outgoing ones on the main network thread,
+* incoming ones on the receive thread and wherever reliable frames are reassembled. Recording never locks,
+* the totals are relaxed atomic adds and the per-second buckets are updated with a compare-exchange, so no packet is lost.
+* Reading takes a snapshot that may be slightly torn between counters, which doesn't matter for display purposes.
+*/
+class PacketStats : public SingletonLeakBase<PacketStats> {
+    friend class SingletonLeakBase;
+    PacketStats() = default;
+
+public:
+    enum class Direction {
+        Incoming,
+        Outgoing,
+    };
+
+    struct Snapshot {
+        packetid_t id = 0;
+        const char* name = nullptr; // can be null for a packet type that was only just seen
+
+        uint64_t packetsIn = 0, packetsOut = 0;
+        uint64_t bytesIn = 0, bytesOut = 0;
+        uint64_t encrypted = 0, cleartext = 0;
+        uint64_t fragmented = 0, whole = 0;
+
+        // rolling rates, per second
+        float packetsIn1s = 0.f, packetsOut1s = 0.f, packetsIn10s = 0.f, packetsOut10s = 0.f;
+        float bytesIn1s = 0.f, bytesOut1s = 0.f, bytesIn10s = 0.f, bytesOut10s = 0.f;
+    };
+
+    // `bytes` is the size of the packet as it was sent or received, before decryption.
+    // `fragmented` is for packets that arrived split into multiple UDP frames.
+    void record(const Packet& packet, Direction direction, size_t bytes, bool fragmented = false);
+
+    // How many packets of this type were sent or received so far
+    uint64_t total(packetid_t id, Direction direction);
+
+    // Every packet type seen so far, in no particular order
+    std::vector<Snapshot> snapshot();
+
+    // All the given snapshots added together, with the id and name left empty
+    static Snapshot sum(const std::vector<Snapshot>& snapshots);
+
+private:
+    constexpr static size_t MAX_TYPES = 256; // there are way less packet types than this, which keeps the probing short
+    constexpr static uint32_t EMPTY_SLOT = UINT32_MAX;
+
+    // one per second, enough to cover the last 10 seconds plus the one that is currently being filled
+    constexpr static size_t BUCKETS = 12;
+
+    // each counter holds the second it belongs to in the upper 32 bits and the count in the lower 32,
+    // so moving on to a new second and adding the first packet to it is one atomic step
+    struct Bucket {
+        std::atomic<uint64_t> packetsIn = 0, packetsOut = 0;
+        std::atomic<uint64_t> bytesIn = 0, bytesOut = 0;
+    };
+
+    struct Slot {
+        std::atomic<uint32_t> id = EMPTY_SLOT;
+        std::atomic<const char*> name = nullptr;
+
+        std::atomic<uint64_t> packetsIn = 0, packetsOut = 0;
+        std::atomic<uint64_t> bytesIn = 0, bytesOut = 0;
+        std::atomic<uint64_t> encrypted = 0, cleartext = 0;
+        std::atomic<uint64_t> fragmented = 0, whole = 0;
+
+        std::array<Bucket, BUCKETS> buckets;
+    };
+
+    std::array<Slot, MAX_TYPES> slots;
+    asp::time::Instant startedAt = asp::time::Instant::now();
+
+    Slot* findSlot(packetid_t id, const char* name);
+    Slot* findExistingSlot(packetid_t id);
+    uint32_t currentSecond();
+
+    static void addToBucket(std::atomic<uint64_t>& counter, uint32_t second, uint32_t amount);
+    static uint32_t readBucket(const std::atomic<uint64_t>& counter, uint32_t second);
+};
@@ -0,0 +1,342 @@
+#include "reliable_channel.hpp"
+
+#include <data/bytebuffer.hpp>
+
+#include <algorithm>
+
+using namespace geode::prelude;
+
+ReliableChannel::ReliableChannel() {}
+
+uint8_t ReliableChannel::channelFor(packetid_t id) {
+    return (id / 1000) % CHANNEL_COUNT;
+}
+
+Result<std::vector<ReliableChannel::Datagram>> ReliableChannel::send(uint8_t channel, const util::data::byte* data, size_t size, size_t mtu) {
+    GLOBED_REQUIRE_SAFE(channel < CHANNEL_COUNT, "invalid reliable channel")
+    GLOBED_REQUIRE_SAFE(mtu > DATA_HEADER_SIZE, "mtu is too small")
+
+    size_t chunkSize = mtu - DATA_HEADER_SIZE;
+    size_t chunkCount = std::max<size_t>((size + chunkSize - 1) / chunkSize, 1);
+
+    if (chunkCount > UINT8_MAX) {
+        return Err(fmt::format("packet is too big to be sent reliably ({} bytes)", size));
+    }
+
+    auto& chan = outgoing[channel];
+
+    for (size_t i = 0; i < chunkCount; i++) {
+        size_t start = i * chunkSize;
+        size_t length = std::min(chunkSize, size - start);
+
+        ByteBuffer bb;
+        bb.writeU8(MARKER);
+        bb.writeU8(static_cast<uint8_t>(FrameType::Data));
+        bb.writeU8(channel);
+        bb.writeU32(chan.nextSeq);
+        bb.writeU8(static_cast<uint8_t>(i));
+        bb.writeU8(static_cast<uint8_t>(chunkCount));
+
+        Datagram frame = std::move(bb.data());
+        frame.insert(frame.end(), data + start, data + start + length);
+
+        chan.waiting.emplace_back(chan.nextSeq++, OutFrame {
+            .data = std::move(frame),
+        });
+    }
+
+    std::vector<Datagram> out;
+    this->fillWindow(chan, out);
+
+    return Ok(std::move(out));
+}
+
+Result<std::vector<ReliableChannel::Datagram>> ReliableChannel::receive(ByteBuffer& buf, std::vector<Datagram>& replies) {
+    auto typeres = buf.readU8();
+    if (!typeres) {
+        return Err(ByteBuffer::strerror(typeres.unwrapErr()));
+    }
+
+    uint8_t type = typeres.unwrap();
+    std::vector<Datagram> completed;
+
+    switch (static_cast<FrameType>(type)) {
+        case FrameType::Data: {
+            GLOBED_UNWRAP(this->handleData(buf, replies, completed));
+        } break;
+
+        case FrameType::Ack: {
+            GLOBED_UNWRAP(this->handleAck(buf));
+        } break;
+
+        case FrameType::Hello: {
+            replies.push_back(this->makeControl(FrameType::HelloAck));
+        } break;
+
+        case FrameType::HelloAck: {
+            established = true;
+        } break;
+
+        default: return Err(fmt::format("invalid reliable frame type: {}", type));
+    }
+
+    return Ok(std::move(completed));
+}
+
+Result<> ReliableChannel::handleData(ByteBuffer& buf, std::vector<Datagram>& replies, std::vector<Datagram>& completed) {
+    uint8_t channel, index, count;
+    uint32_t seq;
+
+    auto rres = [&]() -> ByteBuffer::DecodeResult<> {
+        GLOBED_UNWRAP_INTO(buf.readU8(), channel);
+        GLOBED_UNWRAP_INTO(buf.readU32(), seq);
+        GLOBED_UNWRAP_INTO(buf.readU8(), index);
+        GLOBED_UNWRAP_INTO(buf.readU8(), count);
+
+        return Ok();
+    }();
+
+    if (!rres) {
+        return Err(ByteBuffer::strerror(rres.unwrapErr()));
+    }
+
+    GLOBED_REQUIRE_SAFE(channel < CHANNEL_COUNT, "invalid reliable channel")
+    GLOBED_REQUIRE_SAFE(index < count, "reliable frame index/count invalid")
+
+    auto& chan = incoming[channel];
+    stats.framesReceived++;
+
+    // sequence numbers are 32-bit and start at 0 for every connection, so wrapping around is not a concern
+    if (seq < chan.nextExpected || chan.buffered.contains(seq)) {
+        // our ack was probably lost, send it again
+        stats.duplicates++;
+        replies.push_back(this->makeAck(channel));
+        return Ok();
+    }
+
+    if (seq - chan.nextExpected >= WINDOW) {
+        // way ahead of what we expect, the peer will resend it later
+        return Ok();
+    }
+
+    Datagram data(buf.size() - buf.getPosition());
+    auto readres = buf.readBytesInto(data.data(), data.size());
+    if (!readres) {
+        return Err(ByteBuffer::strerror(readres.unwrapErr()));
+    }
+
+    chan.buffered.emplace(seq, InFrame {
+        .index = index,
+        .count = count,
+        .data = std::move(data),
+    });
+
+    // deliver everything that is now in order
+    for (auto it = chan.buffered.begin(); it != chan.buffered.end() && it->first == chan.nextExpected; it = chan.buffered.erase(it)) {
+        auto& frame = it->second;
+
+        GLOBED_REQUIRE_SAFE(frame.index == chan.nextFragment, "reliable fragments out of order")
+
+        chan.assembling.insert(chan.assembling.end(), frame.data.begin(), frame.data.end());
+        chan.nextExpected++;
+
+        if (frame.index + 1 == frame.count) {
+            completed.push_back(std::move(chan.assembling));
+            chan.assembling.clear();
+            chan.nextFragment = 0;
+        } else {
+            chan.nextFragment++;
+        }
+    }
+
+    replies.push_back(this->makeAck(channel));
+
+    return Ok();
+}
+
+Result<> ReliableChannel::handleAck(ByteBuffer& buf) {
+    uint8_t channel;
+    uint32_t nextExpected, mask;
+
+    auto rres = [&]() -> ByteBuffer::DecodeResult<> {
+        GLOBED_UNWRAP_INTO(buf.readU8(), channel);
+        GLOBED_UNWRAP_INTO(buf.readU32(), nextExpected);
+        GLOBED_UNWRAP_INTO(buf.readU32(), mask);
+
+        return Ok();
+    }();
+
+    if (!rres) {
+        return Err(ByteBuffer::strerror(rres.unwrapErr()));
+    }
+
+    GLOBED_REQUIRE_SAFE(channel < CHANNEL_COUNT, "invalid reliable channel")
+
+    auto& chan = outgoing[channel];
+
+    std::optional<uint64_t> rttSample;
+    uint32_t highestAcked = 0;
+    bool ackedAny = false;
+
+    auto ack = [&](std::map<uint32_t, OutFrame>::iterator it) {
+        // Karn's algorithm, the rtt of a resent frame is ambiguous
+        if (it->second.transmissions == 1) {
+            rttSample = it->second.sentAt.elapsed().micros();
+        }
+
+        highestAcked = std::max(highestAcked, it->first);
+        ackedAny = true;
+
+        return chan.inFlight.erase(it);
+    };
+
+    // everything before `nextExpected` has been received
+    for (auto it = chan.inFlight.begin(); it != chan.inFlight.end() && it->first < nextExpected;) {
+        it = ack(it);
+    }
+
+    // and selectively the frames after it
+    for (uint32_t bit = 0; bit < 32; bit++) {
+        if (!(mask & (1u << bit))) continue;
+
+        auto it = chan.inFlight.find(nextExpected + 1 + bit);
+        if (it != chan.inFlight.end()) {
+            ack(it);
+        }
+    }
+
+    if (rttSample) {
+        this->addRttSample(*rttSample);
+    }
+
+    // frames that were skipped over by enough later acks are most likely lost
+    if (ackedAny) {
+        for (auto& [seq, frame] : chan.inFlight) {
+            if (seq + FAST_RETRANSMIT_THRESHOLD > highestAcked) break;
+
+            if (frame.transmissions == 1) {
+                frame.resendNow = true;
+            }
+        }
+    }
+
+    return Ok();
+}
+
+Result<std::vector<ReliableChannel::Datagram>> ReliableChannel::poll() {
+    std::vector<Datagram> out;
+
+    for (auto& chan : outgoing) {
+        for (auto& [seq, frame] : chan.inFlight) {
+            if (!frame.resendNow && frame.sentAt.elapsed().micros() < this->timeoutFor(frame)) continue;
+
+            if (frame.transmissions >= MAX_TRANSMISSIONS) {
+                return Err(fmt::format("reliable frame {} was not acknowledged after {} attempts", seq, frame.transmissions));
+            }
+
+            stats.framesResent++;
+            this->transmit(frame, out);
+        }
+
+        this->fillWindow(chan, out);
+    }
+
+    return Ok(std::move(out));
+}
+
+ReliableChannel::Datagram ReliableChannel::makeHello() {
+    return this->makeControl(FrameType::Hello);
+}
+
+bool ReliableChannel::isEstablished() {
+    return established;
+}
+
+void ReliableChannel::reset() {
+    outgoing = {};
+    incoming = {};
+    established = false;
+    stats = {};
+    srtt = 0;
+    rttvar = 0;
+    rto = INITIAL_RTO;
+}
+
+ReliableChannel::Stats ReliableChannel::getStats() {
+    Stats out = stats;
+    out.srttMicros = srtt;
+    out.rtoMicros = rto;
+
+    for (auto& chan : outgoing) {
+        out.inFlight += chan.inFlight.size();
+    }
+
+    return out;
+}
+
+ReliableChannel::Datagram ReliableChannel::makeAck(uint8_t channel) {
+    auto& chan = incoming[channel];
+
+    uint32_t mask = 0;
+    for (auto& [seq, _] : chan.buffered) {
+        uint32_t offset = seq - chan.nextExpected - 1;
+        if (offset >= 32) break;
+
+        mask |= 1u << offset;
+    }
+
+    ByteBuffer bb;
+    bb.writeU8(MARKER);
+    bb.writeU8(static_cast<uint8_t>(FrameType::Ack));
+    bb.writeU8(channel);
+    bb.writeU32(chan.nextExpected);
+    bb.writeU32(mask);
+
+    return std::move(bb.data());
+}
+
+ReliableChannel::Datagram ReliableChannel::makeControl(FrameType type) {
+    ByteBuffer bb;
+    bb.writeU8(MARKER);
+    bb.writeU8(static_cast<uint8_t>(type));
+
+    return std::move(bb.data());
+}
+
+void ReliableChannel::transmit(OutFrame& frame, std::vector<Datagram>& out) {
+    frame.sentAt = asp::time::Instant::now();
+    frame.transmissions++;
+    frame.resendNow = false;
+
+    stats.framesSent++;
+    out.push_back(frame.data);
+}
+
+void ReliableChannel::fillWindow(OutChannel& chan, std::vector<Datagram>& out) {
+    while (!chan.waiting.empty() && chan.inFlight.size() < WINDOW) {
+        auto [seq, frame] = std::move(chan.waiting.front());
+        chan.waiting.pop_front();
+
+        auto& inserted = chan.inFlight.emplace(seq, std::move(frame)).first->second;
+        this->transmit(inserted, out);
+    }
+}
+
+void ReliableChannel::addRttSample(uint64_t micros) {
+    if (srtt == 0) {
+        srtt = micros;
+        rttvar = micros / 2;
+    } else {
+        uint64_t delta = srtt > micros ? srtt - micros : micros - srtt;
+        rttvar = (3 * rttvar + delta) / 4;
+        srtt = (7 * srtt + micros) / 8;
+    }
+
+    rto = std::clamp(srtt + 4 * rttvar, MIN_RTO, MAX_RTO);
+}
+
+uint64_t ReliableChannel::timeoutFor(const OutFrame& frame) {
+    // exponential backoff for every retry
+    size_t shift = std::min<size_t>(frame.transmissions - 1, 5);
+    return std::min(rto << shift, MAX_RTO);
+}
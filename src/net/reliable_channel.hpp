@@ -0,0 +1,138 @@
+#pragma once
+
+#include <defs/minimal_geode.hpp>
+#include <data/packets/packet.hpp>
+#include <util/data.hpp>
+
+#include <asp/time/Instant.hpp>
+
+#include <array>
+#include <deque>
+#include <map>
+
+class ByteBuffer;
+
+/*
+* Reliable, ordered delivery over UDP, for the packets that would otherwise go over TCP.
+*
+* Packets are split into independent channels by their category (connection, general, game, room, admin..),
+* so a lost datagram only holds back later packets in its own channel, instead of everything like with TCP.
+*
+* Every frame has a per-channel sequence number. The receiver acknowledges with the next sequence number it expects,
+* plus a bitmask of the 32 frames after that which it already has (selective ACK), so only the frames that were actually lost get resent.
+* Retransmission timers follow RFC 6298 (smoothed RTT + 4 * RTT variance, doubled on every retry).
+* Packets bigger than the MTU are split into multiple frames with an index and a count, like `MARKER_UDP_FRAME` packets.
+*
+* This class only implements the protocol, actually sending and receiving the datagrams is up to `GameSocket`.
+* Not thread safe.
+*/
+class ReliableChannel {
+public:
+    static constexpr uint8_t MARKER = 0xa9;
+
+    static constexpr size_t CHANNEL_COUNT = 10;
+    // max unacknowledged frames per channel, and how far ahead of the next expected frame the receiver buffers
+    static constexpr uint32_t WINDOW = 256;
+    // after this many transmissions of the same frame, the connection is considered dead
+    static constexpr size_t MAX_TRANSMISSIONS = 10;
+
+    enum class FrameType : uint8_t {
+        Data = 0,
+        Ack = 1,
+        Hello = 2,
+        HelloAck = 3,
+    };
+
+    using Datagram = util::data::bytevector;
+
+    struct Stats {
+        uint64_t framesSent = 0;
+        uint64_t framesResent = 0;
+        uint64_t framesReceived = 0;
+        uint64_t duplicates = 0;
+        uint64_t srttMicros = 0;
+        uint64_t rtoMicros = 0;
+        size_t inFlight = 0;
+    };
+
+    ReliableChannel();
+
+    // Packets of the same category (the thousands digit of the id) share a channel
+    static uint8_t channelFor(packetid_t id);
+
+    // Splits an encoded packet into frames and queues them for sending. Returns the datagrams that should be sent right away,
+    // anything that doesn't fit in the window yet is returned by a later `poll`.
+    Result<std::vector<Datagram>> send(uint8_t channel, const util::data::byte* data, size_t size, size_t mtu);
+
+    // Handles a datagram that started with `MARKER`, the marker must already be read.
+    // Datagrams that have to be sent back to the peer are appended to `replies`.
+    // Returns the packets that were completed by this datagram, in order.
+    Result<std::vector<Datagram>> receive(ByteBuffer& buf, std::vector<Datagram>& replies);
+
+    // Returns frames whose retransmission timer expired and frames that now fit in the window.
+    // Fails if a frame went unacknowledged for too long, which means the connection is most likely dead.
+    Result<std::vector<Datagram>> poll();
+
+    // Datagram asking the peer whether it supports reliable frames, answered with `HelloAck`
+    Datagram makeHello();
+
+    // Whether the peer answered our hello
+    bool isEstablished();
+
+    void reset();
+    Stats getStats();
+
+private:
+    static constexpr size_t DATA_HEADER_SIZE = 9; // marker, type, channel, seq, fragment index, fragment count
+    static constexpr uint64_t INITIAL_RTO = 500'000;
+    static constexpr uint64_t MIN_RTO = 100'000;
+    static constexpr uint64_t MAX_RTO = 3'000'000;
+    // how many later frames must be acknowledged before a missing one is resent without waiting for its timer
+    static constexpr uint32_t FAST_RETRANSMIT_THRESHOLD = 3;
+
+    struct OutFrame {
+        Datagram data;
+        asp::time::Instant sentAt = asp::time::Instant::now();
+        size_t transmissions = 0;
+        bool resendNow = false;
+    };
+
+    struct OutChannel {
+        uint32_t nextSeq = 0;
+        std::map<uint32_t, OutFrame> inFlight;
+        std::deque<std::pair<uint32_t, OutFrame>> waiting; // queued while the window is full
+    };
+
+    struct InFrame {
+        uint8_t index;
+        uint8_t count;
+        Datagram data;
+    };
+
+    struct InChannel {
+        uint32_t nextExpected = 0;
+        std::map<uint32_t, InFrame> buffered;
+        Datagram assembling; // fragments of a packet received so far
+        uint8_t nextFragment = 0;
+    };
+
+    std::array<OutChannel, CHANNEL_COUNT> outgoing;
+    std::array<InChannel, CHANNEL_COUNT> incoming;
+    bool established = false;
+    Stats stats;
+
+    // RFC 6298 estimates, in microseconds
+    uint64_t srtt = 0;
+    uint64_t rttvar = 0;
+    uint64_t rto = INITIAL_RTO;
+
+    Result<> handleData(ByteBuffer& buf, std::vector<Datagram>& replies, std::vector<Datagram>& completed);
+    Result<> handleAck(ByteBuffer& buf);
+    Datagram makeAck(uint8_t channel);
+    Datagram makeControl(FrameType type);
+
+    void transmit(OutFrame& frame, std::vector<Datagram>& out);
+    void fillWindow(OutChannel& channel, std::vector<Datagram>& out);
+    void addRttSample(uint64_t micros);
+    uint64_t timeoutFor(const OutFrame& frame);
+};
@@ -0,0 +1,98 @@
+#include "send_rate_controller.hpp"
+
+#include <algorithm>
+
+using namespace asp::time;
+
+void SendRateController::reset(float maxRate) {
+    *this = SendRateController{};
+
+    this->maxRate = maxRate;
+    this->minRate = std::min(MIN_RATE, maxRate);
+    this->rate = maxRate;
+}
+
+void SendRateController::updateCounts(uint64_t sent, uint64_t answered) {
+    // the totals include everything from before the reset, only what comes after counts
+    if (!haveCounts) {
+        haveCounts = true;
+        windowStartSent = sent;
+        windowStartAnswered = answered;
+    }
+
+    totalSent = sent;
+    totalAnswered = answered;
+}
+
+void SendRateController::updateRtt(uint64_t micros) {
+    if (micros == 0 || micros == rtt) return;
+
+    prevRtt = rtt;
+    rtt = micros;
+    newRttSample = true;
+
+    nextBaseRtt = nextBaseRtt == 0 ? micros : std::min(nextBaseRtt, micros);
+}
+
+bool SendRateController::update() {
+    if (windowStart.elapsed().micros() < WINDOW) return false;
+
+    if (baseRttStart.elapsed().micros() >= BASE_RTT_WINDOW) {
+        baseRtt = nextBaseRtt;
+        nextBaseRtt = 0;
+        baseRttStart = Instant::now();
+    }
+
+    uint64_t sent = totalSent - windowStartSent, answered = totalAnswered - windowStartAnswered;
+
+    windowStart = Instant::now();
+    windowStartSent = totalSent;
+    windowStartAnswered = totalAnswered;
+
+    if (sent < MIN_WINDOW_PACKETS) return false;
+
+    // answers to packets from the previous window can make this negative right after the rate goes down
+    float loss = std::clamp(1.f - static_cast<float>(answered) / sent, 0.f, 1.f);
+    lastLoss = loss;
+
+    // how much longer packets take than they do on an idle link
+    uint64_t base = this->lowestRtt();
+    uint64_t queueDelay = rtt > base ? rtt - base : 0;
+
+    uint64_t highDelay = std::max<uint64_t>(40'000, base / 2);
+    uint64_t lowDelay = std::max<uint64_t>(15'000, base / 8);
+    bool rttRising = prevRtt != 0 && rtt > prevRtt + 10'000;
+
+    // a ping is only measured every few seconds, so a high one should only cause a single cut
+    bool highRtt = newRttSample && queueDelay > highDelay;
+    newRttSample = false;
+
+    float prevRate = rate;
+
+    if (loss > HIGH_LOSS || highRtt) {
+        rate = std::max(minRate, rate * DECREASE_FACTOR);
+    } else if (loss < LOW_LOSS && queueDelay < lowDelay && !rttRising) {
+        rate = std::min(maxRate, rate + INCREASE_STEP);
+    }
+
+    return rate != prevRate;
+}
+
+float SendRateController::getRate() {
+    return rate;
+}
+
+float SendRateController::getInterval() {
+    return 1.f / rate;
+}
+
+float SendRateController::getLoss() {
+    return lastLoss;
+}
+
+uint64_t SendRateController::lowestRtt() {
+    if (baseRtt == 0) return nextBaseRtt;
+    if (nextBaseRtt == 0) return baseRtt;
+
+    return std::min(baseRtt, nextBaseRtt);
+}
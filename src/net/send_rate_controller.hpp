@@ -0,0 +1,77 @@
+#pragma once
+
+#include <asp/time/Instant.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+* Congestion control for player data, picks how many `PlayerDataPacket`s are sent per second.
+*
+* Loss is measured by counting answers, the server answers every `PlayerDataPacket` with a `LevelDataPacket`.
+* Both counts come from `PacketStats`, so only packets that actually went through the socket are counted:
+* player data that was coalesced in the send queue and level data injected locally (synthetic crowd, packet replay) are not.
+* The answers can't be told apart, so they aren't used for the RTT, that comes from the keepalive ping instead,
+* compared against the lowest ping seen recently. A ping well above that means packets are piling up in a queue somewhere.
+*
+* Once a second the rate is re-evaluated: on high loss or a high ping it's cut by a factor,
+* and if the link looks clear it grows by a small step, up to the server TPS. Otherwise it stays where it is.
+*
+* Must only be used from one thread.
+*/
+class SendRateController {
+public:
+    // Starts at `maxRate`, the same as before there was any congestion control
+    void reset(float maxRate);
+
+    // Total player data packets sent and level data packets received so far, they only have to grow between calls
+    void updateCounts(uint64_t sent, uint64_t answered);
+
+    // The latest ping to the server, can be called with the same value repeatedly, only changes count as a new sample
+    void updateRtt(uint64_t micros);
+
+    // Re-evaluates the rate if enough time passed, returns true if it changed
+    bool update();
+
+    // Packets per second
+    float getRate();
+
+    // Seconds between packets
+    float getInterval();
+
+    // In the last evaluated window, from 0 to 1
+    float getLoss();
+
+private:
+    static constexpr float MIN_RATE = 10.f;
+    static constexpr float INCREASE_STEP = 2.f;
+    static constexpr float DECREASE_FACTOR = 0.75f;
+
+    static constexpr float HIGH_LOSS = 0.1f;
+    static constexpr float LOW_LOSS = 0.02f;
+
+    // below this many packets in a window (such as when alone on a level) there is not enough data to decide anything
+    static constexpr size_t MIN_WINDOW_PACKETS = 5;
+
+    // in microseconds
+    static constexpr uint64_t WINDOW = 1'000'000;
+    static constexpr uint64_t BASE_RTT_WINDOW = 10'000'000;
+
+    float rate = MIN_RATE, minRate = MIN_RATE, maxRate = MIN_RATE;
+
+    asp::time::Instant windowStart = asp::time::Instant::now();
+    bool haveCounts = false;
+    uint64_t totalSent = 0, totalAnswered = 0;
+    uint64_t windowStartSent = 0, windowStartAnswered = 0; // the totals when the current window started
+    float lastLoss = 0.f;
+
+    // in microseconds
+    uint64_t rtt = 0;
+    uint64_t prevRtt = 0;
+    bool newRttSample = false;
+    uint64_t baseRtt = 0; // lowest rtt in the previous BASE_RTT_WINDOW
+    uint64_t nextBaseRtt = 0; // lowest rtt in the current one
+    asp::time::Instant baseRttStart = asp::time::Instant::now();
+
+    uint64_t lowestRtt();
+};
@@ -0,0 +1,197 @@
+#include "send_scheduler.hpp"
+
+#include <data/packets/client/game.hpp>
+#include <data/packets/client/general.hpp>
+#include <data/packets/client/room.hpp>
+#include <util/memory.hpp>
+
+#include <utility>
+
+using namespace asp::time;
+
+SendScheduler::Priority SendScheduler::priorityFor(packetid_t id) {
+    switch (id) {
+#ifdef GLOBED_VOICE_SUPPORT
+        case VoicePacket::PACKET_ID:
+            return Priority::Voice;
+#endif
+
+        case PlayerDataPacket::PACKET_ID:
+            return Priority::PlayerState;
+
+        // requests for lists and profiles, nothing breaks if these take a bit longer
+        case SyncIconsPacket::PACKET_ID:
+        case RequestGlobalPlayerListPacket::PACKET_ID:
+        case RequestLevelListPacket::PACKET_ID:
+        case RequestPlayerCountPacket::PACKET_ID:
+        case RequestMotdPacket::PACKET_ID:
+        case RequestPlayerProfilesPacket::PACKET_ID:
+        case RequestPlayerProfilesBatchPacket::PACKET_ID:
+        case RequestRoomPlayerListPacket::PACKET_ID:
+        case RequestRoomListPacket::PACKET_ID:
+            return Priority::Bulk;
+
+        default:
+            return Priority::Control;
+    }
+}
+
+bool SendScheduler::isBarrier(packetid_t id) {
+    switch (id) {
+        // the server handles packets like player data and voice based on the level or room the client is in
+        case LevelJoinPacket::PACKET_ID:
+        case LevelLeavePacket::PACKET_ID:
+        case CreateRoomPacket::PACKET_ID:
+        case JoinRoomPacket::PACKET_ID:
+        case LeaveRoomPacket::PACKET_ID:
+        case CloseRoomPacket::PACKET_ID:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+const char* SendScheduler::priorityName(Priority priority) {
+    switch (priority) {
+        case Priority::Voice: return "voice";
+        case Priority::PlayerState: return "player state";
+        case Priority::Control: return "control";
+        case Priority::Bulk: return "bulk";
+    }
+
+    return "unknown";
+}
+
+std::shared_ptr<Packet> SendScheduler::push(std::shared_ptr<Packet> packet) {
+    auto priority = priorityFor(packet->getPacketId());
+    auto idx = static_cast<size_t>(priority);
+    bool barrier = isBarrier(packet->getPacketId());
+
+    auto s = state.lock();
+    auto& queue = s->queues[idx];
+
+    // only the newest player data matters, take the place of the one that is still waiting,
+    // unless a barrier was queued since then, the older one has to reach the server before it
+    if (priority == Priority::PlayerState) {
+        for (auto& queued : queue) {
+            if (queued.epoch != s->epoch || queued.packet->getPacketId() != packet->getPacketId()) continue;
+
+            // merging changes the size of both
+            size_t olderSize = queued.packet->getObjectSize();
+            if (!mergePlayerData(*queued.packet->tryDowncast<PlayerDataPacket>(), *packet->tryDowncast<PlayerDataPacket>())) break;
+
+            util::memory::remove(util::memory::Tag::OutgoingPackets, olderSize);
+            util::memory::add(util::memory::Tag::OutgoingPackets, packet->getObjectSize());
+
+            s->stats[idx].coalesced++;
+            queued.queuedAt = Instant::now();
+            return std::exchange(queued.packet, std::move(packet));
+        }
+    }
+
+    util::memory::add(util::memory::Tag::OutgoingPackets, packet->getObjectSize());
+
+    queue.push_back(Queued {
+        .packet = std::move(packet),
+        .queuedAt = Instant::now(),
+        .epoch = s->epoch,
+        .barrier = barrier,
+    });
+    s->size++;
+
+    // everything queued after a barrier is sent after it
+    if (barrier) {
+        s->epoch++;
+    }
+
+    return nullptr;
+}
+
+bool SendScheduler::mergePlayerData(PlayerDataPacket& older, PlayerDataPacket& newer) {
+    // the counter changes are only sent once, so the ones of the older packet go first in the newer one.
+    // the count is encoded as a u8, if both don't fit the packets are sent separately instead
+    if (older.counterChanges.size() + newer.counterChanges.size() > MAX_COUNTER_CHANGES) {
+        return false;
+    }
+
+    newer.counterChanges.insert(newer.counterChanges.begin(), older.counterChanges.begin(), older.counterChanges.end());
+
+    // metadata is only sent every few seconds, and the server only replies with the metadata of others when it's present
+    if (!newer.meta) {
+        newer.meta = std::move(older.meta);
+    }
+
+    return true;
+}
+
+std::shared_ptr<Packet> SendScheduler::pop() {
+    auto s = state.lock();
+
+    if (s->size == 0) return nullptr;
+
+    // packets from before the oldest queued barrier have to go first, queues are in the order of pushing so it's enough to look at the fronts
+    uint64_t oldestEpoch = UINT64_MAX;
+    for (auto& queue : s->queues) {
+        if (!queue.empty()) {
+            oldestEpoch = std::min(oldestEpoch, queue.front().epoch);
+        }
+    }
+
+    // within that, by priority, and the barrier itself once everything else from before it is sent
+    size_t chosen = PRIORITY_COUNT;
+    for (size_t idx = 0; idx < PRIORITY_COUNT; idx++) {
+        auto& queue = s->queues[idx];
+        if (queue.empty() || queue.front().epoch != oldestEpoch) continue;
+
+        if (!queue.front().barrier) {
+            chosen = idx;
+            break;
+        }
+
+        if (chosen == PRIORITY_COUNT) {
+            chosen = idx;
+        }
+    }
+
+    auto& queue = s->queues[chosen];
+
+    auto queued = std::move(queue.front());
+    queue.pop_front();
+    s->size--;
+
+    util::memory::remove(util::memory::Tag::OutgoingPackets, queued.packet->getObjectSize());
+
+    auto& stats = s->stats[chosen];
+    uint64_t delay = queued.queuedAt.elapsed().micros();
+
+    stats.sent++;
+    stats.maxDelayMicros = std::max(stats.maxDelayMicros, delay);
+
+    if (stats.sent == 1) {
+        stats.avgDelayMicros = delay;
+    } else {
+        stats.avgDelayMicros = (stats.avgDelayMicros * (DELAY_SMOOTHING - 1) + delay) / DELAY_SMOOTHING;
+    }
+
+    return std::move(queued.packet);
+}
+
+size_t SendScheduler::size() {
+    return state.lock()->size;
+}
+
+std::vector<SendQueueStats> SendScheduler::getStats() {
+    auto s = state.lock();
+
+    std::vector<SendQueueStats> out;
+
+    for (size_t idx = 0; idx < PRIORITY_COUNT; idx++) {
+        auto stats = s->stats[idx];
+        stats.name = priorityName(static_cast<Priority>(idx));
+        stats.queued = s->queues[idx].size();
+        out.push_back(stats);
+    }
+
+    return out;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <data/packets/packet.hpp>
+
+#include <asp/sync.hpp>
+#include <asp/time/Instant.hpp>
+
+#include <array>
+#include <deque>
+#include <vector>
+
+class PlayerDataPacket;
+
+struct SendQueueStats {
+    const char* name = nullptr;
+    uint64_t sent = 0;
+    uint64_t coalesced = 0; // packets that were replaced by a newer one before being sent
+    size_t queued = 0;
+    uint64_t avgDelayMicros = 0; // moving average of the time between queueing and sending
+    uint64_t maxDelayMicros = 0;
+};
+
+/*
+* Outgoing packet queue with priority classes. Packets of a higher class are sent first,
+* and packets within the same class are sent in the order they were queued.
+*
+* Joining or leaving a level or a room is a barrier: everything queued before it is sent before it,
+* and everything queued after it is sent after it, regardless of class. The server interprets packets like
+* player data and voice based on where the client is, so those must not overtake a join or a leave.
+*
+* Player data is latest-wins, if a `PlayerDataPacket` is queued while an older one is still waiting,
+* the older one is replaced instead of both being sent. The counter changes and metadata of the older one are carried over,
+* as they are only sent once.
+*
+* Queued packets are counted towards `util::memory::Tag::OutgoingPackets`.
+*
+* Thread safe.
+*/
+class SendScheduler {
+public:
+    enum class Priority : uint8_t {
+        Voice,
+        PlayerState,
+        Control,
+        Bulk,
+    };
+
+    static constexpr size_t PRIORITY_COUNT = 4;
+
+    static Priority priorityFor(packetid_t id);
+    static bool isBarrier(packetid_t id);
+    static const char* priorityName(Priority priority);
+
+    // Queues a packet. If it replaced an unsent packet, that packet is returned, otherwise nullptr.
+    std::shared_ptr<Packet> push(std::shared_ptr<Packet> packet);
+
+    // Takes the next packet to send, or nullptr if there is none
+    std::shared_ptr<Packet> pop();
+
+    size_t size();
+
+    std::vector<SendQueueStats> getStats();
+
+private:
+    // weight of a new sample in the average delay, as 1/N
+    static constexpr uint64_t DELAY_SMOOTHING = 8;
+    // counter changes in a single `PlayerDataPacket`, the count is encoded as a u8
+    static constexpr size_t MAX_COUNTER_CHANGES = 255;
+
+    struct Queued {
+        std::shared_ptr<Packet> packet;
+        asp::time::Instant queuedAt;
+        uint64_t epoch; // number of barriers queued before this packet
+        bool barrier;
+    };
+
+    struct State {
+        std::array<std::deque<Queued>, PRIORITY_COUNT> queues;
+        std::array<SendQueueStats, PRIORITY_COUNT> stats;
+        size_t size = 0;
+        uint64_t epoch = 0;
+    };
+
+    asp::Mutex<State> state;
+
+    // Moves the one-shot data of `older` into `newer`, returns false if it does not fit
+    static bool mergePlayerData(PlayerDataPacket& older, PlayerDataPacket& newer);
+};
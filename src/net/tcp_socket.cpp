@@ -2,6 +2,7 @@
 
 #include "address.hpp"
 #include <managers/settings.hpp>
+#include <net/flight_recorder.hpp>
 #include <asp/time/Instant.hpp>
 #include <util/net.hpp>
 
@@ -100,12 +101,12 @@ Result<int> TcpSocket::send(const char* data, unsigned int dataSize) {
     constexpr int flags = 0;
 #endif
 
-    globed::netLog("TcpSocket::send(this={}, fd={}, data={}, size={})", (void*)this, socket_.load(), (void*)data, dataSize);
-
     auto result = ::send(socket_, data, dataSize, flags);
+    globed::netRecord(NetFlightRecorder::Event::TcpSend, dataSize, result);
+
     if (result == -1) {
         auto code = util::net::lastErrorCode();
-        globed::netLog("TcpSocket::send(this={}) failed: code {}", (void*)this, code);
+        globed::netRecord(NetFlightRecorder::Event::SocketError, (uint32_t) NetFlightRecorder::ErrorSite::TcpSend, code);
 
         this->maybeDisconnect();
 
@@ -116,8 +117,6 @@ Result<int> TcpSocket::send(const char* data, unsigned int dataSize) {
 }
 
 Result<> TcpSocket::sendAll(const char* data, unsigned int dataSize) {
-    globed::netLog("TcpSocket::sendAll(this={}, fd={}, data={}, size={})", (void*)this, socket_.load(), (void*)data, dataSize);
-
     unsigned int totalSent = 0;
 
     do {
@@ -137,8 +136,6 @@ void TcpSocket::disconnect() {
 }
 
 RecvResult TcpSocket::receive(char* buffer, int bufferSize) {
-    globed::netLog("TcpSocket::receive(this={}, connected={}, buf={}, size={})", (void*)this, connected.load(), (void*)buffer, bufferSize);
-
     if (!connected) {
         return RecvResult {
             .fromServer = true,
@@ -148,9 +145,10 @@ RecvResult TcpSocket::receive(char* buffer, int bufferSize) {
 
     int result = ::recv(socket_, buffer, bufferSize, 0);
 
-    globed::netLog("TcpSocket::receive recv() result: {}", result);
+    globed::netRecord(NetFlightRecorder::Event::TcpReceive, bufferSize, result);
 
     if (result == -1) {
+        globed::netRecord(NetFlightRecorder::Event::SocketError, (uint32_t) NetFlightRecorder::ErrorSite::TcpReceive, util::net::lastErrorCode());
         this->maybeDisconnect();
     } else if (result == 0) {
         this->disconnect();
@@ -163,8 +161,6 @@ RecvResult TcpSocket::receive(char* buffer, int bufferSize) {
 }
 
 Result<> TcpSocket::recvExact(char* buffer, int bufferSize) {
-    globed::netLog("TcpSocket::recvExact(this={}, connected={}, buf={}, size={})", (void*)this, connected.load(), (void*)buffer, bufferSize);
-
     GLOBED_REQUIRE_SAFE(connected, "attempting to call TcpSocket::recvExact on a disconnected socket")
 
     unsigned int received = 0;
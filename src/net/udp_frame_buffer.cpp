@@ -36,7 +36,7 @@ Result<std::vector<uint8_t>> UdpFrameBuffer::pushFrameFromBuffer(ByteBuffer& buf
         }
     }
 
-    std::vector<uint8_t> data;
+    decltype(Frame::data) data;
     size_t remainderLength = buf.size() - buf.getPosition();
     data.resize(remainderLength);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <defs/minimal_geode.hpp>
+#include <util/memory.hpp>
 
 class ByteBuffer;
 
@@ -14,8 +15,12 @@ private:
     struct Frame {
         uint8_t idx;
         uint8_t max;
-        std::vector<uint8_t> data;
+        util::memory::TrackedVector<uint8_t, util::memory::Tag::UdpFrames> data;
     };
 
-    std::map<int, std::vector<Frame>> packets;
+    util::memory::TrackedMap<
+        int,
+        util::memory::TrackedVector<Frame, util::memory::Tag::UdpFrames>,
+        util::memory::Tag::UdpFrames
+    > packets;
 };
@@ -3,6 +3,7 @@
 #include "address.hpp"
 #include <defs/assert.hpp>
 #include <managers/settings.hpp>
+#include <net/flight_recorder.hpp>
 #include <util/net.hpp>
 
 #ifdef GEODE_IS_WINDOWS
@@ -63,13 +64,14 @@ Result<> UdpSocket::connect(const NetworkAddress& address) {
 Result<int> UdpSocket::send(const char* data, unsigned int dataSize) {
     GLOBED_REQUIRE_SAFE(connected, "attempting to call UdpSocket::send on a disconnected socket")
 
-    globed::netLog("UdpSocket::send(this={}, data={}, size={})", (void*)this, (void*)data, dataSize);
-
     int retval = sendto(socket_, data, dataSize, 0, reinterpret_cast<struct sockaddr*>(destAddr_.get()), sizeof(sockaddr_in));
 
+    globed::netRecord(NetFlightRecorder::Event::UdpSend, dataSize, retval);
+
     if (retval == -1) {
-        auto errmsg = util::net::lastErrorString();
-        globed::netLog("UdpSocket::send failed, code {}: {}", retval, errmsg);
+        auto code = util::net::lastErrorCode();
+        auto errmsg = util::net::lastErrorString(code);
+        globed::netRecord(NetFlightRecorder::Event::SocketError, (uint32_t) NetFlightRecorder::ErrorSite::UdpSend, code);
         return Err(fmt::format("sendto failed ({}): {}", retval, errmsg));
     }
 
@@ -89,8 +91,9 @@ Result<int> UdpSocket::sendTo(const char* data, unsigned int dataSize, const Net
     int retval = sendto(socket_, data, dataSize, 0, reinterpret_cast<struct sockaddr*>(addr.get()), sizeof(sockaddr));
 
     if (retval == -1) {
-        auto errmsg = util::net::lastErrorString();
-        globed::netLog("UdpSocket::sendTo failed, code {}: {}", retval, errmsg);
+        auto code = util::net::lastErrorCode();
+        auto errmsg = util::net::lastErrorString(code);
+        globed::netRecord(NetFlightRecorder::Event::SocketError, (uint32_t) NetFlightRecorder::ErrorSite::UdpSend, code);
         return Err(fmt::format("sendto failed ({}): {}", retval, errmsg));
     }
 
@@ -4,6 +4,7 @@
 
 #include <util/misc.hpp>
 #include <arm_neon.h>
+#include <algorithm>
 
 float globed::simd::arm::pcmVolume(const float* pcm, std::size_t samples) {
 #ifdef GLOBED_ARM64
@@ -32,4 +33,38 @@ float globed::simd::arm::pcmVolume(const float* pcm, std::size_t samples) {
 #endif
 }
 
+util::simd::PcmStats globed::simd::arm::pcmStats(const float* pcm, std::size_t samples) {
+#ifdef GLOBED_ARM64
+    size_t alignedSamples = samples / 4 * 4;
+
+    float32x4_t sqVec = vdupq_n_f32(0.0f);
+    float32x4_t absVec = vdupq_n_f32(0.0f);
+    float32x4_t peakVec = vdupq_n_f32(0.0f);
+
+    for (size_t i = 0; i < alignedSamples; i += 4) {
+        float32x4_t pcmVec = vld1q_f32(pcm + i);
+        float32x4_t pcmAbs = vabsq_f32(pcmVec);
+        sqVec = vmlaq_f32(sqVec, pcmVec, pcmVec);
+        absVec = vaddq_f32(absVec, pcmAbs);
+        peakVec = vmaxq_f32(peakVec, pcmAbs);
+    }
+
+    util::simd::PcmStats stats {
+        .sumSquares = vaddvq_f32(sqVec),
+        .sumAbs = vaddvq_f32(absVec),
+        .peak = vmaxvq_f32(peakVec),
+    };
+
+    for (size_t i = alignedSamples; i < samples; i++) {
+        stats.sumSquares += pcm[i] * pcm[i];
+        stats.sumAbs += std::abs(pcm[i]);
+        stats.peak = std::max(stats.peak, std::abs(pcm[i]));
+    }
+
+    return stats;
+#else
+    return util::misc::pcmStatsSlow(pcm, samples);
+#endif
+}
+
 #endif
\ No newline at end of file
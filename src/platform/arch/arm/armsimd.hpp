@@ -5,9 +5,11 @@
 #ifdef GLOBED_ARM
 
 #include <cstddef>
+#include <util/simd.hpp>
 
 namespace globed::simd::arm {
     float pcmVolume(const float* pcm, std::size_t samples);
+    util::simd::PcmStats pcmStats(const float* pcm, std::size_t samples);
 }
 
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #ifdef GLOBED_X86
 
+#include <algorithm>
 #include <cmath>
 
 namespace globed::simd::x86 {
@@ -66,6 +67,99 @@ namespace globed::simd::x86 {
 
         return sum / samples;
     }
+
+    util::simd::PcmStats pcmStatsSSE(const float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 4 * 4;
+
+        __m128 sqVec = _mm_setzero_ps();
+        __m128 absVec = _mm_setzero_ps();
+        __m128 peakVec = _mm_setzero_ps();
+        __m128 maskVec = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+        for (size_t i = 0; i < alignedSamples; i += 4) {
+            __m128 pcmVec = _mm_loadu_ps(pcm + i);
+            __m128 pcmAbs = _mm_and_ps(pcmVec, maskVec);
+            sqVec = _mm_add_ps(sqVec, _mm_mul_ps(pcmVec, pcmVec));
+            absVec = _mm_add_ps(absVec, pcmAbs);
+            peakVec = _mm_max_ps(peakVec, pcmAbs);
+        }
+
+        util::simd::PcmStats stats {
+            .sumSquares = asp::simd::vec128sum(sqVec),
+            .sumAbs = asp::simd::vec128sum(absVec),
+            .peak = vec128max(peakVec),
+        };
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            stats.sumSquares += pcm[i] * pcm[i];
+            stats.sumAbs += std::abs(pcm[i]);
+            stats.peak = std::max(stats.peak, std::abs(pcm[i]));
+        }
+
+        return stats;
+    }
+
+    util::simd::PcmStats GLOBED_FEATURE_AVX2 pcmStatsAVX2(const float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 8 * 8;
+
+        __m256 sqVec = _mm256_setzero_ps();
+        __m256 absVec = _mm256_setzero_ps();
+        __m256 peakVec = _mm256_setzero_ps();
+        __m256 maskVec = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+
+        for (size_t i = 0; i < alignedSamples; i += 8) {
+            __m256 pcmVec = _mm256_loadu_ps(pcm + i);
+            __m256 pcmAbs = _mm256_and_ps(pcmVec, maskVec);
+            sqVec = _mm256_add_ps(sqVec, _mm256_mul_ps(pcmVec, pcmVec));
+            absVec = _mm256_add_ps(absVec, pcmAbs);
+            peakVec = _mm256_max_ps(peakVec, pcmAbs);
+        }
+
+        util::simd::PcmStats stats {
+            .sumSquares = vec256sum(sqVec),
+            .sumAbs = vec256sum(absVec),
+            .peak = vec256max(peakVec),
+        };
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            stats.sumSquares += pcm[i] * pcm[i];
+            stats.sumAbs += std::abs(pcm[i]);
+            stats.peak = std::max(stats.peak, std::abs(pcm[i]));
+        }
+
+        return stats;
+    }
+
+    util::simd::PcmStats GLOBED_FEATURE_AVX512DQ pcmStatsAVX512(const float* pcm, size_t samples) {
+        size_t alignedSamples = samples / 16 * 16;
+
+        __m512 sqVec = _mm512_setzero_ps();
+        __m512 absVec = _mm512_setzero_ps();
+        __m512 peakVec = _mm512_setzero_ps();
+        __m512 maskVec = _mm512_castsi512_ps(_mm512_set1_epi32(0x7fffffff));
+
+        for (size_t i = 0; i < alignedSamples; i += 16) {
+            __m512 pcmVec = _mm512_loadu_ps(pcm + i);
+            __m512 pcmAbs = _mm512_and_ps(pcmVec, maskVec);
+            sqVec = _mm512_fmadd_ps(pcmVec, pcmVec, sqVec);
+            absVec = _mm512_add_ps(absVec, pcmAbs);
+            peakVec = _mm512_max_ps(peakVec, pcmAbs);
+        }
+
+        util::simd::PcmStats stats {
+            .sumSquares = vec512sum(sqVec),
+            .sumAbs = vec512sum(absVec),
+            .peak = _mm512_reduce_max_ps(peakVec),
+        };
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            stats.sumSquares += pcm[i] * pcm[i];
+            stats.sumAbs += std::abs(pcm[i]);
+            stats.peak = std::max(stats.peak, std::abs(pcm[i]));
+        }
+
+        return stats;
+    }
 }
 
 #endif
\ No newline at end of file
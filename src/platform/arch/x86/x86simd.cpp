@@ -27,6 +27,22 @@ namespace globed::simd::x86 {
         return _mm512_reduce_add_ps(vec);
     }
 
+    float vec128max(__m128 vec) {
+        __m128 shuf = _mm_movehl_ps(vec, vec);
+        __m128 maxs = _mm_max_ps(vec, shuf);
+        shuf = _mm_shuffle_ps(maxs, maxs, 0x1);
+        maxs = _mm_max_ss(maxs, shuf);
+
+        return _mm_cvtss_f32(maxs);
+    }
+
+    float GLOBED_FEATURE_AVX2 vec256max(__m256 vec) {
+        const __m128 hiQuad = _mm256_extractf128_ps(vec, 1);
+        const __m128 loQuad = _mm256_castps256_ps128(vec);
+
+        return vec128max(_mm_max_ps(loQuad, hiQuad));
+    }
+
     float pcmVolume(const float* pcm, size_t samples) {
         const auto& features = asp::simd::getFeatures();
 
@@ -38,6 +54,18 @@ namespace globed::simd::x86 {
             return pcmVolumeSSE(pcm, samples);
         }
     }
+
+    util::simd::PcmStats pcmStats(const float* pcm, size_t samples) {
+        const auto& features = asp::simd::getFeatures();
+
+        if (features.avx512dq) {
+            return pcmStatsAVX512(pcm, samples);
+        } else if (features.avx2) {
+            return pcmStatsAVX2(pcm, samples);
+        } else {
+            return pcmStatsSSE(pcm, samples);
+        }
+    }
 }
 
 #endif
\ No newline at end of file
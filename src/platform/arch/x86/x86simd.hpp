@@ -2,6 +2,7 @@
 
 #include <platform/basic.hpp>
 #include <asp/simd.hpp>
+#include <util/simd.hpp>
 
 #ifdef GLOBED_X86
 
@@ -30,6 +31,8 @@ namespace globed::simd::x86 {
 
     float GLOBED_FEATURE_AVX2 vec256sum(__m256 vec);
     float GLOBED_FEATURE_AVX512 vec512sum(__m512 vec);
+    float vec128max(__m128 vec);
+    float GLOBED_FEATURE_AVX2 vec256max(__m256 vec);
 
 
     /* Functions that auto pick the fastest algorithm */
@@ -38,6 +41,9 @@ namespace globed::simd::x86 {
     // Calculate the volume of pcm samples, picking the fastest possible implementation.
     float pcmVolume(const float* pcm, size_t samples);
 
+    // Calculate the sum of squares, the sum of absolute values and the peak of pcm samples, picking the fastest possible implementation.
+    util::simd::PcmStats pcmStats(const float* pcm, size_t samples);
+
 
     /* Functions written with a specific algorithm */
 
@@ -45,6 +51,10 @@ namespace globed::simd::x86 {
     float pcmVolumeSSE(const float* pcm, size_t samples);
     float GLOBED_FEATURE_AVX2 pcmVolumeAVX2(const float* pcm, size_t samples);
     float GLOBED_FEATURE_AVX512DQ pcmVolumeAVX512(const float* pcm, size_t samples);
+
+    util::simd::PcmStats pcmStatsSSE(const float* pcm, size_t samples);
+    util::simd::PcmStats GLOBED_FEATURE_AVX2 pcmStatsAVX2(const float* pcm, size_t samples);
+    util::simd::PcmStats GLOBED_FEATURE_AVX512DQ pcmStatsAVX512(const float* pcm, size_t samples);
 }
 
 #endif
\ No newline at end of file
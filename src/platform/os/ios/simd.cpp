@@ -8,3 +8,7 @@
 float util::simd::calcPcmVolume(const float* pcm, size_t samples) {
     return globed::simd::arm::pcmVolume(pcm, samples);
 }
+
+util::simd::PcmStats util::simd::calcPcmStats(const float* pcm, size_t samples) {
+    return globed::simd::arm::pcmStats(pcm, samples);
+}
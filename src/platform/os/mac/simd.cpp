@@ -16,3 +16,11 @@ float util::simd::calcPcmVolume(const float *pcm, size_t samples) {
     return globed::simd::x86::pcmVolume(pcm, samples);
 #endif
 }
+
+util::simd::PcmStats util::simd::calcPcmStats(const float* pcm, size_t samples) {
+#ifdef GEODE_IS_ARM_MAC
+    return globed::simd::arm::pcmStats(pcm, samples);
+#else
+    return globed::simd::x86::pcmStats(pcm, samples);
+#endif
+}
@@ -6,3 +6,7 @@
 float util::simd::calcPcmVolume(const float *pcm, size_t samples) {
     return globed::simd::x86::pcmVolume(pcm, samples);
 }
+
+util::simd::PcmStats util::simd::calcPcmStats(const float* pcm, size_t samples) {
+    return globed::simd::x86::pcmStats(pcm, samples);
+}
@@ -18,7 +18,7 @@
 using namespace geode::prelude;
 
 PlayerAccountData getAccountData(int id) {
-    if (ProfileCacheManager::get().getData(id)) return ProfileCacheManager::get().getData(id).value();
+    if (auto data = ProfileCacheManager::get().getData(id)) return *data;
     if (id == GJAccountManager::sharedState()->m_accountID) return ProfileCacheManager::get().getOwnAccountData();
     return PlayerAccountData::DEFAULT_DATA;
 }
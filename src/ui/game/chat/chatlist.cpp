@@ -109,7 +109,7 @@ void GlobedChatListPopup::createMessage(int accountID, const std::string& messag
     // if account ID is ours, then display our username
     if (accountID == GJAccountManager::sharedState()->m_accountID) username = GJAccountManager::sharedState()->m_username;
     // if account ID is in the player cache, get the username from there
-    if (pcm.getData(accountID)) username = pcm.getData(accountID).value().name;
+    if (auto data = pcm.getData(accountID)) username = data->name;
 
     auto cell = GlobedChatCell::create(username, accountID, message);
     cell->setPositionY(5.f);
@@ -1,5 +1,7 @@
 #include "overlay.hpp"
 
+#include "packet_stats_panel.hpp"
+
 #include <managers/settings.hpp>
 
 using namespace geode::prelude;
@@ -52,6 +54,12 @@ bool GlobedOverlay::init() {
         .id("version-label"_spr);
 #endif
 
+    if (settings.packetStats) {
+        Build(PacketStatsPanel::create(settings.opacity))
+            .parent(this)
+            .id("packet-stats"_spr);
+    }
+
     this->setContentHeight(CCDirector::get()->getWinSize().height);
     this->updateLayout();
 
@@ -0,0 +1,100 @@
+#include "packet_stats_panel.hpp"
+
+#include <hooks/gjbasegamelayer.hpp>
+#include <net/manager.hpp>
+#include <net/packet_stats.hpp>
+#include <net/send_scheduler.hpp>
+#include <util/format.hpp>
+
+using namespace geode::prelude;
+
+bool PacketStatsPanel::init(float opacity) {
+    if (!CCNode::init()) return false;
+
+    Build<CCLabelBMFont>::create("", "bigFont.fnt")
+        .opacity(static_cast<uint8_t>(opacity * 255))
+        .scale(0.6f)
+        .anchorPoint(0.f, 0.f)
+        .store(label)
+        .parent(this);
+
+    this->refresh(0.f);
+    this->schedule(schedule_selector(PacketStatsPanel::refresh), 0.5f);
+
+    return true;
+}
+
+void PacketStatsPanel::refresh(float) {
+    auto stats = PacketStats::get().snapshot();
+    auto total = PacketStats::sum(stats);
+
+    auto rate = [](float bytes) {
+        return util::format::formatBytes(static_cast<uint64_t>(bytes));
+    };
+
+    std::string text = fmt::format(
+        "In: {}/s ({}/s avg)\nOut: {}/s ({}/s avg)",
+        rate(total.bytesIn1s), rate(total.bytesIn10s),
+        rate(total.bytesOut1s), rate(total.bytesOut10s)
+    );
+
+    // average time packets spend in the send queue, per priority class
+    text += "\nQueue:";
+    for (auto& queue : NetworkManager::get().getSendQueueStats()) {
+        text += fmt::format(" {} {:.1f}ms", queue.name, queue.avgDelayMicros / 1000.f);
+    }
+
+    if (auto reliable = NetworkManager::get().getReliableStats()) {
+        text += fmt::format(
+            "\nReliable UDP: rtt {:.1f}ms, {} in flight, {}/{} resent",
+            reliable->srttMicros / 1000.f, reliable->inFlight, reliable->framesResent, reliable->framesSent
+        );
+    }
+
+    // how often joining players got a pooled RemotePlayer instead of creating a new one
+    auto* gjbgl = GlobedGJBGL::get();
+    if (gjbgl && gjbgl->m_fields->playerPool) {
+        auto& pool = *gjbgl->m_fields->playerPool;
+        auto& poolStats = pool.getStats();
+
+        text += fmt::format(
+            "\nPlayer pool: {} pooled, {} hits, {} misses, {} prewarmed, {} discarded",
+            pool.size(), poolStats.hits, poolStats.misses, poolStats.prewarmed, poolStats.discarded
+        );
+    }
+
+    std::sort(stats.begin(), stats.end(), [](auto& a, auto& b) {
+        return a.bytesIn1s + a.bytesOut1s > b.bytesIn1s + b.bytesOut1s;
+    });
+
+    for (size_t i = 0; i < std::min(stats.size(), TOP_TYPES); i++) {
+        auto& snap = stats[i];
+        if (snap.bytesIn1s + snap.bytesOut1s == 0.f) break;
+
+        text += fmt::format(
+            "\n{} ({}): {}/s, {:.0f} pkt/s",
+            snap.name ? snap.name : "?",
+            snap.id,
+            rate(snap.bytesIn1s + snap.bytesOut1s),
+            snap.packetsIn1s + snap.packetsOut1s
+        );
+    }
+
+    label->setString(text.c_str());
+    this->setContentSize(label->getScaledContentSize());
+
+    if (auto parent = this->getParent()) {
+        parent->updateLayout();
+    }
+}
+
+PacketStatsPanel* PacketStatsPanel::create(float opacity) {
+    auto ret = new PacketStatsPanel;
+    if (ret->init(opacity)) {
+        ret->autorelease();
+        return ret;
+    }
+
+    delete ret;
+    return nullptr;
+}
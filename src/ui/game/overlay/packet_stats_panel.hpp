@@ -0,0 +1,17 @@
+#pragma once
+#include <defs/all.hpp>
+
+// Shows the current bandwidth usage and the packet types that use the most of it, refreshed twice a second.
+// Also shows the send queue, reliable UDP and remote player pool stats.
+class PacketStatsPanel : public cocos2d::CCNode {
+public:
+    static PacketStatsPanel* create(float opacity);
+
+private:
+    constexpr static size_t TOP_TYPES = 5;
+
+    cocos2d::CCLabelBMFont* label = nullptr;
+
+    bool init(float opacity);
+    void refresh(float);
+};
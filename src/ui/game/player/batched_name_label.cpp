@@ -0,0 +1,168 @@
+#include "batched_name_label.hpp"
+
+#include "label_layer.hpp"
+#include <managers/role.hpp>
+#include <util/ui.hpp>
+
+using namespace geode::prelude;
+
+constexpr static const char* FONT = "chatFont.fnt";
+constexpr static float BADGE_GAP = 4.f;
+
+bool BatchedNameLabel::init(PlayerLabelLayer* layer) {
+    this->layer = layer;
+
+    auto* fontTexture = CCLabelBMFont::create("", FONT)->getTexture();
+    if (!CCSprite::initWithTexture(fontTexture, CCRectZero)) return false;
+
+    this->setCascadeColorEnabled(true);
+    this->setCascadeOpacityEnabled(true);
+
+    layer->batchFor(fontTexture)->addChild(this);
+
+    glyphContainer = CCSprite::createWithTexture(fontTexture, CCRectZero);
+    glyphContainer->setCascadeColorEnabled(true);
+    glyphContainer->setCascadeOpacityEnabled(true);
+    this->addChild(glyphContainer);
+
+    return true;
+}
+
+void BatchedNameLabel::updateData(const std::string& name, const SpecialUserData& sud) {
+    std::vector<std::string> badgeList;
+    if (sud.roles) {
+        badgeList = RoleManager::get().getBadgeList(sud.roles.value());
+    }
+
+    this->updateName(name);
+    this->updateBadges(badgeList);
+    this->updateColor(util::ui::getNameRichColor(sud));
+}
+
+void BatchedNameLabel::updateName(const std::string& name) {
+    if (name == currentName) return;
+    currentName = name;
+
+    glyphContainer->removeAllChildren();
+
+    // let cocos do the text layout, then copy the glyphs over to our batch
+    auto* label = CCLabelBMFont::create(name.c_str(), FONT);
+    labelSize = label->getContentSize();
+
+    auto* texture = this->getTexture();
+
+    for (auto* glyph : CCArrayExt<CCSprite*>(label->getChildren())) {
+        if (!glyph->isVisible()) continue;
+
+        auto* shadow = CCSprite::createWithTexture(texture, glyph->getTextureRect());
+        shadow->setPosition(glyph->getPosition() + CCPoint{0.75f, -0.75f});
+        shadow->setColor({0, 0, 0});
+        shadow->setOpacity(191);
+        glyphContainer->addChild(shadow, -1);
+
+        auto* copy = CCSprite::createWithTexture(texture, glyph->getTextureRect());
+        copy->setPosition(glyph->getPosition());
+        glyphContainer->addChild(copy, 0);
+    }
+
+    this->updateLayout();
+}
+
+void BatchedNameLabel::updateBadges(const std::vector<std::string>& badges) {
+    if (badge) {
+        badge->removeFromParent();
+        badge = nullptr;
+    }
+
+    // only the first badge is shown in levels
+    if (!badges.empty()) {
+        badge = util::ui::createBadge(badges[0]);
+        util::ui::rescaleToMatch(badge, util::ui::BADGE_SIZE);
+
+        badge->setVisible(this->isVisible());
+        badge->setOpacity(this->getOpacity());
+        layer->batchFor(badge->getTexture())->addChild(badge);
+    }
+
+    this->updateLayout();
+}
+
+void BatchedNameLabel::updateOpacity(float opacity) {
+    this->updateOpacity(static_cast<unsigned char>(opacity * 255.f));
+}
+
+void BatchedNameLabel::updateOpacity(unsigned char opacity) {
+    this->setOpacity(opacity);
+
+    if (badge) badge->setOpacity(opacity);
+}
+
+void BatchedNameLabel::updateColor(const RichColor& color) {
+    color.animateLabel(this);
+}
+
+void BatchedNameLabel::setPosition(const CCPoint& pos) {
+    CCSprite::setPosition(pos);
+    this->updateBadgeTransform();
+}
+
+void BatchedNameLabel::setRotation(float rotation) {
+    CCSprite::setRotation(rotation);
+    this->updateBadgeTransform();
+}
+
+void BatchedNameLabel::setVisible(bool visible) {
+    CCSprite::setVisible(visible);
+
+    if (badge) badge->setVisible(visible);
+}
+
+void BatchedNameLabel::removeFromParentAndCleanup(bool cleanup) {
+    if (badge) {
+        badge->removeFromParentAndCleanup(cleanup);
+        badge = nullptr;
+    }
+
+    CCSprite::removeFromParentAndCleanup(cleanup);
+}
+
+void BatchedNameLabel::updateLayout() {
+    // same as the row layout of GlobedNameLabel, name on the left and the badge on the right, centered on our position
+    float width = labelSize.width;
+    if (badge) {
+        width += BADGE_GAP + util::ui::BADGE_SIZE.width;
+    }
+
+    glyphContainer->setPosition({-width / 2.f, -labelSize.height / 2.f});
+
+    this->updateBadgeTransform();
+}
+
+void BatchedNameLabel::updateBadgeTransform() {
+    if (!badge) return;
+
+    float width = labelSize.width + BADGE_GAP + util::ui::BADGE_SIZE.width;
+    CCPoint offset{width / 2.f - util::ui::BADGE_SIZE.width / 2.f, 0.f};
+
+    // cocos rotations are clockwise
+    offset = ccpRotateByAngle(offset, CCPointZero, -CC_DEGREES_TO_RADIANS(this->getRotation()));
+
+    badge->setPosition(this->getPosition() + offset);
+    badge->setRotation(this->getRotation());
+}
+
+BatchedNameLabel* BatchedNameLabel::create(PlayerLabelLayer* layer, const std::string& name, const SpecialUserData& sud) {
+    auto ret = new BatchedNameLabel;
+    if (ret->init(layer)) {
+        ret->autorelease();
+        ret->updateData(name, sud);
+        return ret;
+    }
+
+    delete ret;
+    return nullptr;
+}
+
+BatchedNameLabel* BatchedNameLabel::create(PlayerLabelLayer* layer, const std::string& name) {
+    return create(layer, name, SpecialUserData{});
+}
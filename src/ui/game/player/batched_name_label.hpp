@@ -0,0 +1,41 @@
+#pragma once
+#include <defs/geode.hpp>
+#include <data/types/gd.hpp>
+
+class PlayerLabelLayer;
+
+/*
+* Name label of a player in a level, drawn through the shared batch nodes of PlayerLabelLayer.
+* The glyphs (and their shadows) are children of this sprite and are only recreated when the name changes,
+* so moving or rotating the label is just a transform update. The badge uses a different texture,
+* so it lives in a separate batch node and follows the label around.
+*/
+class BatchedNameLabel : public cocos2d::CCSprite {
+public:
+    void updateData(const std::string& name, const SpecialUserData& sud);
+    void updateName(const std::string& name);
+    void updateBadges(const std::vector<std::string>& badges);
+    void updateOpacity(float opacity);
+    void updateOpacity(unsigned char opacity);
+    void updateColor(const RichColor& color);
+
+    void setPosition(const cocos2d::CCPoint& pos) override;
+    void setRotation(float rotation) override;
+    void setVisible(bool visible) override;
+    void removeFromParentAndCleanup(bool cleanup) override;
+
+    // The created label is already added to the layer
+    static BatchedNameLabel* create(PlayerLabelLayer* layer, const std::string& name, const SpecialUserData& sud);
+    static BatchedNameLabel* create(PlayerLabelLayer* layer, const std::string& name);
+
+private:
+    PlayerLabelLayer* layer;
+    Ref<cocos2d::CCSprite> glyphContainer;
+    Ref<cocos2d::CCSprite> badge;
+    std::string currentName;
+    cocos2d::CCSize labelSize;
+
+    bool init(PlayerLabelLayer* layer);
+    void updateLayout();
+    void updateBadgeTransform();
+};
@@ -3,6 +3,7 @@
 #include "remote_player.hpp"
 #include <hooks/game_manager.hpp>
 #include <hooks/gjbasegamelayer.hpp>
+#include <managers/icon_residency.hpp>
 #include <managers/settings.hpp>
 #include <util/gd.hpp>
 #include <util/rng.hpp>
@@ -55,22 +56,35 @@ bool ComplexVisualPlayer::init(RemotePlayer* parent, bool isSecond) {
     // hgm->setPlayerStreak(oldStreak);
     // hgm->setPlayerShipStreak(oldShipStreak);
 
-    Build<GlobedNameLabel>::create(data.name)
-        .visible(settings.players.showNames && (!isSecond || settings.players.dualName))
-        .pos(0.f, 25.f)
-        .parent(this)
-        .store(nameLabel);
+    auto* gjbgl = GlobedGJBGL::get();
+    auto& fields = gjbgl->getFields();
+
+    // names and status icons are drawn in batches shared by all players, rather than being our children
+    showName = settings.players.showNames && (!isSecond || settings.players.dualName);
+
+    nameLabel = BatchedNameLabel::create(fields.labelLayer, data.name);
+    nameLabel->setVisible(false);
+
+    // shared by all players, so that players far away from the camera are drawn in a single draw call
+    if (fields.simplifiedPlayerBatch) {
+        Build<CCSprite>::createSpriteName("white-period.png"_spr)
+            .opacity(playerOpacity)
+            .visible(false)
+            .parent(fields.simplifiedPlayerBatch)
+            .store(simplifiedSprite);
+    }
 
     this->updateIcons(data.icons);
 
     if (!isSecond && settings.players.statusIcons) {
-        statusIcons = Build<PlayerStatusIcons>::create(playerOpacity)
+        statusIcons = Build<PlayerStatusIcons>::create(fields.labelLayer, playerOpacity)
             .scale(0.8f)
-            .anchorPoint(0.5f, 0.f)
-            .pos(0.f, settings.players.showNames ? 40.f : 25.f)
-            .parent(this)
             .id("status-icons"_spr)
             .collect();
+
+        if (statusIcons) {
+            statusIcons->setHidden(true);
+        }
     }
 
     // preload the cube icon so the passengers are correct
@@ -80,7 +94,6 @@ bool ComplexVisualPlayer::init(RemotePlayer* parent, bool isSecond) {
 }
 
 void ComplexVisualPlayer::updateIcons(const PlayerIconData& icons) {
-    auto* gm = globed::cachedSingleton<GameManager>();
     auto& settings = GlobedSettings::get();
 
     // update the name and the badge
@@ -90,19 +103,16 @@ void ComplexVisualPlayer::updateIcons(const PlayerIconData& icons) {
 
     playerIcon->togglePlatformerMode(gameLayer->m_level->isPlatformer());
 
+    this->releaseIcons();
+
     storedIcons = icons;
     if (settings.players.defaultDeathEffect) {
         // set the default one
         storedIcons.deathEffect = 1;
     }
 
-    // android is funny and quirky
-    if (static_cast<HookedGameManager*>(gm)->getAssetsPreloaded() GEODE_ANDROID(|| true)) {
-        this->updatePlayerObjectIcons(true);
-        this->updateIconType(playerIconType);
-    } else {
-        this->tryLoadIconsAsync();
-    }
+    this->updatePlayerObjectIcons(true);
+    this->updateIconType(playerIconType);
 
     // // give ids to some of the related nodes
     // auto& data = parent->getAccountData();
@@ -135,7 +145,19 @@ void ComplexVisualPlayer::updateData(
     wasRotating = data.isRotating;
     lastPosition = data.position;
 
-    bool isNearby = this->isPlayerNearby(camState);
+    // set position members for collision, this is the only thing done for players that aren't drawn
+    playerIcon->m_startPosition = data.position;
+    playerIcon->m_lastPosition = data.position;
+    playerIcon->m_positionX = data.position.x;
+    playerIcon->m_positionY = data.position.y;
+
+    // set scale members for collision
+    float mult = data.isMini ? 0.6f : 1.0f;
+    playerIcon->m_scaleX = mult;
+    playerIcon->m_scaleY = mult;
+
+    auto detailLevel = this->detailLevelFor(camState);
+    bool isNearby = detailLevel == PlayerDetailLevel::Full;
     bool cameNearby = isNearby && !wasNearby;
     wasNearby = isNearby;
 
@@ -146,16 +168,27 @@ void ComplexVisualPlayer::updateData(
     } else if (settings.players.hidePracticePlayers && playerData.isPracticing) {
         shouldBeVisible = false;
     } else {
-        shouldBeVisible = (data.isVisible || settings.players.forceVisibility) && !isForciblyHidden && isNearby;
+        shouldBeVisible = (data.isVisible || settings.players.forceVisibility) && !isForciblyHidden;
     }
 
+    this->updateSimplifiedSprite(data, shouldBeVisible && detailLevel == PlayerDetailLevel::Simplified);
+
+    bool wasDrawing = !currentlyNotDrawing;
+    shouldBeVisible = shouldBeVisible && isNearby;
+
     this->currentlyNotDrawing = !shouldBeVisible;
     this->setVisible(shouldBeVisible);
+    this->setOverlayVisible(shouldBeVisible);
 
     if (!shouldBeVisible) {
-        playerIcon->m_playEffects = false;
-        if (playerIcon->m_regularTrail) playerIcon->m_regularTrail->setVisible(false);
-        if (playerIcon->m_shipStreak) playerIcon->m_shipStreak->setVisible(false);
+        if (wasDrawing) {
+            playerIcon->m_playEffects = false;
+            if (playerIcon->m_regularTrail) playerIcon->m_regularTrail->setVisible(false);
+            if (playerIcon->m_shipStreak) playerIcon->m_shipStreak->setVisible(false);
+        }
+
+        // skip the rest of the node updates, the gamemode and animations are caught up once the player is back near the camera
+        if (!isNearby) return;
     }
 
     // auto displacement = data.position - playerIcon->getPosition();
@@ -205,11 +238,14 @@ void ComplexVisualPlayer::updateData(
         playerIcon->m_mainLayer->setRotation(innerRot);
 
         // set the pos for status icons and name (ask rob not me)
-        nameLabel->setPosition(data.position + dirVec * CCPoint{25.f, 25.f});
-        nameLabel->setRotation(dir);
+        if (showName) {
+            nameLabel->setPosition(data.position + dirVec * CCPoint{25.f, 25.f});
+            nameLabel->setRotation(dir);
+        }
 
         if (statusIcons) {
-            statusIcons->setPosition(data.position + dirVec * CCPoint{nameLabel->isVisible() ? 40.f : 25.f, nameLabel->isVisible() ? 40.f : 25.f});
+            float offset = showName ? 40.f : 25.f;
+            statusIcons->setPosition(data.position + dirVec * CCPoint{offset, offset});
             statusIcons->setRotation(dir);
         }
     }
@@ -224,16 +260,9 @@ void ComplexVisualPlayer::updateData(
         updatedOpcaity = true;
     }
 
-    // set position members for collision
-    playerIcon->m_startPosition = data.position;
-    playerIcon->m_lastPosition = data.position;
-    playerIcon->m_positionX = data.position.x;
-    playerIcon->m_positionY = data.position.y;
-
     PlayerIconType iconType = data.iconType;
 
     // setFlipX doesnt work here for jetpack and stuff
-    float mult = data.isMini ? 0.6f : 1.0f;
     playerIcon->setScaleX((data.isLookingLeft ? -1.0f : 1.0f) * mult);
 
     // swing is not flipped
@@ -243,10 +272,6 @@ void ComplexVisualPlayer::updateData(
         playerIcon->setScaleY((data.isUpsideDown ? -1.0f : 1.0f) * mult);
     }
 
-    // set scale members for collision
-    playerIcon->m_scaleX = mult;
-    playerIcon->m_scaleY = mult;
-
     bool switchedMode = iconType != playerIconType;
 
     bool turningOffSwing = (playerIconType == PlayerIconType::Swing && switchedMode);
@@ -355,16 +380,48 @@ void ComplexVisualPlayer::updateIconType(PlayerIconType newType) {
     PlayerIconType oldType = playerIconType;
     playerIconType = newType;
 
-    const auto& accountData = parent->getAccountData();
-    const auto& icons = accountData.icons;
-
     this->toggleAllOff();
 
     if (newType != PlayerIconType::Cube) {
         this->callToggleWith(newType, true, false);
     }
 
-    this->callUpdateWith(newType, util::gd::getIconWithType(icons, newType));
+    this->callUpdateWith(newType, this->residentIconFor(newType));
+}
+
+static CCNode* lastChildOf(CCNode* parent) {
+    auto* children = parent->getChildren();
+    if (!children || children->count() == 0) return nullptr;
+
+    return static_cast<CCNode*>(children->lastObject());
+}
+
+// Calls `fn` for every child of `parent` that was added after `lastChild`.
+// New children are appended at the end and the array only gets sorted when the parent is drawn,
+// so only the tail needs to be looked at, rather than every object in the level.
+template <typename F>
+static void forEachChildAfter(CCNode* parent, CCNode* lastChild, F&& fn) {
+    auto* children = parent->getChildren();
+    if (!children) return;
+
+    size_t count = children->count();
+    size_t start = 0;
+
+    if (lastChild) {
+        // if the last child got removed in the meantime, don't guess which children are new
+        start = count;
+
+        for (size_t i = count; i > 0; i--) {
+            if (children->objectAtIndex(i - 1) == lastChild) {
+                start = i;
+                break;
+            }
+        }
+    }
+
+    for (size_t i = start; i < count; i++) {
+        fn(static_cast<CCNode*>(children->objectAtIndex(i)));
+    }
 }
 
 void ComplexVisualPlayer::playDeathEffect() {
@@ -378,12 +435,8 @@ void ComplexVisualPlayer::playDeathEffect() {
         return;
     }
 
-    // keep track of the previous children
-    std::unordered_set<CCNode*> prevChildren;
-
-    for (auto* child : CCArrayExt<CCNode*>(playerIcon->m_parentLayer->getChildren())) {
-        prevChildren.insert(child);
-    }
+    auto* objectLayer = playerIcon->m_parentLayer;
+    auto* lastChild = lastChildOf(objectLayer);
 
     playerIcon->m_playEffects = true;
     playerIcon->m_isHidden = false;
@@ -395,11 +448,11 @@ void ComplexVisualPlayer::playDeathEffect() {
     }
 
     // now, for each *new* child, we know it's something from the death effect
-    for (auto* child : CCArrayExt<CCNode*>(playerIcon->m_parentLayer->getChildren())) {
-        if (!prevChildren.contains(child)) {
-            child->setTag(DEATH_EFFECT_TAG);
-        }
-    }
+    auto* gjbgl = GlobedGJBGL::get();
+    forEachChildAfter(objectLayer, lastChild, [&](CCNode* child) {
+        child->setTag(DEATH_EFFECT_TAG);
+        gjbgl->trackEffectNode(child);
+    });
 }
 
 void ComplexVisualPlayer::playSpiderTeleport(const SpiderTeleportData& data) {
@@ -410,6 +463,10 @@ void ComplexVisualPlayer::playSpiderTeleport(const SpiderTeleportData& data) {
     playerIcon->m_playEffects = true;
     playerIcon->stopActionByTag(SPIDER_TELEPORT_COLOR_ACTION);
 
+    auto* objectLayer = playerIcon->m_parentLayer;
+    auto* lastChild = lastChildOf(objectLayer);
+    auto* gjbgl = GlobedGJBGL::get();
+
     auto* arr = pl->m_circleWaveArray;
     size_t countBefore = arr ? arr->count() : 0;
     playerIcon->playSpiderDashEffect(data.from, data.to);
@@ -417,26 +474,27 @@ void ComplexVisualPlayer::playSpiderTeleport(const SpiderTeleportData& data) {
 
     if (countBefore != countAfter) {
         for (size_t i = countBefore; i < countAfter; i++) {
-            static_cast<CCNode*>(arr->objectAtIndex(i))->setTag(SPIDER_DASH_CIRCLE_WAVE_TAG);
+            auto* wave = static_cast<CCNode*>(arr->objectAtIndex(i));
+            wave->setTag(SPIDER_DASH_CIRCLE_WAVE_TAG);
+            gjbgl->trackEffectNode(wave);
         }
     }
 
     // name the sprite too
-    for (auto* child : CCArrayExt<CCNode*>(playerIcon->m_parentLayer->getChildren())) {
-        if (child->getZOrder() != 40) continue;
-        if (!child->getID().empty()) continue;
+    auto* spdash1 = CCSpriteFrameCache::get()->spriteFrameByName("spiderDash_001.png")->getTexture();
 
-        auto* sprite = typeinfo_cast<CCSprite*>(child);
-        if (!sprite) continue;
+    forEachChildAfter(objectLayer, lastChild, [&](CCNode* child) {
+        if (child->getZOrder() != 40) return;
+        if (!child->getID().empty()) return;
 
-        auto* sfc = CCSpriteFrameCache::get();
-        auto* spdash1 = sfc->spriteFrameByName("spiderDash_001.png")->getTexture();
-        auto* tex = sprite->getTexture();
+        auto* sprite = typeinfo_cast<CCSprite*>(child);
+        if (!sprite) return;
 
-        if (tex == spdash1) {
+        if (sprite->getTexture() == spdash1) {
             sprite->setTag(SPIDER_DASH_SPRITE_TAG);
+            gjbgl->trackEffectNode(sprite);
         }
-    }
+    });
 
     tpColorDelta = 0.f;
 
@@ -591,6 +649,10 @@ void ComplexVisualPlayer::updatePlayerObjectIcons(bool skipFrames) {
     playerIcon->setColor(storedMainColor);
     playerIcon->setSecondColor(storedSecondaryColor);
 
+    if (simplifiedSprite) {
+        simplifiedSprite->setColor(storedMainColor);
+    }
+
     if (storedIcons.glowColor != NO_GLOW) {
         playerIcon->m_hasGlow = true;
         playerIcon->enableCustomGlowColor(gm->colorForIdx(storedIcons.glowColor));
@@ -642,6 +704,7 @@ void ComplexVisualPlayer::updateOpacity() {
     playerIcon->m_robotSprite->GJRobotSprite::setOpacity(opacity);
     if (playerIcon->m_shipStreak) playerIcon->m_shipStreak->setOpacity(opacity);
     if (playerIcon->m_regularTrail) playerIcon->m_regularTrail->setOpacity(opacity);
+    if (simplifiedSprite) simplifiedSprite->setOpacity(opacity);
 
     // set name opacity too if hideNearby is enabled
     if (settings.players.hideNearby) {
@@ -716,75 +779,47 @@ bool ComplexVisualPlayer::getP2StickyState() {
     return p2sticky;
 }
 
-void ComplexVisualPlayer::tryLoadIconsAsync() {
-    if (iconsLoaded != 0) return;
-    auto* gm = globed::cachedSingleton<GameManager>();
-    auto* textureCache = CCTextureCache::sharedTextureCache();
-    auto* sfCache = CCSpriteFrameCache::sharedSpriteFrameCache();
-
-    for (auto type = PlayerIconType::Cube; type <= PlayerIconType::Jetpack; type = (PlayerIconType)((int)type + 1)) {
-        auto iconId = util::gd::getIconWithType(storedIcons, type);
-        std::string sheetName = gm->sheetNameForIcon(storedIcons.cube, (int)IconType::Cube);
-
-        if (!sheetName.empty()) {
-            int key = gm->keyForIcon(iconId, (int)globed::into<IconType>(type));
-            // essentially addIconDelegate
-            gm->m_iconDelegates[key].push_back(this);
-
-            if (!gm->m_isIconBeingLoaded[key]) {
-                gm->m_isIconBeingLoaded[key] = true;
-
-                auto uniqueId = util::rng::Random::get().generate<int>();
-                asyncLoadRequests[uniqueId] = AsyncLoadRequest {
-                    .key = key,
-                    .iconId = iconId,
-                    .iconType = type
-                };
-
-                textureCache->addImageAsync(
-                    (sheetName + ".png").c_str(),
-                    this,
-                    menu_selector(ComplexVisualPlayer::asyncIconLoadedIntermediary),
-                    uniqueId,
-                    kCCTexture2DPixelFormat_RGBA8888
-                );
-            }
-        }
+int ComplexVisualPlayer::residentIconFor(PlayerIconType type) {
+    int iconId = util::gd::getIconWithType(storedIcons, type);
+
+    auto* gm = static_cast<HookedGameManager*>(globed::cachedSingleton<GameManager>());
+    if (gm->getAssetsPreloaded() || type == PlayerIconType::Unknown) {
+        return iconId;
     }
-}
 
-void ComplexVisualPlayer::onFinishedLoadingIconAsync() {
-    iconsLoaded++;
+    auto iconType = globed::into<IconType>(type);
+    auto& irm = IconResidencyManager::get();
 
-    if (iconsLoaded == (int)PlayerIconType::Jetpack) {
-        // if all icons loaded, we good
-        iconsLoaded = 0;
+    bool loaded = irm.request(iconId, iconType, this, [this] {
+        this->onIconLoaded();
+    });
 
-        this->updatePlayerObjectIcons(true);
-        this->updateIconType(playerIconType);
+    auto pair = std::make_pair(iconId, iconType);
+    if (std::find(acquiredIcons.begin(), acquiredIcons.end(), pair) == acquiredIcons.end()) {
+        irm.acquire(iconId, iconType);
+        acquiredIcons.push_back(pair);
     }
+
+    return loaded ? iconId : PLACEHOLDER_ICON;
 }
 
-void ComplexVisualPlayer::asyncIconLoadedIntermediary(cocos2d::CCObject* obj) {
-    auto* texture = static_cast<CCTexture2D*>(obj);
-    int uniqueId = texture->getTag();
-    if (!asyncLoadRequests.contains(uniqueId)) {
-        log::warn("async load requests does not contain the tag: {}", uniqueId);
-        return;
+void ComplexVisualPlayer::onIconLoaded() {
+    // the cube is also visible as the passenger in other gamemodes
+    if (playerIconType != PlayerIconType::Cube) {
+        this->callUpdateWith(PlayerIconType::Cube, this->residentIconFor(PlayerIconType::Cube));
     }
 
-    auto request = asyncLoadRequests[uniqueId];
-    asyncLoadRequests.erase(uniqueId);
+    this->updateIconType(playerIconType);
+}
 
-    auto* gm = globed::cachedSingleton<GameManager>();
-    gm->loadIcon(request.iconId, (int)globed::into<IconType>(request.iconType), -1);
-    gm->m_isIconBeingLoaded[request.key] = 0;
+void ComplexVisualPlayer::releaseIcons() {
+    auto& irm = IconResidencyManager::get();
 
-    for (const auto delegate : gm->m_iconDelegates[request.key]) {
-        static_cast<ComplexVisualPlayer*>(delegate)->onFinishedLoadingIconAsync();
+    for (auto& [iconId, iconType] : acquiredIcons) {
+        irm.release(iconId, iconType);
     }
 
-    gm->m_iconDelegates.erase(request.key);
+    acquiredIcons.clear();
 }
 
 void ComplexVisualPlayer::cancelPlatformerJumpAnim() {
@@ -806,36 +841,140 @@ void ComplexVisualPlayer::disableTrail() {
     // playerIcon->fadeOutStreak2(0.2f);
 }
 
-bool ComplexVisualPlayer::isPlayerNearby(const GameCameraState& camState) {
+PlayerDetailLevel ComplexVisualPlayer::detailLevelFor(const GameCameraState& camState) {
     // always render them in editor (cause im lazy)
-    if (isEditor) return true;
-
-    // check if they are inside 3 screens
-    constexpr float fullScaleMult = 3.f;
-    constexpr float originMoveMult = (fullScaleMult - 1.f) / 2.f; // magic
-    CCSize origCoverage = camState.cameraCoverage();
-    CCSize cameraCoverage = origCoverage * fullScaleMult;
-    CCPoint cameraOrigin = camState.cameraOrigin - origCoverage * originMoveMult;
+    if (isEditor) return PlayerDetailLevel::Full;
 
-    float cameraLeft = cameraOrigin.x;
-    float cameraRight = cameraOrigin.x + cameraCoverage.width;
-    float cameraBottom = cameraOrigin.y;
-    float cameraTop = cameraOrigin.y + cameraCoverage.height;
+    // players slightly outside of the screen are still drawn, so that their name and status icons don't pop in
+    constexpr float offscreenMargin = 90.f;
+    // past this distance from the center of the camera, the player is only drawn as a single sprite.
+    // at the default zoom the entire screen fits in this radius, so this only kicks in when zoomed out
+    constexpr float fullDetailDistance = 450.f;
 
+    CCSize coverage = camState.cameraCoverage();
     const auto& playerPosition = this->getPlayerPosition();
 
-    bool inCameraCoverage = (
-        playerPosition.x >= cameraLeft &&
-        playerPosition.x <= cameraRight &&
-        playerPosition.y >= cameraBottom &&
-        playerPosition.y <= cameraTop
+    bool onScreen = (
+        playerPosition.x >= camState.cameraOrigin.x - offscreenMargin &&
+        playerPosition.x <= camState.cameraOrigin.x + coverage.width + offscreenMargin &&
+        playerPosition.y >= camState.cameraOrigin.y - offscreenMargin &&
+        playerPosition.y <= camState.cameraOrigin.y + coverage.height + offscreenMargin
     );
 
-    return inCameraCoverage;
+    if (!onScreen) {
+        return PlayerDetailLevel::Offscreen;
+    }
+
+    if (!simplifiedSprite || !GlobedSettings::get().players.simplifyDistant) {
+        return PlayerDetailLevel::Full;
+    }
+
+    CCPoint cameraCenter = camState.cameraOrigin + coverage / 2.f;
+    float distSq = ccpDistanceSQ(playerPosition, cameraCenter);
+
+    return distSq > fullDetailDistance * fullDetailDistance ? PlayerDetailLevel::Simplified : PlayerDetailLevel::Full;
+}
+
+void ComplexVisualPlayer::updateSimplifiedSprite(const SpecificIconData& data, bool visible) {
+    if (!simplifiedSprite) return;
+
+    if (simplifiedSprite->isVisible() != visible) {
+        simplifiedSprite->setVisible(visible);
+    }
+
+    if (!visible) return;
+
+    simplifiedSprite->setPosition(data.position);
+    simplifiedSprite->setScale((data.isMini ? 0.6f : 1.0f) * SIMPLIFIED_SPRITE_SIZE / simplifiedSprite->getContentWidth());
+}
+
+void ComplexVisualPlayer::setOverlayVisible(bool visible) {
+    bool nameVisible = visible && showName;
+    if (nameLabel->isVisible() != nameVisible) {
+        nameLabel->setVisible(nameVisible);
+    }
+
+    if (statusIcons) {
+        statusIcons->setHidden(!visible);
+    }
 }
 
 void ComplexVisualPlayer::cleanupObjectLayer() {
     static_cast<HookedPlayerObject*>(static_cast<PlayerObject*>(playerIcon))->cleanupObjectLayer();
+
+    if (nameLabel) {
+        nameLabel->removeFromParent();
+        nameLabel = nullptr;
+    }
+
+    if (statusIcons) {
+        statusIcons->removeFromParent();
+        statusIcons = nullptr;
+    }
+
+    if (simplifiedSprite) {
+        simplifiedSprite->removeFromParent();
+        simplifiedSprite = nullptr;
+    }
+}
+
+void ComplexVisualPlayer::resetState() {
+    this->stopAllActions();
+    playerIcon->stopAllActions();
+
+    this->onAnimateRobotFireOut();
+    this->cancelPlatformerJumpAnim();
+
+    // hides the trails, the flag itself is cleared below
+    this->setForciblyHidden(true);
+
+    // a player that left while paused has its actions and scheduler paused
+    if (wasPaused) {
+        CCNode::onEnter();
+    }
+
+    wasGrounded = false;
+    wasStationary = true;
+    wasFalling = false;
+    tpColorDelta = 0.f;
+    wasUpsideDown = false;
+    wasRotating = false;
+    wasDashing = false;
+    wasPaused = false;
+    wasNearby = false;
+    currentlyNotDrawing = false;
+    isForciblyHidden = false;
+    p1sticky = false;
+    p2sticky = false;
+
+    playerIcon->m_playEffects = false;
+
+    // a pooled player keeps nothing loaded, the icons are acquired again when it's handed out and gets new account data
+    this->releaseIcons();
+
+    this->setVisible(false);
+    this->setOverlayVisible(false);
+    this->updateSimplifiedSprite(SpecificIconData{}, false);
+
+    if (statusIcons) {
+        statusIcons->updateStatus(false, false, false, false, 0.f, true);
+    }
+}
+
+ComplexVisualPlayer::~ComplexVisualPlayer() {
+    this->releaseIcons();
+
+    if (simplifiedSprite) {
+        simplifiedSprite->removeFromParent();
+    }
+
+    if (nameLabel) {
+        nameLabel->removeFromParent();
+    }
+
+    if (statusIcons) {
+        statusIcons->removeFromParent();
+    }
 }
 
 ComplexVisualPlayer* ComplexVisualPlayer::create(RemotePlayer* parent, bool isSecond) {
@@ -1,15 +1,22 @@
 #pragma once
 
+#include "batched_name_label.hpp"
 #include "status_icons.hpp"
 #include <hooks/player_object.hpp>
 #include <game/visual_state.hpp>
 #include <game/camera_state.hpp>
 #include <data/types/gd.hpp>
 #include <data/types/game.hpp>
-#include <ui/general/name_label.hpp>
 
 class RemotePlayer;
 
+// How much of a player gets drawn, picked every frame from the camera state
+enum class PlayerDetailLevel {
+    Full,       // the entire PlayerObject, with animations, name and status icons
+    Simplified, // a single sprite in the shared batch node, no animations
+    Offscreen,  // nothing is drawn, only the position is stored for collision
+};
+
 class GLOBED_DLL ComplexVisualPlayer : public cocos2d::CCNode {
 public:
     static constexpr int SPIDER_DASH_CIRCLE_WAVE_TAG = 234562345;
@@ -46,9 +53,13 @@ public:
     void callUpdateWith(PlayerIconType type, int icon);
 
     void cleanupObjectLayer();
+    // Brings the player back to the state it was in right after creation, used when a pooled player is reused
+    void resetState();
 
     static ComplexVisualPlayer* create(RemotePlayer* parent, bool isSecond);
 
+    ~ComplexVisualPlayer();
+
 protected:
     friend class ComplexPlayerObject;
     friend class RemotePlayer;
@@ -58,12 +69,14 @@ protected:
 
     GJBaseGameLayer* gameLayer;
     ComplexPlayerObject* playerIcon;
-    Ref<GlobedNameLabel> nameLabel;
+    Ref<BatchedNameLabel> nameLabel;
     PlayerIconType playerIconType = PlayerIconType::Unknown;
     Ref<PlayerStatusIcons> statusIcons;
+    Ref<cocos2d::CCSprite> simplifiedSprite; // lives in the batch node of GlobedGJBGL, not in this node
     cocos2d::CCPoint lastPosition;
     bool isPlatformer;
     bool isEditor;
+    bool showName;
 
     // these 3 used in robot and spider anims
     bool wasGrounded = false;
@@ -87,7 +100,7 @@ protected:
     // used to call onEnter, onExit
     bool wasPaused = false;
 
-    // used for many anims
+    // used for many anims, true if the player was drawn with full detail last frame
     bool wasNearby = false;
 
     bool currentlyNotDrawing = false;
@@ -100,15 +113,14 @@ protected:
 
     PlayerIconData storedIcons;
 
-    // used for async icon loading
-    struct AsyncLoadRequest {
-        int key;
-        int iconId;
-        PlayerIconType iconType;
-    };
+    // icons acquired from IconResidencyManager, released when the icons change or the player is destroyed
+    std::vector<std::pair<int, IconType>> acquiredIcons;
+
+    // shown while the actual icon is being loaded
+    static constexpr int PLACEHOLDER_ICON = 1;
 
-    int iconsLoaded = 0;
-    std::unordered_map<int, AsyncLoadRequest> asyncLoadRequests;
+    // width of the simplified sprite in units, roughly the size of a cube
+    static constexpr float SIMPLIFIED_SPRITE_SIZE = 24.f;
 
     static constexpr int ROBOT_FIRE_ACTION = 1000727;
     static constexpr int SWING_FIRE_ACTION = 1000728;
@@ -125,15 +137,18 @@ protected:
 
     void animateSwingFire(bool goingDown);
     void updateOpacity();
+    // the name label and status icons aren't our children, so they have to be hidden separately
+    void setOverlayVisible(bool visible);
 
-    void tryLoadIconsAsync();
-    void onFinishedLoadingIconAsync();
-    // fucking hell i hate this
-    void asyncIconLoadedIntermediary(cocos2d::CCObject*);
+    // returns the icon that should be displayed for this type, or a placeholder if it is still being loaded
+    int residentIconFor(PlayerIconType type);
+    void onIconLoaded();
+    void releaseIcons();
 
     void cancelPlatformerJumpAnim();
     void enableTrail();
     void disableTrail();
 
-    bool isPlayerNearby(const GameCameraState& camState);
+    PlayerDetailLevel detailLevelFor(const GameCameraState& camState);
+    void updateSimplifiedSprite(const SpecificIconData& data, bool visible);
 };
\ No newline at end of file
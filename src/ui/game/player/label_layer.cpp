@@ -0,0 +1,121 @@
+#include "label_layer.hpp"
+
+#include <util/cocos.hpp>
+
+using namespace geode::prelude;
+
+// every icon gets a square cell in the atlas, the background gets a wider cell at the end
+constexpr static float ATLAS_CELL_SIZE = 40.f;
+constexpr static float ATLAS_BACKGROUND_WIDTH = 60.f;
+
+bool PlayerLabelLayer::init() {
+    if (!CCNode::init()) return false;
+
+    this->buildStatusAtlas();
+
+    return true;
+}
+
+CCSpriteBatchNode* PlayerLabelLayer::batchFor(CCTexture2D* texture) {
+    if (batches.contains(texture)) {
+        return batches.at(texture);
+    }
+
+    auto* batch = CCSpriteBatchNode::createWithTexture(texture);
+    this->addChild(batch);
+    batches.emplace(texture, batch);
+
+    return batch;
+}
+
+CCSpriteBatchNode* PlayerLabelLayer::getStatusBatch() {
+    return statusBatch;
+}
+
+CCSprite* PlayerLabelLayer::createStatusSprite(StatusIcon icon) {
+    if (!statusRects.contains(icon)) return nullptr;
+
+    auto* sprite = CCSprite::createWithTexture(statusBatch->getTexture(), statusRects.at(icon));
+
+    // render textures are stored upside down, and the contents are premultiplied
+    sprite->setFlipY(true);
+    sprite->setOpacityModifyRGB(true);
+
+    return sprite;
+}
+
+void PlayerLabelLayer::buildStatusAtlas() {
+    struct AtlasIcon {
+        StatusIcon icon;
+        std::string frame;
+        float scale;
+    };
+
+    // scales are the same as the ones the icons used to be displayed at
+    std::vector<AtlasIcon> icons = {
+        {StatusIcon::Paused, "GJ_pauseBtn_clean_001.png", 0.8f},
+        {StatusIcon::Practicing, "checkpoint_01_001.png", 0.8f},
+        {StatusIcon::Speaking, "speaker-icon.png"_spr, 0.85f},
+        {StatusIcon::SpeakingMedium, "speaker-icon-yellow.png"_spr, 0.85f},
+        {StatusIcon::SpeakingHigh, "speaker-icon-red.png"_spr, 0.85f},
+        {StatusIcon::Editing, "GJ_hammerIcon_001.png", 0.8f},
+    };
+
+    float width = icons.size() * ATLAS_CELL_SIZE + ATLAS_BACKGROUND_WIDTH;
+
+    statusAtlas = CCRenderTexture::create(width, ATLAS_CELL_SIZE, kCCTexture2DPixelFormat_RGBA8888);
+    if (!statusAtlas) {
+        log::warn("Failed to create the status icon atlas");
+        return;
+    }
+
+    statusAtlas->beginWithClear(0.f, 0.f, 0.f, 0.f);
+
+    for (size_t i = 0; i < icons.size(); i++) {
+        auto* sprite = CCSprite::createWithSpriteFrameName(icons[i].frame.c_str());
+        if (!util::cocos::isValidSprite(sprite)) continue;
+
+        CCPoint cellCenter{i * ATLAS_CELL_SIZE + ATLAS_CELL_SIZE / 2.f, ATLAS_CELL_SIZE / 2.f};
+
+        sprite->setScale(icons[i].scale);
+        sprite->setPosition(cellCenter);
+        sprite->visit();
+
+        CCSize size = sprite->getScaledContentSize();
+        size.width = std::min(size.width, ATLAS_CELL_SIZE);
+        size.height = std::min(size.height, ATLAS_CELL_SIZE);
+
+        statusRects[icons[i].icon] = CCRect{cellCenter.x - size.width / 2.f, cellCenter.y - size.height / 2.f, size.width, size.height};
+    }
+
+    // the background is rendered once, and then split into 3 pieces so it can be stretched to any width
+    float bgX = icons.size() * ATLAS_CELL_SIZE;
+
+    auto* bg = CCScale9Sprite::create("square02_001.png");
+    bg->setContentSize({ATLAS_BACKGROUND_WIDTH * 3.f, STATUS_BACKGROUND_HEIGHT * 3.f});
+    bg->setScale(1.f / 3.f);
+    bg->setAnchorPoint({0.f, 0.f});
+    bg->setPosition({bgX, 0.f});
+    bg->visit();
+
+    statusAtlas->end();
+
+    statusRects[StatusIcon::BackgroundLeft] = CCRect{bgX, 0.f, STATUS_BACKGROUND_CAP, STATUS_BACKGROUND_HEIGHT};
+    statusRects[StatusIcon::BackgroundMiddle] = CCRect{bgX + ATLAS_BACKGROUND_WIDTH / 2.f - 1.f, 0.f, 2.f, STATUS_BACKGROUND_HEIGHT};
+    statusRects[StatusIcon::BackgroundRight] = CCRect{bgX + ATLAS_BACKGROUND_WIDTH - STATUS_BACKGROUND_CAP, 0.f, STATUS_BACKGROUND_CAP, STATUS_BACKGROUND_HEIGHT};
+
+    statusBatch = CCSpriteBatchNode::createWithTexture(statusAtlas->getSprite()->getTexture());
+    statusBatch->setBlendFunc({GL_ONE, GL_ONE_MINUS_SRC_ALPHA});
+    this->addChild(statusBatch, 1);
+}
+
+PlayerLabelLayer* PlayerLabelLayer::create() {
+    auto ret = new PlayerLabelLayer;
+    if (ret->init()) {
+        ret->autorelease();
+        return ret;
+    }
+
+    delete ret;
+    return nullptr;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <defs/geode.hpp>
+
+// Shared parent for the name labels and status icons of every player in a level.
+// Everything in here is drawn through batch nodes (one per texture), so the amount of draw calls doesn't grow with the player count.
+class PlayerLabelLayer : public cocos2d::CCNode {
+public:
+    enum class StatusIcon {
+        Paused,
+        Practicing,
+        Speaking,
+        SpeakingMedium,
+        SpeakingHigh,
+        Editing,
+        BackgroundLeft,
+        BackgroundMiddle,
+        BackgroundRight,
+    };
+
+    // width of the caps of the status icon background, the middle piece gets stretched between them
+    static constexpr float STATUS_BACKGROUND_CAP = 10.f;
+    static constexpr float STATUS_BACKGROUND_HEIGHT = 40.f;
+
+    // Returns the batch node for sprites that use `texture`, creating it if needed.
+    cocos2d::CCSpriteBatchNode* batchFor(cocos2d::CCTexture2D* texture);
+
+    // Status icons come from several different sheets, so they are drawn into a single atlas when the layer is created.
+    cocos2d::CCSpriteBatchNode* getStatusBatch();
+    // Returns nullptr if the icon could not be added to the atlas.
+    cocos2d::CCSprite* createStatusSprite(StatusIcon icon);
+
+    static PlayerLabelLayer* create();
+
+private:
+    std::unordered_map<cocos2d::CCTexture2D*, Ref<cocos2d::CCSpriteBatchNode>> batches;
+    Ref<cocos2d::CCRenderTexture> statusAtlas;
+    Ref<cocos2d::CCSpriteBatchNode> statusBatch;
+    std::unordered_map<StatusIcon, cocos2d::CCRect> statusRects;
+
+    bool init();
+    void buildStatusAtlas();
+};
@@ -1,5 +1,6 @@
 #include "remote_player.hpp"
 
+#include <globed/profiler.hpp>
 #include <managers/settings.hpp>
 
 using namespace geode::prelude;
@@ -56,6 +57,8 @@ void RemotePlayer::updateData(
         float loudness,
         bool hide
 ) {
+    GLOBED_PROFILE_ZONE("RemotePlayer::updateData");
+
     if (hide) {
         data.player1.isVisible = false;
         data.player2.isVisible = false;
@@ -162,6 +165,35 @@ void RemotePlayer::removeProgressIndicators() {
     }
 }
 
+void RemotePlayer::setProgressIndicators(PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow) {
+    this->removeProgressIndicators();
+
+    this->progressIcon = progressIcon;
+    this->progressArrow = progressArrow;
+
+    if (progressIcon) {
+        progressIcon->updateIcons(accountData.icons);
+    }
+
+    if (progressArrow) {
+        progressArrow->updateIcons(accountData.icons);
+    }
+}
+
+void RemotePlayer::resetState() {
+    defaultTicks = 0;
+    lastPercentage = 0.f;
+    wasPracticing = false;
+    isEditorBuilding = false;
+    lastFrameFlags = FrameFlags{};
+    lastVisualState = VisualPlayerState{};
+
+    player1->resetState();
+    player2->resetState();
+
+    this->setForciblyHidden(false);
+}
+
 void RemotePlayer::cleanupObjectLayer() {
     player1->cleanupObjectLayer();
     player2->cleanupObjectLayer();
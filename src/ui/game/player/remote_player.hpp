@@ -36,7 +36,10 @@ public:
     void setDefaultTicks(unsigned int ticks);
     void incDefaultTicks();
     void removeProgressIndicators();
+    void setProgressIndicators(PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow);
     void cleanupObjectLayer();
+    // Resets everything that was set by updateData, so that the player can be reused for someone else
+    void resetState();
 
     void setForciblyHidden(bool state);
     bool getForciblyHidden();
@@ -0,0 +1,73 @@
+#include "remote_player_pool.hpp"
+
+using namespace geode::prelude;
+
+RemotePlayerPool::RemotePlayerPool(CCNode* parent, GameCameraState* camState) : parent(parent), camState(camState) {}
+
+RemotePlayer* RemotePlayerPool::acquire(const PlayerAccountData& data, PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow) {
+    if (pooled.empty()) {
+        stats.misses++;
+
+        auto* rp = RemotePlayer::create(camState, progressIcon, progressArrow, data);
+        Build(rp)
+            .zOrder(10)
+            .parent(parent);
+
+        return rp;
+    }
+
+    stats.hits++;
+
+    Ref<RemotePlayer> rp = pooled.back();
+    pooled.pop_back();
+
+    rp->updateAccountData(data, true);
+    rp->setProgressIndicators(progressIcon, progressArrow);
+    rp->setVisible(true);
+
+    return rp;
+}
+
+void RemotePlayerPool::release(RemotePlayer* player) {
+    player->removeProgressIndicators();
+
+    if (pooled.size() >= MAX_POOLED) {
+        stats.discarded++;
+
+        player->cleanupObjectLayer();
+        player->removeFromParent();
+        return;
+    }
+
+    player->resetState();
+    player->setVisible(false);
+    player->setID("");
+
+    pooled.push_back(player);
+}
+
+void RemotePlayerPool::prewarm() {
+    if (pooled.size() >= PREWARM_TARGET) return;
+
+    stats.prewarmed++;
+    pooled.push_back(this->createPlayer());
+}
+
+const RemotePlayerPool::Stats& RemotePlayerPool::getStats() const {
+    return stats;
+}
+
+size_t RemotePlayerPool::size() const {
+    return pooled.size();
+}
+
+RemotePlayer* RemotePlayerPool::createPlayer() {
+    auto* rp = RemotePlayer::create(camState, nullptr, nullptr);
+
+    Build(rp)
+        .zOrder(10)
+        .visible(false)
+        .parent(parent);
+
+    return rp;
+}
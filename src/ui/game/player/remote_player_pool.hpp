@@ -0,0 +1,44 @@
+#pragma once
+#include <defs/geode.hpp>
+
+#include "remote_player.hpp"
+
+/*
+* Players that left the level are kept around (hidden, in the object layer) instead of being destroyed,
+* and are handed out again on the next join. Creating a RemotePlayer means creating two PlayerObjects,
+* which is one of the most expensive things that happens in a level with a lot of players joining and leaving.
+*/
+class RemotePlayerPool {
+public:
+    struct Stats {
+        size_t hits = 0;      // a pooled player was reused
+        size_t misses = 0;    // the pool was empty and a new player had to be created
+        size_t prewarmed = 0; // players created ahead of time by prewarm()
+        size_t discarded = 0; // released players that were destroyed because the pool was full
+    };
+
+    static constexpr size_t MAX_POOLED = 16;
+    static constexpr size_t PREWARM_TARGET = 4;
+
+    RemotePlayerPool(cocos2d::CCNode* parent, GameCameraState* camState);
+
+    // Returns a player that is already added to the parent, with the given account data and progress indicators.
+    RemotePlayer* acquire(const PlayerAccountData& data, PlayerProgressIcon* progressIcon, PlayerProgressArrow* progressArrow);
+
+    // The player must not be used after this. Progress indicators are always removed.
+    void release(RemotePlayer* player);
+
+    // Creates at most one player if the pool has less than PREWARM_TARGET, meant to be called periodically.
+    void prewarm();
+
+    const Stats& getStats() const;
+    size_t size() const;
+
+private:
+    cocos2d::CCNode* parent;
+    GameCameraState* camState;
+    std::vector<Ref<RemotePlayer>> pooled;
+    Stats stats;
+
+    RemotePlayer* createPlayer();
+};
@@ -1,15 +1,21 @@
 #include "status_icons.hpp"
 
-#include <managers/settings.hpp>
+#include "label_layer.hpp"
 
 using namespace geode::prelude;
 
-bool PlayerStatusIcons::init(unsigned char opacity) {
-    if (!CCNode::init()) return false;
+bool PlayerStatusIcons::init(PlayerLabelLayer* layer, unsigned char opacity) {
+    auto* batch = layer->getStatusBatch();
+    if (!batch) return false;
 
+    if (!CCSprite::initWithTexture(batch->getTexture(), CCRectZero)) return false;
+
+    this->layer = layer;
     this->opacity = opacity;
 
-    this->updateStatus(false, false, false, false, 0.f);
+    batch->addChild(this);
+
+    this->updateStatus(false, false, false, false, 0.f, true);
     this->schedule(schedule_selector(PlayerStatusIcons::updateLoudnessIcon), 0.25f);
 
     return true;
@@ -23,6 +29,21 @@ void PlayerStatusIcons::updateLoudnessIcon(float dt) {
     }
 }
 
+void PlayerStatusIcons::setHidden(bool hidden) {
+    if (this->hidden == hidden) return;
+
+    this->hidden = hidden;
+    this->updateVisibility();
+}
+
+void PlayerStatusIcons::updateVisibility() {
+    bool visible = hasStatus && !hidden;
+
+    if (this->isVisible() != visible) {
+        this->setVisible(visible);
+    }
+}
+
 void PlayerStatusIcons::updateStatus(bool paused, bool practicing, bool speaking, bool editing, float loudness, bool force) {
     lastLoudness = loudness;
 
@@ -32,98 +53,81 @@ void PlayerStatusIcons::updateStatus(bool paused, bool practicing, bool speaking
     wasSpeaking = speaking;
     wasEditing = editing;
 
-    if (!wasPaused && !wasPracticing && !wasSpeaking && !wasEditing) {
-        this->setVisible(false);
-        return;
-    }
+    hasStatus = wasPaused || wasPracticing || wasSpeaking || wasEditing;
+    this->updateVisibility();
+
+    if (!hasStatus) return;
 
-    this->setVisible(true);
     this->removeAllChildren();
 
-    float width = 25.f;
+    using StatusIcon = PlayerLabelLayer::StatusIcon;
+
+    std::vector<StatusIcon> shown;
+    if (wasPaused) shown.push_back(StatusIcon::Paused);
+    if (wasPracticing) shown.push_back(StatusIcon::Practicing);
+    if (wasSpeaking) {
+        switch (wasLoudness) {
+            case Loudness::Low: shown.push_back(StatusIcon::Speaking); break;
+            case Loudness::Medium: shown.push_back(StatusIcon::SpeakingMedium); break;
+            case Loudness::High: shown.push_back(StatusIcon::SpeakingHigh); break;
+        }
+    }
+    if (wasEditing) shown.push_back(StatusIcon::Editing);
 
-    iconWrapper = Build<CCNode>::create()
-        .anchorPoint(0.f, 0.5f)
-        .layout(RowLayout::create()
-                    ->setGap(6.5f))
-        .parent(this);
+    constexpr float gap = 6.5f;
 
-    size_t count = 0;
+    std::vector<CCSprite*> icons;
+    float iconsWidth = 0.f;
 
-    if (wasPaused) {
-        auto pauseSpr = Build<CCSprite>::createSpriteName("GJ_pauseBtn_clean_001.png")
-            .opacity(opacity)
-            .zOrder(1)
-            .scale(0.8f)
-            .id("icon-paused"_spr)
-            .parent(iconWrapper)
-            .collect();
+    for (auto icon : shown) {
+        auto* sprite = layer->createStatusSprite(icon);
+        if (!sprite) continue;
 
-        width += pauseSpr->getScaledContentSize().width;
-        count++;
+        sprite->setOpacity(opacity);
+        iconsWidth += sprite->getContentSize().width;
+        icons.push_back(sprite);
     }
 
-    if (wasPracticing) {
-        auto practiceSpr = Build<CCSprite>::createSpriteName("checkpoint_01_001.png")
-            .opacity(opacity)
-            .zOrder(1)
-            .scale(0.8f)
-            .id("icon-practice"_spr)
-            .parent(iconWrapper)
-            .collect();
-
-        width += practiceSpr->getScaledContentSize().width;
-        count++;
+    if (!icons.empty()) {
+        iconsWidth += gap * (icons.size() - 1);
     }
 
-    if (wasSpeaking) {
-        std::string sprite;
-        switch (wasLoudness) {
-            case Loudness::Low: sprite = "speaker-icon.png"_spr; break;
-            case Loudness::Medium: sprite = "speaker-icon-yellow.png"_spr; break;
-            case Loudness::High: sprite = "speaker-icon-red.png"_spr; break;
-        }
+    float width = 25.f + iconsWidth;
+    float height = PlayerLabelLayer::STATUS_BACKGROUND_HEIGHT;
+    float cap = PlayerLabelLayer::STATUS_BACKGROUND_CAP;
 
-        auto speakSpr = Build<CCSprite>::createSpriteName(sprite.c_str())
-            .opacity(opacity)
-            .zOrder(1)
-            .scale(0.85f)
-            .id("icon-speaking"_spr)
-            .parent(iconWrapper)
-            .collect();
+    // bottom center is our position, the icons and the background are laid out around it
+    float left = -width / 2.f;
 
-        width += speakSpr->getScaledContentSize().width;
-        count++;
-    }
+    auto* bgLeft = layer->createStatusSprite(StatusIcon::BackgroundLeft);
+    auto* bgMiddle = layer->createStatusSprite(StatusIcon::BackgroundMiddle);
+    auto* bgRight = layer->createStatusSprite(StatusIcon::BackgroundRight);
 
-    if (wasEditing) {
-        auto editSpr = Build<CCSprite>::createSpriteName("GJ_hammerIcon_001.png")
-            .opacity(opacity)
-            .zOrder(1)
-            .scale(0.8f)
-            .id("icon-editing"_spr)
-            .parent(iconWrapper)
-            .collect();
-
-        width += editSpr->getScaledContentSize().width;
-        count++;
+    if (bgLeft && bgMiddle && bgRight) {
+        bgLeft->setAnchorPoint({0.f, 0.f});
+        bgLeft->setPosition({left, 0.f});
+
+        bgMiddle->setAnchorPoint({0.f, 0.f});
+        bgMiddle->setPosition({left + cap, 0.f});
+        bgMiddle->setScaleX((width - cap * 2.f) / bgMiddle->getContentSize().width);
+
+        bgRight->setAnchorPoint({0.f, 0.f});
+        bgRight->setPosition({left + width - cap, 0.f});
+
+        for (auto* bg : {bgLeft, bgMiddle, bgRight}) {
+            bg->setOpacity(opacity / 3);
+            this->addChild(bg, -1);
+        }
     }
 
-    width += static_cast<RowLayout*>(iconWrapper->getLayout())->getGap() * (count - 1);
-
-    auto cc9s = Build<CCScale9Sprite>::create("square02_001.png")
-        .contentSize({ width * 3.f, 40.f * 3.f })
-        .scale(1.f / 3.f)
-        .opacity(opacity / 3)
-        .zOrder(-1)
-        .anchorPoint(0.f, 0.f)
-        .parent(this)
-        .collect();
-
-    this->setContentSize(cc9s->getScaledContentSize());
-    iconWrapper->setContentSize(cc9s->getScaledContentSize());
-    iconWrapper->setPositionY(cc9s->getScaledContentSize().height / 2);
-    iconWrapper->updateLayout();
+    float x = -iconsWidth / 2.f;
+    for (auto* icon : icons) {
+        float iconWidth = icon->getContentSize().width;
+        icon->setPosition({x + iconWidth / 2.f, height / 2.f});
+        this->addChild(icon, 1);
+
+        x += iconWidth + gap;
+    }
 }
 
 PlayerStatusIcons::Loudness PlayerStatusIcons::loudnessToCategory(float loudness) {
@@ -138,9 +142,9 @@ PlayerStatusIcons::Loudness PlayerStatusIcons::loudnessToCategory(float loudness
     // }
 }
 
-PlayerStatusIcons* PlayerStatusIcons::create(unsigned char opacity) {
+PlayerStatusIcons* PlayerStatusIcons::create(PlayerLabelLayer* layer, unsigned char opacity) {
     auto ret = new PlayerStatusIcons;
-    if (ret->init(opacity)) {
+    if (ret->init(layer, opacity)) {
         ret->autorelease();
         return ret;
     }
@@ -1,26 +1,34 @@
 #pragma once
 #include <defs/all.hpp>
 
-class PlayerStatusIcons : public cocos2d::CCNode {
+class PlayerLabelLayer;
+
+// Drawn through the status icon atlas of PlayerLabelLayer, the icons are children of this sprite.
+class PlayerStatusIcons : public cocos2d::CCSprite {
 public:
     void updateStatus(bool paused, bool practicing, bool speaking, bool editing, float loudness, bool force = false);
     void updateLoudnessIcon(float dt);
 
-    static PlayerStatusIcons* create(unsigned char opacity);
+    // Hides the icons regardless of the status, for when the player itself isn't drawn
+    void setHidden(bool hidden);
+
+    // The created node is already added to the layer
+    static PlayerStatusIcons* create(PlayerLabelLayer* layer, unsigned char opacity);
 
 private:
     enum class Loudness {
         Low, Medium, High
     };
 
-    cocos2d::CCNode* iconWrapper = nullptr;
+    PlayerLabelLayer* layer = nullptr;
     bool wasPaused = false, wasPracticing = false, wasSpeaking = false, wasEditing = false;
+    bool hidden = false, hasStatus = false;
     Loudness wasLoudness = Loudness::Low;
     float lastLoudness = 0.f;
-    float nameScale = 0.f;
     unsigned char opacity = 255;
 
-    bool init(unsigned char opacity);
+    bool init(PlayerLabelLayer* layer, unsigned char opacity);
+    void updateVisibility();
 
     static Loudness loudnessToCategory(float loudness);
-};
\ No newline at end of file
+};
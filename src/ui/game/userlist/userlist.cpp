@@ -234,7 +234,7 @@ CCArray* GlobedUserListPopup::createPlayerCells() {
             auto accData2 = pcm.getData(p2);
             if (!accData1 || !accData2) return false;
 
-            return util::misc::compareName(accData1.value().name, accData2.value().name);
+            return util::misc::compareName(accData1->name, accData2->name);
         }
     });
 
@@ -250,7 +250,7 @@ CCArray* GlobedUserListPopup::createPlayerCells() {
         if (playerId == ownData.accountId) {
             cell = GlobedUserCell::create(entry, ownData, this);
         } else if (auto pcmdata = pcm.getData(playerId)) {
-            cell = GlobedUserCell::create(entry, pcmdata.value(), this);
+            cell = GlobedUserCell::create(entry, *pcmdata, this);
         } else {
             // cell = GlobedUserCell::create(entry, PlayerAccountData::DEFAULT_DATA, this);
             cell = nullptr;
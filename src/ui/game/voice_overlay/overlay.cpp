@@ -27,8 +27,8 @@ void GlobedVoiceOverlay::addPlayer(int accountId) {
     auto data = pcm.getData(accountId);
 
     PlayerAccountData accdata = PlayerAccountData::DEFAULT_DATA;
-    if (data.has_value()) {
-        accdata = data.value();
+    if (data) {
+        accdata = *data;
     }
 
     auto* cell = VoiceOverlayCell::create(accdata);
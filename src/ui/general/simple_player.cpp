@@ -1,5 +1,7 @@
 #include "simple_player.hpp"
 
+#include <hooks/game_manager.hpp>
+#include <managers/icon_residency.hpp>
 #include <util/gd.hpp>
 #include <util/singleton.hpp>
 
@@ -27,7 +29,7 @@ void GlobedSimplePlayer::updateIcons(const Icons& icons) {
 void GlobedSimplePlayer::updateIcons() {
     auto* gm = globed::cachedSingleton<GameManager>();
 
-    sp->updatePlayerFrame(icons.id, icons.type);
+    sp->updatePlayerFrame(this->residentIcon(), icons.type);
 
     sp->setColor(gm->colorForIdx(icons.color1));
     sp->setSecondColor(gm->colorForIdx(icons.color2));
@@ -39,6 +41,39 @@ void GlobedSimplePlayer::updateIcons() {
     }
 }
 
+int GlobedSimplePlayer::residentIcon() {
+    auto* gm = static_cast<HookedGameManager*>(globed::cachedSingleton<GameManager>());
+    if (gm->getAssetsPreloaded()) {
+        return icons.id;
+    }
+
+    auto& irm = IconResidencyManager::get();
+
+    bool loaded = irm.request(icons.id, icons.type, this, [this] {
+        this->updateIcons();
+    });
+
+    auto pair = std::make_pair(icons.id, icons.type);
+    if (acquiredIcon != pair) {
+        this->releaseIcon();
+        irm.acquire(icons.id, icons.type);
+        acquiredIcon = pair;
+    }
+
+    return loaded ? icons.id : PLACEHOLDER_ICON;
+}
+
+void GlobedSimplePlayer::releaseIcon() {
+    if (acquiredIcon) {
+        IconResidencyManager::get().release(acquiredIcon->first, acquiredIcon->second);
+        acquiredIcon.reset();
+    }
+}
+
+GlobedSimplePlayer::~GlobedSimplePlayer() {
+    this->releaseIcon();
+}
+
 SimplePlayer* GlobedSimplePlayer::getInner() {
     return sp;
 }
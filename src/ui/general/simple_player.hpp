@@ -45,9 +45,18 @@ public:
 
     SimplePlayer* sp;
 
+    ~GlobedSimplePlayer();
+
 protected:
+    // shown while the actual icon is being loaded by IconResidencyManager
+    static constexpr int PLACEHOLDER_ICON = 1;
+
     bool init(const Icons& icons);
     void updateIcons();
+    int residentIcon();
+    void releaseIcon();
 
     Icons icons;
+    // icon acquired from IconResidencyManager, released when the icon changes or the player is destroyed
+    std::optional<std::pair<int, IconType>> acquiredIcon;
 };
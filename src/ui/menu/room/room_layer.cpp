@@ -15,6 +15,7 @@
 #include <net/manager.hpp>
 #include <managers/admin.hpp>
 #include <managers/error_queues.hpp>
+#include <managers/frame_scheduler.hpp>
 #include <managers/profile_cache.hpp>
 #include <managers/friend_list.hpp>
 #include <managers/settings.hpp>
@@ -406,6 +407,16 @@ void RoomLayer::recreatePlayerList() {
     listLayer->scrollToPos(scrollPos);
 }
 
+void RoomLayer::queuePlayerListRebuild() {
+    if (playerListRebuildQueued) return;
+    playerListRebuildQueued = true;
+
+    FrameScheduler::get().queue(FrameScheduler::Priority::Ui, this, [this] {
+        playerListRebuildQueued = false;
+        this->recreatePlayerList();
+    });
+}
+
 void RoomLayer::setFilter(std::string_view filter) {
     this->currentFilter = filter;
 
@@ -488,7 +499,7 @@ void RoomLayer::reloadData(const RoomInfo& info, const std::vector<PlayerRoomPre
     }
 
     // create the player list
-    this->recreatePlayerList();
+    this->queuePlayerListRebuild();
 
     // create buttons and room title
     if (changedRoom || justEntered) {
@@ -28,6 +28,7 @@ protected:
     std::string currentFilter;
 
     bool justEntered = true;
+    bool playerListRebuildQueued = false;
     Ref<LoadingCircle> loadingCircle;
     Ref<cocos2d::CCMenu> topRightButtons;
     PlayerList* listLayer;
@@ -45,6 +46,8 @@ protected:
 
     void requestPlayerList();
     void recreatePlayerList();
+    // rebuilds the player list in a later frame, if there's time left for it
+    void queuePlayerListRebuild();
     void setFilter(std::string_view filter);
     void setRoomTitle(std::string_view name, uint32_t id);
     void resetFilter();
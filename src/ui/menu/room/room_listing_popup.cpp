@@ -5,6 +5,7 @@
 #include <data/packets/client/room.hpp>
 #include <data/packets/server/room.hpp>
 #include <managers/admin.hpp>
+#include <managers/frame_scheduler.hpp>
 #include <managers/friend_list.hpp>
 #include <managers/settings.hpp>
 #include <net/manager.hpp>
@@ -70,8 +71,11 @@ bool RoomListingPopup::setup() {
             }
         }
 
-        this->createCells(packet->rooms);
-        this->updateTitle(packet->rooms.size());
+        // a room list can have hundreds of rooms, so building the cells is left for a frame that has time for it
+        FrameScheduler::get().queue(FrameScheduler::Priority::Ui, this, [this, packet = std::move(packet)] {
+            this->createCells(packet->rooms);
+            this->updateTitle(packet->rooms.size());
+        });
     });
 
     auto winSize = CCDirector::sharedDirector()->getWinSize();
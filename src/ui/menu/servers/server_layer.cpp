@@ -243,28 +243,28 @@ void GlobedServersLayer::requestCallback(typename WebRequestManager::Event* even
 
     auto result = std::move(*event->getValue());
 
-    if (!result.ok()) {
+    // an outdated server list is not any better than none, the servers on it may not exist anymore
+    if (!result.ok() || result.isFallback()) {
         gsm.clear();
-        csm.updateCacheForActive("");
+        WebRequestManager::get().invalidateCachedServerMeta();
 
         ErrorQueues::get().error(fmt::format("Failed to fetch servers.\n\nReason: <cy>{}</c>", result.getError()));
 
         return;
     }
 
-    auto response = result.text().unwrapOrDefault();
+    auto response = result.textView().unwrapOrDefault();
     auto res = matjson::parseAs<MetaResponse>(response);
 
     if (!res) {
         gsm.clear();
-        csm.updateCacheForActive("");
+        WebRequestManager::get().invalidateCachedServerMeta();
         log::warn("failed to parse server list: {}", res.unwrapErr());
         log::warn("{}", response);
         ErrorQueues::get().error(fmt::format("Failed to parse server list: <cy>{}</c>", res.unwrapErr()));
         return;
     }
 
-    csm.updateCacheForActive(response);
     csm.initFromMeta(res.unwrap());
 }
 
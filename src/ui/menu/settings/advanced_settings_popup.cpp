@@ -1,9 +1,14 @@
 #include "advanced_settings_popup.hpp"
 
+#include <globed/profiler.hpp>
 #include <managers/account.hpp>
+#include <managers/memory_report.hpp>
+#include <managers/popup.hpp>
 #include <managers/settings.hpp>
 #include <net/manager.hpp>
 #include <net/address.hpp>
+#include <net/flight_recorder.hpp>
+#include <net/packet_replay.hpp>
 #include <util/debug.hpp>
 #include <util/format.hpp>
 #include <util/ui.hpp>
@@ -14,6 +19,10 @@ bool AdvancedSettingsPopup::setup() {
     auto rlayout = util::ui::getPopupLayoutAnchored(m_size);
     this->setTitle("Advanced settings");
 
+    // the profiling and network capture tools are only useful when working on the mod itself,
+    // so they get their own column that only shows up with the dev launch arg
+    bool devTools = GlobedSettings::get().launchArgs().devStuff;
+
     auto* menu = Build<ButtonSprite>::create("Reset token", "bigFont.fnt", "GJ_button_01.png", 0.75f)
         .scale(0.8f)
         .intoMenuItem([this](auto) {
@@ -24,7 +33,7 @@ bool AdvancedSettingsPopup::setup() {
         .intoNewParent(CCMenu::create())
         .layout(ColumnLayout::create()->setAxisReverse(true))
         .contentSize(0.f, POPUP_HEIGHT - 20.f)
-        .pos(rlayout.center - CCPoint{0.f, 10.f})
+        .pos(rlayout.center - CCPoint{devTools ? COLUMN_OFFSET : 0.f, 10.f})
         .parent(m_mainLayer)
         .collect();
 
@@ -72,11 +81,101 @@ bool AdvancedSettingsPopup::setup() {
         .parent(menu)
         .collect();
 
+    thing->toggle(PacketCapture::get().isCapturing());
+
     menu->updateLayout();
 
+    if (devTools) {
+        this->setupDevTools(rlayout.center + CCPoint{COLUMN_OFFSET, -10.f});
+    }
+
     return true;
 }
 
+void AdvancedSettingsPopup::setupDevTools(CCPoint pos) {
+    auto* diagMenu = Build<CCMenu>::create()
+        .layout(ColumnLayout::create()->setAxisReverse(true))
+        .contentSize(0.f, POPUP_HEIGHT - 20.f)
+        .pos(pos)
+        .parent(m_mainLayer)
+        .collect();
+
+    Build<ButtonSprite>::create("Memory usage", "bigFont.fnt", "GJ_button_01.png", 0.75f)
+        .scale(0.8f)
+        .intoMenuItem([this](auto) {
+            PopupManager::get().alert("Memory usage", MemoryReporter::makeReport()).showInstant();
+        })
+        .parent(diagMenu);
+
+    if (globed::profiler::enabled()) {
+        Build<ButtonSprite>::create("Export trace", "bigFont.fnt", "GJ_button_01.png", 0.75f)
+            .scale(0.8f)
+            .intoMenuItem([this](auto) {
+                auto path = Mod::get()->getSaveDir() / fmt::format("trace-{}.json", std::time(nullptr));
+
+                auto res = globed::profiler::exportChromeTrace(path);
+                if (!res) {
+                    log::warn("Failed to export the trace: {}", res.unwrapErr());
+                    Notification::create("Failed to export the trace", NotificationIcon::Error)->show();
+                    return;
+                }
+
+                log::info("Exported the trace to {}", path);
+                Notification::create("Exported the trace", NotificationIcon::Success)->show();
+            })
+            .parent(diagMenu);
+    }
+
+    Build<ButtonSprite>::create("Dump network log", "bigFont.fnt", "GJ_button_01.png", 0.75f)
+        .scale(0.8f)
+        .intoMenuItem([this](auto) {
+            auto res = NetFlightRecorder::get().dump(fmt::format("net-flight-{}", std::time(nullptr)));
+            if (!res) {
+                log::warn("Failed to dump the network log: {}", res.unwrapErr());
+                Notification::create("Failed to dump the network log", NotificationIcon::Error)->show();
+                return;
+            }
+
+            // also save a readable version next to it, the binary one is what you'd attach to a bug report
+            auto path = std::move(res).unwrap();
+            auto text = NetFlightRecorder::decode(path);
+            if (text) {
+                auto textPath = path;
+                textPath.replace_extension(".txt");
+                (void) geode::utils::file::writeString(textPath, text.unwrap());
+            }
+
+            log::info("Dumped the network log to {}", path);
+            Notification::create("Dumped the network log", NotificationIcon::Success)->show();
+        })
+        .parent(diagMenu);
+
+    // replays the latest capture, at the recorded speed or as fast as possible
+    for (float speed : {1.f, 0.f}) {
+        Build<ButtonSprite>::create(speed > 0.f ? "Replay capture" : "Replay capture (fast)", "bigFont.fnt", "GJ_button_01.png", 0.75f)
+            .scale(0.8f)
+            .intoMenuItem([speed](auto) {
+                auto path = PacketReplay::latestCapture();
+                if (!path) {
+                    Notification::create("No packet captures found", NotificationIcon::Error)->show();
+                    return;
+                }
+
+                auto res = PacketReplay::get().start(*path, speed);
+                if (!res) {
+                    log::warn("Failed to replay the capture: {}", res.unwrapErr());
+                    Notification::create(fmt::format("Failed to replay the capture: {}", res.unwrapErr()), NotificationIcon::Error)->show();
+                    return;
+                }
+
+                Notification::create("Replaying the latest capture", NotificationIcon::Success)->show();
+            })
+            .parent(diagMenu);
+    }
+
+    diagMenu->updateLayout();
+}
+
 void AdvancedSettingsPopup::onPacketLog(CCObject* p) {
     bool enabled = !static_cast<CCMenuItemToggler*>(p)->isOn();
     NetworkManager::get().togglePacketLogging(enabled);
@@ -84,7 +183,9 @@ void AdvancedSettingsPopup::onPacketLog(CCObject* p) {
 
 AdvancedSettingsPopup* AdvancedSettingsPopup::create() {
     auto ret = new AdvancedSettingsPopup;
-    if (ret->initAnchored(POPUP_WIDTH, POPUP_HEIGHT)) {
+    float width = GlobedSettings::get().launchArgs().devStuff ? DEV_POPUP_WIDTH : POPUP_WIDTH;
+
+    if (ret->initAnchored(width, POPUP_HEIGHT)) {
         ret->autorelease();
         return ret;
     }
@@ -4,12 +4,16 @@
 class AdvancedSettingsPopup : public geode::Popup<> {
 public:
     static constexpr float POPUP_WIDTH = 240.f;
-    static constexpr float POPUP_HEIGHT = 200.f;
+    static constexpr float DEV_POPUP_WIDTH = 420.f; // wide enough for the dev tools column
+    static constexpr float POPUP_HEIGHT = 220.f;
+    static constexpr float COLUMN_OFFSET = 100.f; // distance of each button column from the center, with the dev tools shown
 
     static AdvancedSettingsPopup* create();
 
 private:
     bool setup() override;
 
+    void setupDevTools(cocos2d::CCPoint pos);
+
     void onPacketLog(cocos2d::CCObject*);
 };
@@ -276,10 +276,14 @@ void GlobedSettingsLayer::createSettingsCells(int category) {
             registerSetting(cat, settings.globed.autoconnect, "Autoconnect", "Automatically connect to the last connected server on launch.");
             registerSetting(cat, settings.globed.preloadAssets, "Preload assets", "Increases the loading times but prevents most lagspikes in a level.");
             registerSetting(cat, settings.globed.deferPreloadAssets, "Defer preloading", "Instead of making the loading screen longer, load assets only when you join a level while connected.");
+            registerSetting(cat, settings.globed.iconMemoryBudget, "Icon memory budget", "How much memory (in MB) icons of other players can use when assets are not preloaded. Icons that go unused for a while are unloaded once this is exceeded.");
+            registerSetting(cat, settings.globed.frameBudget, "Frame budget", "How much time (in milliseconds) Globed can spend each frame on work that can be delayed, such as handling packets or rebuilding lists. Lower values reduce lagspikes, but may make things update slower.");
+            registerSetting(cat, settings.globed.preloadTextureCache, "Cache decoded textures", "Saves preloaded textures to disk in a decoded form, which makes preloading faster on subsequent launches. Uses up to 768 MB of disk space.");
             registerSetting(cat, settings.globed.invitesFrom, "Receive invites from", "Controls who can invite you into a room.", Type::InvitesFrom);
             registerSetting(cat, settings.globed.editorSupport, "View players in editor", "Enables the ability to see people playing your level while in the editor. Note: <cy>this does not let you build levels together!</c>");
             registerSetting(cat, settings.dummySetting, "Keybinds", "Opens the <cg>Keybinds Settings</c>.", Type::KeybindSettings);
             registerSetting(cat, settings.globed.fragmentationLimit, "Packet limit", "Press the \"Test\" button to calibrate the maximum packet size. Should fix some of the issues with players not appearing in a level.", Type::PacketFragmentation);
+            registerSetting(cat, settings.globed.reliableUdp, "Reliable UDP (experimental)", "Sends packets that would normally go over TCP through UDP instead, with retransmission of lost packets. May reduce lag spikes on unstable connections. Only works if the server supports it, otherwise TCP is used like before.");
 
 #ifndef GEODE_IS_ANDROID
             registerSetting(cat, settings.globed.useDiscordRPC, "Discord RPC", "If you have the Discord Rich Presence standalone mod, this option will toggle a Globed-specific RPC on your profile.", Type::DiscordRPC);
@@ -309,6 +313,7 @@ void GlobedSettingsLayer::createSettingsCells(int category) {
             registerSetting(cat, settings.communication.voiceProximity, "Voice proximity", "In platformer mode, the loudness of other players will be determined by how close they are to you.");
             registerSetting(cat, settings.communication.classicProximity, "Classic proximity", "Same as voice proximity, but for classic levels (non-platformer).");
             registerSetting(cat, settings.communication.voiceVolume, "Voice volume", "Controls how loud other players are.");
+            registerSetting(cat, settings.communication.maxVoiceStreams, "Max voice streams", "The maximum amount of players you can hear at once. When more people are talking, the closest and loudest ones are picked. Set to 0 to disable the limit.");
             registerSetting(cat, settings.communication.onlyFriends, "Only friends", "When enabled, you won't hear players that are not on your friend list in-game.");
             registerSetting(cat, settings.communication.lowerAudioLatency, "Lower audio latency", "Decreases the audio buffer size by 2 times, reducing the latency but potentially causing audio issues.");
             registerSetting(cat, settings.communication.deafenNotification, "Deafen notification", "Shows a notification when you deafen & undeafen.");
@@ -328,6 +333,7 @@ void GlobedSettingsLayer::createSettingsCells(int category) {
             registerSetting(cat, settings.overlay.opacity, "Opacity", "Opacity of the displayed overlay.");
             registerSetting(cat, settings.overlay.hideConditionally, "Hide conditionally", "Hide the ping overlay when not connected to a server or in a non-uploaded level, instead of showing a substitute message.");
             registerSetting(cat, settings.overlay.position, "Position", "Position of the overlay on the screen.", Type::Corner);
+            registerSetting(cat, settings.overlay.packetStats, "Network stats", "Show the current bandwidth usage and the packet types using the most of it below the ping.");
         } break;
 
         case TAG_TAB_PLAYERS: {
@@ -342,6 +348,7 @@ void GlobedSettingsLayer::createSettingsCells(int category) {
             registerSetting(cat, settings.players.hideNearby, "Hide nearby players", "Increases the transparency of players as they get closer to you, so that they don't obstruct your view.");
             registerSetting(cat, settings.players.statusIcons, "Status icons", "Show an icon above a player if they are paused, in practice mode, or currently speaking.");
             registerSetting(cat, settings.players.hidePracticePlayers, "Hide players in practice", "Hide players that are in practice mode.");
+            registerSetting(cat, settings.players.simplifyDistant, "Simplify distant players", "Draws players that are far away from the camera as a simple dot instead of a full icon. Greatly improves performance when zoomed out in crowded levels.");
         } break;
     }
 }
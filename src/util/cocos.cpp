@@ -7,6 +7,7 @@
 #include <util/format.hpp>
 #include <util/debug.hpp>
 #include <util/singleton.hpp>
+#include <util/texture_cache.hpp>
 
 #include <asp/thread.hpp>
 #include <asp/fs.hpp>
@@ -115,6 +116,7 @@ namespace util::cocos {
 
         struct _T {
             asp::time::Instant start, postPreparation, postTexCreation, finish;
+            size_t cachedImages = 0, decodedImages = 0;
 
             _T() : start(Instant::now()), postPreparation(start), postTexCreation(start), finish(start) {}
 
@@ -125,12 +127,19 @@ namespace util::cocos {
             void print() {
                 preloadLog("Preload time estimates:");
                 preloadLog("-- Preparation: {}", postPreparation.durationSince(start).toString());
-                preloadLog("-- Image load + texture creation: {}", postTexCreation.durationSince(postPreparation).toString());
+                preloadLog("-- Image load + texture creation: {} ({} from texture cache, {} decoded)",
+                    postTexCreation.durationSince(postPreparation).toString(), cachedImages, decodedImages);
                 preloadLog("-- Creating sprite frame: {}", finish.durationSince(postTexCreation).toString());
                 preloadLog("- Total: {}", finish.durationSince(start).toString());
             }
         } timeMeasurements;
 
+        // totals across every `loadAssetsParallel` call, used to compare cold and warm starts
+        struct {
+            asp::time::Duration imageLoadTime, totalTime;
+            size_t cachedImages = 0, decodedImages = 0;
+        } totals;
+
         void ensurePoolExists() {
             if (!threadPool) {
                 TRACE("creating thread pool with size {}", THREAD_COUNT);
@@ -187,6 +196,9 @@ namespace util::cocos {
         }
 
         state.threadPool = std::make_unique<asp::ThreadPool>(THREAD_COUNT);
+        state.totals = {};
+
+        util::texcache::init();
 
         preloadLog("initialized preload state in {}", startTime.elapsed().toString());
         preloadLog("texture quality: {}", state.texQuality == TextureQuality::High ? "High" : (state.texQuality == TextureQuality::Medium ? "Medium" : "Low"));
@@ -264,13 +276,28 @@ namespace util::cocos {
         preloadLog("loading images ({} total)", imgCount);
         state.timeMeasurements.postPreparation = Instant::now();
 
-        asp::Channel<std::pair<size_t, CCImage*>> textureInitRequests;
+        struct DecodedImage {
+            size_t idx;
+            CCImage* image;
+            bool fromCache;
+        };
+
+        asp::Channel<DecodedImage> textureInitRequests;
+
+        bool useTexCache = util::texcache::enabled();
 
         for (size_t i = 0; i < imgCount; i++) {
-            threadPool.pushTask([i, &fileUtils, &textureInitRequests, &imgStates] {
+            threadPool.pushTask([i, useTexCache, &fileUtils, &textureInitRequests, &imgStates] {
                 // this is a dangling reference, but we do not modify imgStates in any way, so it's not a big deal.
                 auto& imgState = imgStates.lock()->at(i);
 
+                if (useTexCache) {
+                    if (auto image = util::texcache::load(imgState.path)) {
+                        textureInitRequests.push(DecodedImage { i, image, true });
+                        return;
+                    }
+                }
+
                 unsigned long filesize = 0;
                 unsigned char* buffer = getFileDataThreadSafe(imgState.path.c_str(), "rb", &filesize);
 
@@ -288,7 +315,11 @@ namespace util::cocos {
                     return;
                 }
 
-                textureInitRequests.push(std::make_pair(i, image));
+                if (useTexCache) {
+                    util::texcache::store(imgState.path, image);
+                }
+
+                textureInitRequests.push(DecodedImage { i, image, false });
             });
         }
 
@@ -307,7 +338,7 @@ namespace util::cocos {
                 }
             }
 
-            auto [idx, image] = textureInitRequests.popNow();
+            auto [idx, image, fromCache] = textureInitRequests.popNow();
 
             auto texture = new CCTexture2D;
             if (!texture->initWithImage(image)) {
@@ -326,6 +357,12 @@ namespace util::cocos {
             image->release(); // bring refcount to 0, releasing it
 
             initedTextures++;
+
+            if (fromCache) {
+                state.timeMeasurements.cachedImages++;
+            } else {
+                state.timeMeasurements.decodedImages++;
+            }
         }
 
         preloadLog("initialized {} textures, adding sprite frames", initedTextures);
@@ -408,6 +445,12 @@ namespace util::cocos {
         preloadLog("initialized sprite frames. done.");
         state.timeMeasurements.finish = Instant::now();
 
+        auto& tm = state.timeMeasurements;
+        state.totals.imageLoadTime = state.totals.imageLoadTime + tm.postTexCreation.durationSince(tm.postPreparation);
+        state.totals.totalTime = state.totals.totalTime + tm.finish.durationSince(tm.start);
+        state.totals.cachedImages += tm.cachedImages;
+        state.totals.decodedImages += tm.decodedImages;
+
 #ifdef GLOBED_DEBUG
         state.timeMeasurements.print();
 #endif
@@ -480,6 +523,17 @@ namespace util::cocos {
                 preloadAssets(AssetPreloadStage::Ufo);
                 preloadAssets(AssetPreloadStage::Wave);
                 preloadAssets(AssetPreloadStage::Other);
+
+                // a warm start is one where (nearly) everything came from the texture cache
+                auto& totals = getPreloadState().totals;
+                preloadLog(
+                    "{} start: {} total, {} loading images ({} from texture cache, {} decoded)",
+                    totals.decodedImages > totals.cachedImages ? "Cold" : "Warm",
+                    totals.totalTime.toString(),
+                    totals.imageLoadTime.toString(),
+                    totals.cachedImages,
+                    totals.decodedImages
+                );
             } break;
         }
     }
@@ -69,77 +69,6 @@ namespace util::debug {
         }
     }
 
-    void PacketLogSummary::print() {
-        log::debug("====== Packet summary ======");
-        if (total == 0) {
-            log::debug("No packets have been sent during this period.");
-        } else {
-            log::debug("Total packets: {} ({} sent, {} received)", total, totalOut, totalIn);
-            log::debug("Encrypted packets: {} ({} cleartext, ratio: {}%)", totalEncrypted, totalCleartext, encryptedRatio * 100);
-            log::debug(
-                "Total bytes transferred: {} ({} sent, {} received)",
-                format::formatBytes(totalBytes),
-                format::formatBytes(totalBytesOut),
-                format::formatBytes(totalBytesIn)
-            );
-            log::debug("Average bytes per packet: {}", format::formatBytes((uint64_t)bytesPerPacket));
-
-            // sort packets by the counts
-            std::vector<std::pair<packetid_t, size_t>> pc(packetCounts.begin(), packetCounts.end());
-            std::sort(pc.begin(), pc.end(), [](const auto& a, const auto& b) {
-                return a.second > b.second;
-            });
-
-            for (const auto& [id, count] : pc) {
-                log::debug("Packet {} - {} occurrences", id, count);
-            }
-        }
-        log::debug("==== Packet summary end ====");
-    }
-    void PacketLogger::record(packetid_t id, bool encrypted, bool outgoing, size_t bytes) {
-#ifdef GLOBED_DEBUG_PACKETS
-# ifdef GLOBED_DEBUG_PACKETS_PRINT
-        log::debug("{} packet {}, encrypted: {}, bytes: {}", outgoing ? "Sending" : "Receiving", id, encrypted ? "true" : "false", bytes);
-# endif // GLOBED_DEBUG_PACKETS_PRINT
-        queue.push(PacketLog {
-            .id = id,
-            .encrypted = encrypted,
-            .outgoing = outgoing,
-            .bytes = bytes
-        });
-#endif // GLOBED_DEBUG_PACKETS
-    }
-
-    PacketLogSummary PacketLogger::getSummary() {
-        PacketLogSummary summary = {};
-
-        for (auto& log : queue.extract()) {
-            summary.total++;
-
-            summary.totalBytes += log.bytes;
-            if (log.outgoing) {
-                summary.totalOut++;
-                summary.totalBytesOut += log.bytes;
-            } else {
-                summary.totalIn++;
-                summary.totalBytesIn += log.bytes;
-            }
-
-            log.encrypted ? summary.totalEncrypted++ : summary.totalCleartext++;
-
-            if (!summary.packetCounts.contains(log.id)) {
-                summary.packetCounts[log.id] = 0;
-            }
-
-            summary.packetCounts[log.id]++;
-        }
-
-        summary.bytesPerPacket = (float)summary.totalBytes / summary.total;
-        summary.encryptedRatio = (float)summary.totalEncrypted / summary.total;
-
-        return summary;
-    }
-
     std::string hexDumpAddress(uintptr_t addr, size_t bytes) {
         unsigned char* ptr = reinterpret_cast<unsigned char*>(addr);
 
@@ -54,42 +54,6 @@ namespace util::debug {
         std::unordered_map<std::string, WatcherEntry> _entries;
     };
 
-    struct PacketLog {
-        packetid_t id;
-        bool encrypted;
-        bool outgoing;
-        size_t bytes;
-    };
-
-    struct PacketLogSummary {
-        size_t total;
-
-        size_t totalIn;
-        size_t totalOut;
-
-        size_t totalCleartext;
-        size_t totalEncrypted;
-
-        uint64_t totalBytes;
-        uint64_t totalBytesIn;
-        uint64_t totalBytesOut;
-
-        std::unordered_map<packetid_t, size_t> packetCounts;
-
-        float bytesPerPacket;
-        float encryptedRatio;
-
-        void print();
-    };
-
-    class PacketLogger : public SingletonLeakBase<PacketLogger> {
-    public:
-        void record(packetid_t id, bool encrypted, bool outgoing, size_t bytes);
-        PacketLogSummary getSummary();
-    private:
-        collections::CappedQueue<PacketLog, 25000> queue;
-    };
-
     std::string hexDumpAddress(uintptr_t addr, size_t bytes);
     std::string hexDumpAddress(void* ptr, size_t bytes);
 
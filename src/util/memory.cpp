@@ -0,0 +1,65 @@
+#include "memory.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace util::memory {
+    namespace {
+        struct Counter {
+            std::atomic<size_t> current = 0;
+            std::atomic<size_t> peak = 0;
+        };
+
+        std::array<Counter, TAG_COUNT> counters;
+    }
+
+    void add(Tag tag, size_t bytes) {
+        auto& counter = counters[static_cast<size_t>(tag)];
+
+        size_t now = counter.current.fetch_add(bytes, std::memory_order::relaxed) + bytes;
+        size_t peak = counter.peak.load(std::memory_order::relaxed);
+
+        while (now > peak && !counter.peak.compare_exchange_weak(peak, now, std::memory_order::relaxed)) {}
+    }
+
+    void remove(Tag tag, size_t bytes) {
+        counters[static_cast<size_t>(tag)].current.fetch_sub(bytes, std::memory_order::relaxed);
+    }
+
+    const char* tagName(Tag tag) {
+        switch (tag) {
+            case Tag::ProfileCache: return "Profile cache";
+            case Tag::IncomingPackets: return "Incoming packets";
+            case Tag::OutgoingPackets: return "Outgoing packets";
+            case Tag::AudioQueues: return "Audio queues";
+            case Tag::IconTextures: return "Icon textures";
+            case Tag::LerpLogger: return "Lerp logger";
+            case Tag::UdpFrames: return "UDP frames";
+            case Tag::PacketCapture: return "Packet capture";
+        }
+
+        return "Unknown";
+    }
+
+    Usage usage(Tag tag) {
+        auto& counter = counters[static_cast<size_t>(tag)];
+
+        return Usage {
+            .tag = tag,
+            .name = tagName(tag),
+            .current = counter.current.load(std::memory_order::relaxed),
+            .peak = counter.peak.load(std::memory_order::relaxed),
+        };
+    }
+
+    std::vector<Usage> usageAll() {
+        std::vector<Usage> out;
+        out.reserve(TAG_COUNT);
+
+        for (size_t i = 0; i < TAG_COUNT; i++) {
+            out.push_back(usage(static_cast<Tag>(i)));
+        }
+
+        return out;
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+/*
+* Memory accounting per subsystem, with the current and the peak amount of bytes used by each of them.
+*
+* Containers that own the memory use `TrackedAllocator`, so everything they allocate is counted exactly.
+* Memory that isn't allocated through a container we control (textures, packets in a channel) is counted by hand with `add` and `remove`,
+* which may be an estimate.
+*/
+namespace util::memory {
+    enum class Tag : uint8_t {
+        ProfileCache,
+        IncomingPackets,
+        OutgoingPackets,
+        AudioQueues,
+        IconTextures,
+        LerpLogger,
+        UdpFrames,
+        PacketCapture,
+    };
+
+    constexpr size_t TAG_COUNT = 8;
+
+    struct Usage {
+        Tag tag;
+        const char* name;
+        size_t current;
+        size_t peak;
+    };
+
+    // Thread safe.
+    void add(Tag tag, size_t bytes);
+    // Thread safe.
+    void remove(Tag tag, size_t bytes);
+
+    const char* tagName(Tag tag);
+    Usage usage(Tag tag);
+    // Every subsystem, in the order of the `Tag` enum
+    std::vector<Usage> usageAll();
+
+    // std allocator that counts everything it allocates towards `tag`
+    template <typename T, Tag tag>
+    struct TrackedAllocator {
+        using value_type = T;
+
+        // needed because of the non-type template parameter, std::allocator_traits can't figure it out itself
+        template <typename U>
+        struct rebind {
+            using other = TrackedAllocator<U, tag>;
+        };
+
+        TrackedAllocator() noexcept = default;
+
+        template <typename U>
+        TrackedAllocator(const TrackedAllocator<U, tag>&) noexcept {}
+
+        T* allocate(size_t n) {
+            T* ptr = std::allocator<T>{}.allocate(n);
+            add(tag, n * sizeof(T));
+            return ptr;
+        }
+
+        void deallocate(T* ptr, size_t n) noexcept {
+            remove(tag, n * sizeof(T));
+            std::allocator<T>{}.deallocate(ptr, n);
+        }
+
+        template <typename U>
+        bool operator==(const TrackedAllocator<U, tag>&) const noexcept {
+            return true;
+        }
+    };
+
+    template <typename T, Tag tag>
+    using TrackedVector = std::vector<T, TrackedAllocator<T, tag>>;
+
+    template <typename K, typename V, Tag tag>
+    using TrackedMap = std::map<K, V, std::less<K>, TrackedAllocator<std::pair<const K, V>, tag>>;
+}
@@ -52,6 +52,21 @@ namespace util::misc {
         return static_cast<float>(sum / static_cast<double>(samples));
     }
 
+    simd::PcmStats calculatePcmStats(const float* pcm, size_t samples) {
+        return simd::calcPcmStats(pcm, samples);
+    }
+
+    simd::PcmStats pcmStatsSlow(const float* pcm, size_t samples) {
+        simd::PcmStats stats;
+        for (size_t i = 0; i < samples; i++) {
+            stats.sumSquares += pcm[i] * pcm[i];
+            stats.sumAbs += std::abs(pcm[i]);
+            stats.peak = std::max(stats.peak, std::abs(pcm[i]));
+        }
+
+        return stats;
+    }
+
     bool compareName(std::string_view nv1, std::string_view nv2) {
         std::string name1(nv1);
         std::string name2(nv2);
@@ -4,7 +4,9 @@
 #include <data/types/basic/either.hpp>
 
 #include <asp/time/Instant.hpp>
+#include <util/simd.hpp>
 #include <functional>
+#include <map>
 #include <string_view>
 #include <type_traits>
 #include <optional>
@@ -96,6 +98,11 @@ namespace util::misc {
 
     float pcmVolumeSlow(const float* pcm, size_t samples);
 
+    // Calculate the sum of squares, the sum of absolute values and the peak of pcm samples
+    simd::PcmStats calculatePcmStats(const float* pcm, size_t samples);
+
+    simd::PcmStats pcmStatsSlow(const float* pcm, size_t samples);
+
     bool compareName(std::string_view name1, std::string_view name2);
 
     bool isEditorCollabLevel(LevelId levelId);
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <defs/geode.hpp>
+
+#include <asp/sync.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace util::collections {
+
+/*
+* PerThreadRing gives every thread that pushes to it its own fixed-size ring buffer, so recording never takes a lock
+* and never waits on another thread. Once a buffer is full, the oldest entries get overwritten.
+*
+* The buffer of a thread is looked up through a thread_local that is shared by all instances with the same `T` and `Capacity`,
+* so there must only be one instance of each.
+*/
+
+template <typename T, size_t Capacity>
+class PerThreadRing {
+public:
+    struct ThreadSnapshot {
+        uint32_t threadId; // starts at 1, in the order the threads first pushed
+        std::string threadName;
+        std::vector<T> entries; // oldest first
+    };
+
+    // Thread safe, without locking after the first push of a thread.
+    void push(const T& entry) {
+        static thread_local ThreadBuffer* buffer = this->registerThread();
+
+        uint64_t head = buffer->head.load(std::memory_order::relaxed);
+        buffer->entries[head % Capacity] = entry;
+        buffer->head.store(head + 1, std::memory_order::release);
+    }
+
+    // Copies the contents of the buffer of every thread. Thread safe.
+    std::vector<ThreadSnapshot> snapshot() {
+        std::vector<ThreadBuffer*> bufs = *buffers.lock();
+        std::vector<ThreadSnapshot> out;
+        out.reserve(bufs.size());
+
+        for (auto* buffer : bufs) {
+            auto& snap = out.emplace_back(ThreadSnapshot {
+                .threadId = buffer->threadId,
+                .threadName = buffer->threadName,
+            });
+
+            // the owning thread keeps writing while we copy, so anything it may have overwritten in the meantime is thrown away
+            uint64_t head = buffer->head.load(std::memory_order::acquire);
+            uint64_t begin = head > Capacity ? head - Capacity : 0;
+
+            for (uint64_t i = begin; i < head; i++) {
+                snap.entries.push_back(buffer->entries[i % Capacity]);
+            }
+
+            // the slot of `newHead` may be getting written to right now, so it's not valid either
+            uint64_t newHead = buffer->head.load(std::memory_order::acquire);
+            uint64_t validFrom = newHead + 1 > Capacity ? newHead + 1 - Capacity : 0;
+            size_t overwritten = validFrom > begin ? std::min<uint64_t>(validFrom - begin, snap.entries.size()) : 0;
+
+            snap.entries.erase(snap.entries.begin(), snap.entries.begin() + overwritten);
+        }
+
+        return out;
+    }
+
+private:
+    struct ThreadBuffer {
+        std::unique_ptr<T[]> entries = std::make_unique<T[]>(Capacity);
+        std::atomic<uint64_t> head = 0; // total amount of entries ever written, only modified by the owning thread
+        uint32_t threadId;
+        std::string threadName;
+    };
+
+    // buffers are never freed, as the threads that own them may exit at any time while a snapshot is being taken
+    asp::Mutex<std::vector<ThreadBuffer*>> buffers;
+
+    ThreadBuffer* registerThread() {
+        auto* buffer = new ThreadBuffer;
+        buffer->threadName = geode::utils::thread::getName();
+
+        auto bufs = buffers.lock();
+        buffer->threadId = bufs->size() + 1;
+        bufs->push_back(buffer);
+
+        return buffer;
+    }
+};
+
+}
@@ -2,6 +2,8 @@
 
 #include <defs/assert.hpp>
 
+#include <stdexcept>
+
 #define RNG_DEF(type) \
     template type Random::generate<type>(); \
     template type Random::generate<type>(type); \
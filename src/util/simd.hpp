@@ -3,7 +3,16 @@
 #include <stddef.h>
 
 namespace util::simd {
+    struct PcmStats {
+        float sumSquares = 0.f;
+        float sumAbs = 0.f;
+        float peak = 0.f;
+    };
+
     float calcPcmVolume(const float* pcm, size_t samples);
 
+    // Calculate the sum of squared samples, the sum of absolute samples and the absolute peak of a block of pcm samples
+    PcmStats calcPcmStats(const float* pcm, size_t samples);
+
     uint32_t adler32(const uint8_t* data, size_t len);
-}
\ No newline at end of file
+}
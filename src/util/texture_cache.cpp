@@ -0,0 +1,247 @@
+#include "texture_cache.hpp"
+
+#include <defs/geode.hpp>
+#include <managers/settings.hpp>
+#include <util/crypto.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+using namespace geode::prelude;
+
+constexpr static uint32_t FILE_MAGIC = 0x47544331; // GTC1
+constexpr static uint16_t FILE_VERSION = 1;
+// once the cache grows past this, the oldest entries are removed until it fits again
+constexpr static uintmax_t MAX_CACHE_SIZE = 768 * 1024 * 1024;
+// holds FILE_VERSION, so entries from another version are wiped all at once instead of lingering until evicted
+constexpr static std::string_view VERSION_FILE = "version";
+
+namespace {
+    // all of the members we need are protected
+    struct CachedImage : public CCImage {
+        bool initFromStream(std::istream& stream, uint16_t width, uint16_t height, bool premultiplied) {
+            size_t size = static_cast<size_t>(width) * height * 4;
+
+            m_pData = new (std::nothrow) unsigned char[size];
+            if (!m_pData) return false;
+
+            // read the pixels straight into the image, there's no intermediate buffer
+            if (!stream.read(reinterpret_cast<char*>(m_pData), size)) {
+                return false;
+            }
+
+            m_nWidth = width;
+            m_nHeight = height;
+            m_nBitsPerComponent = 8;
+            m_bHasAlpha = true;
+            m_bPreMulti = premultiplied;
+
+            return true;
+        }
+    };
+
+    struct SourceInfo {
+        int64_t mtime;
+        uint64_t size;
+    };
+
+    template <typename T>
+    bool readPod(std::istream& stream, T& out) {
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(&out), sizeof(T)));
+    }
+
+    template <typename T>
+    void writePod(std::ostream& stream, const T& value) {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+}
+
+namespace util::texcache {
+    static std::filesystem::path cacheDir() {
+        return Mod::get()->getSaveDir() / "texture-cache";
+    }
+
+    static std::filesystem::path pathForKey(std::string_view pngPath) {
+        auto name = util::crypto::hexEncode(util::crypto::simpleHash(pngPath));
+        name.resize(32);
+
+        return cacheDir() / (name + ".bin");
+    }
+
+    // fails for files that aren't on the real filesystem (i.e. inside the apk on android), those are never cached
+    static std::optional<SourceInfo> sourceInfo(std::string_view pngPath) {
+        std::filesystem::path path(pngPath);
+        std::error_code ec;
+
+        auto mtime = std::filesystem::last_write_time(path, ec);
+        if (ec) return std::nullopt;
+
+        auto size = std::filesystem::file_size(path, ec);
+        if (ec) return std::nullopt;
+
+        return SourceInfo {
+            .mtime = static_cast<int64_t>(mtime.time_since_epoch().count()),
+            .size = static_cast<uint64_t>(size),
+        };
+    }
+
+    bool enabled() {
+        return GlobedSettings::get().globed.preloadTextureCache;
+    }
+
+    static bool versionMatches() {
+        std::ifstream file(cacheDir() / VERSION_FILE, std::ios::binary);
+
+        uint16_t version;
+        return file.is_open() && readPod(file, version) && version == FILE_VERSION;
+    }
+
+    static void writeVersion() {
+        std::ofstream file(cacheDir() / VERSION_FILE, std::ios::binary);
+        writePod(file, FILE_VERSION);
+    }
+
+    void init() {
+        if (!enabled()) return;
+
+        auto dir = cacheDir();
+        std::error_code ec;
+
+        if (!versionMatches()) {
+            if (std::filesystem::exists(dir, ec)) {
+                log::info("Texture cache is from a different version, clearing it");
+            }
+
+            clear();
+            return;
+        }
+
+        struct CachedFile {
+            std::filesystem::path path;
+            uintmax_t size;
+            std::filesystem::file_time_type mtime;
+        };
+
+        std::vector<CachedFile> files;
+        uintmax_t totalSize = 0;
+
+        for (auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+            std::error_code fileEc;
+            if (entry.path().filename() == VERSION_FILE) continue;
+
+            auto size = entry.file_size(fileEc);
+            auto mtime = entry.last_write_time(fileEc);
+            if (fileEc) continue;
+
+            totalSize += size;
+            files.push_back(CachedFile { entry.path(), size, mtime });
+        }
+
+        if (totalSize <= MAX_CACHE_SIZE) return;
+
+        // entries are rewritten whenever their source png changes, so the oldest ones are the least likely to still be used
+        std::sort(files.begin(), files.end(), [](auto& a, auto& b) {
+            return a.mtime < b.mtime;
+        });
+
+        size_t removed = 0;
+        uintmax_t sizeBefore = totalSize;
+
+        for (auto& file : files) {
+            if (totalSize <= MAX_CACHE_SIZE) break;
+
+            std::error_code fileEc;
+            if (std::filesystem::remove(file.path, fileEc)) {
+                totalSize -= file.size;
+                removed++;
+            }
+        }
+
+        log::info("Texture cache is {} MiB, removed {} oldest entries", sizeBefore / 1024 / 1024, removed);
+    }
+
+    void clear() {
+        std::error_code ec;
+        std::filesystem::remove_all(cacheDir(), ec);
+        std::filesystem::create_directories(cacheDir(), ec);
+        writeVersion();
+    }
+
+    CCImage* load(std::string_view pngPath) {
+        auto info = sourceInfo(pngPath);
+        if (!info) return nullptr;
+
+        std::ifstream file(pathForKey(pngPath), std::ios::binary);
+        if (!file.is_open()) return nullptr;
+
+        uint32_t magic, pathLen;
+        uint16_t version, width, height;
+        uint8_t premultiplied;
+        SourceInfo stored;
+
+        if (!readPod(file, magic) || !readPod(file, version) || magic != FILE_MAGIC || version != FILE_VERSION) {
+            return nullptr;
+        }
+
+        // guards against hash collisions
+        if (!readPod(file, pathLen) || pathLen != pngPath.size()) {
+            return nullptr;
+        }
+
+        std::string storedPath(pathLen, '\0');
+        if (!file.read(storedPath.data(), pathLen) || storedPath != pngPath) {
+            return nullptr;
+        }
+
+        if (!readPod(file, stored.mtime) || !readPod(file, stored.size) || stored.mtime != info->mtime || stored.size != info->size) {
+            return nullptr;
+        }
+
+        if (!readPod(file, width) || !readPod(file, height) || !readPod(file, premultiplied) || width == 0 || height == 0) {
+            return nullptr;
+        }
+
+        auto image = new CachedImage;
+        if (!image->initFromStream(file, width, height, premultiplied != 0)) {
+            delete image;
+            return nullptr;
+        }
+
+        return image;
+    }
+
+    void store(std::string_view pngPath, CCImage* image) {
+        if (!image->hasAlpha() || image->getBitsPerComponent() != 8 || !image->getData()) {
+            return;
+        }
+
+        auto info = sourceInfo(pngPath);
+        if (!info) return;
+
+        auto path = pathForKey(pngPath);
+        auto tmpPath = path;
+        tmpPath += ".tmp";
+
+        {
+            std::ofstream file(tmpPath, std::ios::binary);
+            if (!file.is_open()) return;
+
+            writePod(file, FILE_MAGIC);
+            writePod(file, FILE_VERSION);
+            writePod(file, static_cast<uint32_t>(pngPath.size()));
+            file.write(pngPath.data(), pngPath.size());
+            writePod(file, info->mtime);
+            writePod(file, info->size);
+            writePod(file, static_cast<uint16_t>(image->getWidth()));
+            writePod(file, static_cast<uint16_t>(image->getHeight()));
+            writePod(file, static_cast<uint8_t>(image->isPremultipliedAlpha()));
+            file.write(reinterpret_cast<const char*>(image->getData()), static_cast<size_t>(image->getWidth()) * image->getHeight() * 4);
+
+            if (!file) return;
+        }
+
+        // rename so that a crash mid-write never leaves a truncated entry behind
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, path, ec);
+    }
+}
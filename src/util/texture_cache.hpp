@@ -0,0 +1,23 @@
+#pragma once
+#include <defs/platform.hpp>
+#include <cocos2d.h>
+
+// On-disk cache of already decoded images, used by the asset preloader to skip png decoding on warm starts.
+// Entries are keyed by the full path of the source png (which already depends on texture quality and texture packs),
+// and are invalidated when the size or modification time of that png changes.
+namespace util::texcache {
+    bool enabled();
+
+    // Wipes the cache if it was created by a different version, and removes the oldest entries if it has grown past the size limit.
+    // Call from the main thread.
+    void init();
+
+    // Removes every cached image.
+    void clear();
+
+    // Returns a new image with a refcount of 1, or nullptr if the image isn't cached or the entry is outdated. Thread safe.
+    cocos2d::CCImage* load(std::string_view pngPath);
+
+    // Stores the decoded pixels of `image`, only RGBA8888 images are cached. Thread safe.
+    void store(std::string_view pngPath, cocos2d::CCImage* image);
+}